@@ -0,0 +1,129 @@
+#pragma once
+
+#include <libpldm/base.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/* Helpers of the multipart transfers of the BIOS (DSP0247) and FRU (DSP0257)
+ * tables. Their completion codes have the same values as the platform ones,
+ * and libpldm names some of them only for the platform type.
+ */
+
+namespace pldm
+{
+namespace multipart
+{
+
+/** @brief Maximum number of parts of a transfer, the part index is the lower
+ *         half of a transfer handle
+ */
+constexpr size_t maxParts = 0xffff;
+
+/** @brief Build the transfer handle of a part of a version of a table, so
+ *         that a handle of another version of the table is detected
+ *
+ *  @param[in] version - The table version
+ *  @param[in] part - Index of the part
+ *
+ *  @return The transfer handle
+ */
+constexpr uint32_t toTransferHandle(uint32_t version, size_t part)
+{
+    return ((version & 0xffff) << 16) | (part & 0xffff);
+}
+
+/** @brief Get the size of the parts a table is transferred in
+ *
+ *  @param[in] tableSize - Size of the table
+ *  @param[in] transferSize - Configured size of the parts, 0 to transfer the
+ *                            table in a single part
+ *
+ *  @return The part size, large enough for the table to fit in maxParts
+ *          parts and never 0
+ */
+constexpr size_t getPartSize(size_t tableSize, size_t transferSize)
+{
+    if (!transferSize)
+    {
+        transferSize = tableSize;
+    }
+    return std::max(
+        {transferSize, (tableSize + maxParts - 1) / maxParts, size_t{1}});
+}
+
+/** @brief Get the number of parts a table is transferred in
+ *
+ *  @param[in] tableSize - Size of the table
+ *  @param[in] partSize - Size of the parts, from getPartSize()
+ *
+ *  @return The number of parts, an empty table is sent in one part
+ */
+constexpr size_t getNumParts(size_t tableSize, size_t partSize)
+{
+    return std::max((tableSize + partSize - 1) / partSize, size_t{1});
+}
+
+/** @brief Get the transfer flag of a part
+ *
+ *  @param[in] part - Index of the part
+ *  @param[in] numParts - Number of parts
+ *
+ *  @return PLDM_START_AND_END, PLDM_START, PLDM_MIDDLE or PLDM_END
+ */
+constexpr uint8_t getTransferFlag(size_t part, size_t numParts)
+{
+    bool first = part == 0;
+    bool last = part + 1 == numParts;
+    return first && last ? PLDM_START_AND_END
+           : first       ? PLDM_START
+           : last        ? PLDM_END
+                         : PLDM_MIDDLE;
+}
+
+/** @brief Get the next transfer handle of a part
+ *
+ *  @param[in] version - The table version
+ *  @param[in] part - Index of the part
+ *  @param[in] numParts - Number of parts
+ *
+ *  @return The transfer handle of the next part, 0 after the last part
+ */
+constexpr uint32_t getNextTransferHandle(uint32_t version, size_t part,
+                                         size_t numParts)
+{
+    return part + 1 == numParts ? 0 : toTransferHandle(version, part + 1);
+}
+
+/** @brief Get the part requested by a GetFirstPart or GetNextPart request. A
+ *         zero handle always starts the transfer.
+ *
+ *  @param[in] transferOpFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+ *  @param[in] transferHandle - Transfer handle of the request
+ *  @param[in] version - The table version
+ *  @param[in] numParts - Number of parts
+ *
+ *  @return Index of the part, std::nullopt if the handle is stale or invalid
+ */
+constexpr std::optional<size_t> getRequestedPart(
+    uint8_t transferOpFlag, uint32_t transferHandle, uint32_t version,
+    size_t numParts)
+{
+    if (transferOpFlag != PLDM_GET_NEXTPART || transferHandle == 0)
+    {
+        return 0;
+    }
+
+    size_t part = transferHandle & 0xffff;
+    if (part == 0 || part >= numParts ||
+        transferHandle != toTransferHandle(version, part))
+    {
+        return std::nullopt;
+    }
+    return part;
+}
+
+} // namespace multipart
+} // namespace pldm
@@ -0,0 +1,129 @@
+#include "pdr_journal.hpp"
+
+#include <libpldm/platform.h>
+
+#include <map>
+
+namespace pldm
+{
+namespace utils
+{
+
+void PDRJournal::recordChange(uint8_t eventDataOp, uint32_t recordHandle)
+{
+    journal.push_back({++generation, eventDataOp, recordHandle});
+    if (journal.size() > maxJournalEntries)
+    {
+        oldestGeneration = journal.front().generation;
+        journal.pop_front();
+    }
+}
+
+void PDRJournal::recordDelta(const std::set<uint32_t>& before,
+                             const std::set<uint32_t>& after)
+{
+    for (auto recordHandle : before)
+    {
+        if (!after.contains(recordHandle))
+        {
+            recordChange(PLDM_RECORDS_DELETED, recordHandle);
+        }
+    }
+    for (auto recordHandle : after)
+    {
+        if (!before.contains(recordHandle))
+        {
+            recordChange(PLDM_RECORDS_ADDED, recordHandle);
+        }
+    }
+}
+
+void PDRJournal::recordRefresh()
+{
+    journal.clear();
+    oldestGeneration = ++generation;
+}
+
+std::optional<PDRChangeSet> PDRJournal::getChangesSince(uint32_t since) const
+{
+    if (since > generation || since < oldestGeneration)
+    {
+        return std::nullopt;
+    }
+
+    // Collapse the changes of each record into the operation the peer has to
+    // apply: an added record stays added, a record added then deleted was
+    // never seen, and a record deleted then added again was modified.
+    std::map<uint32_t, uint8_t> ops;
+    for (const auto& entry : journal)
+    {
+        if (entry.generation <= since)
+        {
+            continue;
+        }
+
+        auto [it, inserted] = ops.try_emplace(entry.recordHandle,
+                                              entry.eventDataOp);
+        if (inserted)
+        {
+            continue;
+        }
+
+        auto& op = it->second;
+        if (op == PLDM_RECORDS_ADDED)
+        {
+            if (entry.eventDataOp == PLDM_RECORDS_DELETED)
+            {
+                ops.erase(it);
+            }
+        }
+        else if (op == PLDM_RECORDS_DELETED &&
+                 entry.eventDataOp == PLDM_RECORDS_ADDED)
+        {
+            op = PLDM_RECORDS_MODIFIED;
+        }
+        else
+        {
+            op = entry.eventDataOp;
+        }
+    }
+
+    PDRChangeSet changes;
+    for (const auto& [recordHandle, op] : ops)
+    {
+        switch (op)
+        {
+            case PLDM_RECORDS_ADDED:
+                changes.added.push_back(recordHandle);
+                break;
+            case PLDM_RECORDS_DELETED:
+                changes.deleted.push_back(recordHandle);
+                break;
+            default:
+                changes.modified.push_back(recordHandle);
+                break;
+        }
+    }
+
+    return changes;
+}
+
+std::set<uint32_t> getPDRRecordHandles(const pldm_pdr* repo)
+{
+    std::set<uint32_t> recordHandles;
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize{};
+    uint32_t nextRecordHandle{};
+    auto record = pldm_pdr_find_record(repo, 0, &pdrData, &pdrSize,
+                                       &nextRecordHandle);
+    while (record)
+    {
+        recordHandles.insert(pldm_pdr_get_record_handle(repo, record));
+        record = pldm_pdr_get_next_record(repo, record, &pdrData, &pdrSize,
+                                          &nextRecordHandle);
+    }
+    return recordHandles;
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @struct PDRChangeSet
+ *  Record handles changed in a PDR repository, grouped by the
+ *  pldmPDRRepositoryChgEvent event data operation (DSP0248 Table 16).
+ */
+struct PDRChangeSet
+{
+    std::vector<uint32_t> added;
+    std::vector<uint32_t> deleted;
+    std::vector<uint32_t> modified;
+
+    bool empty() const
+    {
+        return added.empty() && deleted.empty() && modified.empty();
+    }
+};
+
+/** @class PDRJournal
+ *
+ *  @brief Generation counter and change journal of a PDR repository.
+ *
+ *  The journal is owned by the pldm::responder::pdr_utils::Repo wrapper of
+ *  the repository. Code that mutates the repository directly with libpldm
+ *  records its changes into the journal of that wrapper. Repositories
+ *  without a wrapper, such as the temporary ones filtered by PDR type, are
+ *  not tracked.
+ */
+class PDRJournal
+{
+  public:
+    /** @brief Get the generation of the repository, incremented on every
+     *         recorded change
+     *
+     *  @return uint32_t - repository generation
+     */
+    uint32_t getGeneration() const
+    {
+        return generation;
+    }
+
+    /** @brief Record a change of a PDR record
+     *
+     *  @param[in] eventDataOp - PLDM_RECORDS_ADDED, PLDM_RECORDS_DELETED or
+     *                           PLDM_RECORDS_MODIFIED
+     *  @param[in] recordHandle - handle of the changed PDR record
+     */
+    void recordChange(uint8_t eventDataOp, uint32_t recordHandle);
+
+    /** @brief Record the records added and deleted by a libpldm call that
+     *         does not return their handles
+     *
+     *  @param[in] before - record handles before the call, from
+     *                      getPDRRecordHandles()
+     *  @param[in] after - record handles after the call
+     */
+    void recordDelta(const std::set<uint32_t>& before,
+                     const std::set<uint32_t>& after);
+
+    /** @brief Record a rebuild of the entire repository, the changes since
+     *         any earlier generation are no longer covered
+     */
+    void recordRefresh();
+
+    /** @brief Get the PDR records changed since a generation
+     *
+     *  @param[in] since - generation returned by getGeneration()
+     *
+     *  @return the changes with one operation per record handle, or
+     *          std::nullopt if the journal no longer covers the generation
+     *          and the entire repository has to be refreshed
+     */
+    std::optional<PDRChangeSet> getChangesSince(uint32_t since) const;
+
+  private:
+    /** @struct JournalEntry
+     *  A change recorded in the change journal
+     */
+    struct JournalEntry
+    {
+        uint32_t generation;
+        uint8_t eventDataOp;
+        uint32_t recordHandle;
+    };
+
+    /** @brief Maximum number of changes kept in the change journal */
+    static constexpr size_t maxJournalEntries = 256;
+
+    /** @brief Repository generation */
+    uint32_t generation = 0;
+
+    /** @brief Oldest generation the journal covers the changes since */
+    uint32_t oldestGeneration = 0;
+
+    /** @brief Most recent changes, oldest first */
+    std::deque<JournalEntry> journal;
+};
+
+/** @brief Get the handles of all the records of a PDR repository
+ *
+ *  @param[in] repo - PDR repository
+ *
+ *  @return the record handles
+ */
+std::set<uint32_t> getPDRRecordHandles(const pldm_pdr* repo);
+
+/** @brief Make a libpldm call that adds or removes PDR records without
+ *         returning their handles, and record the records it changed
+ *
+ *  @param[in] journal - change journal of the repository, nullptr if the
+ *                       repository is not tracked
+ *  @param[in] repo - PDR repository
+ *  @param[in] mutation - the libpldm call
+ */
+template <typename Mutation>
+void recordPDRDelta(PDRJournal* journal, const pldm_pdr* repo,
+                    Mutation&& mutation)
+{
+    if (!journal)
+    {
+        mutation();
+        return;
+    }
+    auto recordHandles = getPDRRecordHandles(repo);
+    mutation();
+    journal->recordDelta(recordHandles, getPDRRecordHandles(repo));
+}
+
+} // namespace utils
+} // namespace pldm
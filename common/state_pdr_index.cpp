@@ -0,0 +1,141 @@
+#include "state_pdr_index.hpp"
+
+#include "common/pdr_journal.hpp"
+#include "common/start_lifetime_as.hpp"
+
+#include <libpldm/platform.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <set>
+#include <type_traits>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+/** @brief Add every record of a state effecter or state sensor PDR type to
+ *         the index, once per distinct state set in its composite entries
+ *
+ *  @tparam PDR - pldm_state_effecter_pdr or pldm_state_sensor_pdr
+ *  @tparam PossibleStates - the matching possible states structure
+ *  @tparam Index - map of (entity type, state set id) to PDRs
+ *
+ *  @param[in] repo - PDR repo to walk
+ *  @param[in] pdrType - PLDM_STATE_EFFECTER_PDR or PLDM_STATE_SENSOR_PDR
+ *  @param[out] index - index to populate
+ */
+template <typename PDR, typename PossibleStates, typename Index>
+void indexRecords(const pldm_pdr* repo, uint8_t pdrType, Index& index)
+{
+    uint8_t* outData = nullptr;
+    uint32_t size{};
+    const pldm_pdr_record* record{};
+
+    while ((record = pldm_pdr_find_record_by_type(repo, pdrType, record,
+                                                  &outData, &size)))
+    {
+        if (size < sizeof(PDR))
+        {
+            continue;
+        }
+
+        auto pdr = std::start_lifetime_as<PDR>(outData);
+        uint8_t compositeCount{};
+        if constexpr (std::is_same_v<PDR, pldm_state_effecter_pdr>)
+        {
+            compositeCount = pdr->composite_effecter_count;
+        }
+        else
+        {
+            compositeCount = pdr->composite_sensor_count;
+        }
+
+        uint16_t entityType = pdr->entity_type;
+        const uint8_t* end = outData + size;
+        const uint8_t* possibleStatesStart = pdr->possible_states;
+        std::set<uint16_t> stateSets;
+
+        for (uint8_t i = 0; i < compositeCount; ++i)
+        {
+            if (possibleStatesStart + sizeof(PossibleStates) -
+                    sizeof(uint8_t) >
+                end)
+            {
+                break;
+            }
+
+            auto possibleStates =
+                std::start_lifetime_as<PossibleStates>(possibleStatesStart);
+            uint16_t setId = possibleStates->state_set_id;
+            uint8_t possibleStateSize = possibleStates->possible_states_size;
+
+            if (stateSets.emplace(setId).second)
+            {
+                index[{entityType, setId}].emplace_back(outData, outData + size);
+            }
+
+            possibleStatesStart += possibleStateSize + sizeof(setId) +
+                                   sizeof(possibleStateSize);
+        }
+    }
+}
+
+} // namespace
+
+void StatePDRIndex::refresh()
+{
+    if (valid && journal && journal->getGeneration() == generation)
+    {
+        return;
+    }
+
+    effecterPDRs.clear();
+    sensorPDRs.clear();
+
+    try
+    {
+        indexRecords<pldm_state_effecter_pdr, state_effecter_possible_states>(
+            repo, PLDM_STATE_EFFECTER_PDR, effecterPDRs);
+        indexRecords<pldm_state_sensor_pdr, state_sensor_possible_states>(
+            repo, PLDM_STATE_SENSOR_PDR, sensorPDRs);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to index state PDRs, error - {ERROR}", "ERROR", e);
+        effecterPDRs.clear();
+        sensorPDRs.clear();
+    }
+
+    generation = journal ? journal->getGeneration() : 0;
+    valid = true;
+}
+
+const StatePDRIndex::PDRs& StatePDRIndex::findStateEffecterPDR(
+    uint16_t entityType, uint16_t stateSetId)
+{
+    static const PDRs empty{};
+
+    refresh();
+    auto it = effecterPDRs.find({entityType, stateSetId});
+    return it == effecterPDRs.end() ? empty : it->second;
+}
+
+const StatePDRIndex::PDRs& StatePDRIndex::findStateSensorPDR(
+    uint16_t entityType, uint16_t stateSetId)
+{
+    static const PDRs empty{};
+
+    refresh();
+    auto it = sensorPDRs.find({entityType, stateSetId});
+    return it == sensorPDRs.end() ? empty : it->second;
+}
+
+} // namespace utils
+} // namespace pldm
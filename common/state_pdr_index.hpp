@@ -0,0 +1,98 @@
+#pragma once
+
+#include "pdr_journal.hpp"
+
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class StatePDRIndex
+ *
+ *  @brief Index of the state effecter and state sensor PDRs of a PDR
+ *         repository, keyed by (entity type, state set id).
+ *
+ *  The index is built with a single walk of the repository and caches copies
+ *  of the matching PDRs, so repeated lookups (D-Bus FindStateEffecterPDR and
+ *  FindStateSensorPDR, OEM handlers) do not re-walk the repository. The
+ *  index tracks the generation of the PDRJournal of the repository and
+ *  rebuilds itself on the next lookup when it changes. Without a journal the
+ *  repository is walked on every lookup.
+ */
+class StatePDRIndex
+{
+  public:
+    using PDRs = std::vector<std::vector<uint8_t>>;
+
+    StatePDRIndex() = delete;
+    StatePDRIndex(const StatePDRIndex&) = delete;
+    StatePDRIndex& operator=(const StatePDRIndex&) = delete;
+    StatePDRIndex(StatePDRIndex&&) = delete;
+    StatePDRIndex& operator=(StatePDRIndex&&) = delete;
+    ~StatePDRIndex() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] repo - pointer to the PDR repo to index
+     *  @param[in] journal - change journal of the PDR repo, nullptr if the
+     *                       repo is not tracked
+     */
+    explicit StatePDRIndex(const pldm_pdr* repo,
+                           const PDRJournal* journal = nullptr) :
+        repo(repo), journal(journal)
+    {}
+
+    /** @brief Find the state effecter PDRs for an entity type and state set
+     *
+     *  @param[in] entityType - entity type associated with the state set
+     *  @param[in] stateSetId - value that identifies the PLDM state set
+     *
+     *  @return the matching state effecter PDRs, empty if none
+     */
+    const PDRs& findStateEffecterPDR(uint16_t entityType, uint16_t stateSetId);
+
+    /** @brief Find the state sensor PDRs for an entity type and state set
+     *
+     *  @param[in] entityType - entity type associated with the state set
+     *  @param[in] stateSetId - value that identifies the PLDM state set
+     *
+     *  @return the matching state sensor PDRs, empty if none
+     */
+    const PDRs& findStateSensorPDR(uint16_t entityType, uint16_t stateSetId);
+
+  private:
+    using Key = std::pair<uint16_t, uint16_t>;
+
+    /** @brief Rebuild the index if the repository changed since the last
+     *         build
+     */
+    void refresh();
+
+    /** @brief pointer to the indexed PDR repo */
+    const pldm_pdr* repo;
+
+    /** @brief change journal of the indexed PDR repo */
+    const PDRJournal* journal;
+
+    /** @brief true once the index has been built */
+    bool valid = false;
+
+    /** @brief generation of the repository when the index was built */
+    uint32_t generation = 0;
+
+    /** @brief state effecter PDRs keyed by (entity type, state set id) */
+    std::map<Key, PDRs> effecterPDRs;
+
+    /** @brief state sensor PDRs keyed by (entity type, state set id) */
+    std::map<Key, PDRs> sensorPDRs;
+};
+
+} // namespace utils
+} // namespace pldm
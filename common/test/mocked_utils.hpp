@@ -84,4 +84,9 @@ class MockdBusHandler : public pldm::utils::DBusHandler
     MOCK_METHOD(pldm::utils::GetAncestorsResponse, getAncestors,
                 (const std::string&, const std::vector<std::string>&),
                 (const, override));
+
+    MOCK_METHOD(pldm::utils::DBusWatch, watchDbusProperty,
+                (const pldm::utils::DBusMapping&,
+                 pldm::utils::DBusWatchCallback),
+                (const, override));
 };
@@ -1,3 +1,6 @@
+#include "common/multipart_transfer.hpp"
+#include "common/pdr_journal.hpp"
+#include "common/state_pdr_index.hpp"
 #include "common/utils.hpp"
 #include "mocked_utils.hpp"
 
@@ -1008,6 +1011,130 @@ TEST(FindStateSensorPDR, testNoMatchCompositeSensor)
     pldm_pdr_destroy(repo);
 }
 
+TEST(StatePDRIndex, testEffecterMatchAndRebuild)
+{
+    auto repo = pldm_pdr_init();
+
+    std::vector<uint8_t> pdr(
+        sizeof(struct pldm_state_effecter_pdr) - sizeof(uint8_t) +
+        sizeof(struct state_effecter_possible_states));
+
+    auto rec = new (pdr.data()) pldm_state_effecter_pdr;
+
+    auto state = new (rec->possible_states) state_effecter_possible_states;
+
+    rec->hdr.type = 11;
+    rec->hdr.record_handle = 1;
+    rec->entity_type = 33;
+    rec->container_id = 0;
+    rec->composite_effecter_count = 1;
+    state->state_set_id = 196;
+    state->possible_states_size = 1;
+
+    uint32_t handle = 0;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 1, &handle), 0);
+
+    PDRJournal journal;
+    StatePDRIndex index(repo, &journal);
+
+    const auto& record = index.findStateEffecterPDR(33, 196);
+    ASSERT_EQ(record.size(), 1);
+    EXPECT_EQ(pdr, record[0]);
+    EXPECT_TRUE(index.findStateEffecterPDR(44, 196).empty());
+    EXPECT_TRUE(index.findStateSensorPDR(33, 196).empty());
+
+    rec->hdr.record_handle = 2;
+    handle = 0;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 1, &handle), 0);
+    EXPECT_EQ(index.findStateEffecterPDR(33, 196).size(), 1);
+
+    journal.recordChange(PLDM_RECORDS_ADDED, handle);
+    EXPECT_EQ(index.findStateEffecterPDR(33, 196).size(), 2);
+
+    // A record replaced by one of the same size leaves the record count and
+    // the repository size unchanged
+    ASSERT_EQ(pldm_pdr_delete_by_record_handle(repo, handle, false), 0);
+    journal.recordChange(PLDM_RECORDS_DELETED, handle);
+    rec->entity_type = 44;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 1, &handle), 0);
+    journal.recordChange(PLDM_RECORDS_ADDED, handle);
+
+    EXPECT_EQ(index.findStateEffecterPDR(33, 196).size(), 1);
+    EXPECT_EQ(index.findStateEffecterPDR(44, 196).size(), 1);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PDRJournal, recordDeltaOfLibpldmCalls)
+{
+    auto repo = pldm_pdr_init();
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), 0);
+
+    uint32_t first = 0;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), true, 1, &first), 0);
+    uint32_t second = 0;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 2, &second),
+              0);
+
+    PDRJournal journal;
+    auto generation = journal.getGeneration();
+    uint32_t added = 0;
+    recordPDRDelta(&journal, repo, [&] {
+        pldm_pdr_remove_remote_pdrs(repo);
+        pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 2, &added);
+    });
+
+    auto changes = journal.getChangesSince(generation);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->added, std::vector<uint32_t>({added}));
+    EXPECT_EQ(changes->deleted, std::vector<uint32_t>({first}));
+    EXPECT_TRUE(changes->modified.empty());
+    EXPECT_EQ(getPDRRecordHandles(repo), std::set<uint32_t>({second, added}));
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(StatePDRIndex, testCompositeSensor)
+{
+    auto repo = pldm_pdr_init();
+
+    std::vector<uint8_t> pdr(
+        sizeof(struct pldm_state_sensor_pdr) - sizeof(uint8_t) +
+        sizeof(struct state_sensor_possible_states) * 2);
+
+    auto rec = new (pdr.data()) pldm_state_sensor_pdr;
+
+    auto state_start = rec->possible_states;
+
+    auto state = new (state_start) state_sensor_possible_states;
+
+    rec->hdr.type = 4;
+    rec->hdr.record_handle = 1;
+    rec->entity_type = 5;
+    rec->container_id = 0;
+    rec->composite_sensor_count = 2;
+    state->state_set_id = 1;
+    state->possible_states_size = 1;
+
+    state_start += state->possible_states_size + sizeof(state->state_set_id) +
+                   sizeof(state->possible_states_size);
+    state = new (state_start) state_sensor_possible_states;
+    state->state_set_id = 7;
+    state->possible_states_size = 1;
+
+    uint32_t handle = 0;
+    ASSERT_EQ(pldm_pdr_add(repo, pdr.data(), pdr.size(), false, 1, &handle), 0);
+
+    StatePDRIndex index(repo);
+
+    EXPECT_EQ(pdr, index.findStateSensorPDR(5, 1)[0]);
+    EXPECT_EQ(pdr, index.findStateSensorPDR(5, 7)[0]);
+    EXPECT_TRUE(index.findStateSensorPDR(5, 2).empty());
+    EXPECT_TRUE(index.findStateEffecterPDR(5, 7).empty());
+
+    pldm_pdr_destroy(repo);
+}
+
 TEST(toString, allTestCases)
 {
     variable_field buffer{};
@@ -1508,3 +1635,126 @@ TEST(GenerateSwId, testRandomness)
     // With 50 calls, we should get at least some different values
     EXPECT_GT(ids.size(), 1);
 }
+
+TEST(ToPropertyType, testTypeNames)
+{
+    EXPECT_EQ(toPropertyType("bool"), PropertyType::Bool);
+    EXPECT_EQ(toPropertyType("uint8_t"), PropertyType::Uint8);
+    EXPECT_EQ(toPropertyType("int16_t"), PropertyType::Int16);
+    EXPECT_EQ(toPropertyType("uint64_t"), PropertyType::Uint64);
+    EXPECT_EQ(toPropertyType("double"), PropertyType::Double);
+    EXPECT_EQ(toPropertyType("string"), PropertyType::String);
+    EXPECT_EQ(toPropertyType("array[string]"), PropertyType::ArrayString);
+    EXPECT_EQ(toPropertyType("uint128_t"), PropertyType::Unknown);
+    EXPECT_EQ(toPropertyType(""), PropertyType::Unknown);
+}
+
+TEST(DBusServiceCache, testOptIn)
+{
+    EXPECT_EQ(DBusServiceCache::get(), nullptr);
+    {
+        DBusServiceCache cache(nullptr);
+        EXPECT_EQ(DBusServiceCache::get(), &cache);
+
+        // A cached entry is served without querying the mapper
+        cache.insert({"/xyz/openbmc_project/a", "xyz.Intf"}, "xyz.Service");
+        DBusHandler handler;
+        EXPECT_EQ(handler.getService("/xyz/openbmc_project/a", "xyz.Intf"),
+                  "xyz.Service");
+    }
+    EXPECT_EQ(DBusServiceCache::get(), nullptr);
+}
+
+TEST(DBusServiceCache, testInsertFindErase)
+{
+    DBusServiceCache cache(nullptr);
+    DBusServiceCache::Key key{"/xyz/openbmc_project/a", "xyz.Intf"};
+    EXPECT_EQ(cache.find(key), nullptr);
+
+    cache.insert(key, "xyz.ServiceA");
+    ASSERT_NE(cache.find(key), nullptr);
+    EXPECT_EQ(*cache.find(key), "xyz.ServiceA");
+
+    cache.insert(key, "xyz.ServiceB");
+    EXPECT_EQ(*cache.find(key), "xyz.ServiceB");
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_EQ(cache.find({"/xyz/openbmc_project/a", "xyz.Other"}), nullptr);
+
+    cache.erase(key);
+    EXPECT_EQ(cache.find(key), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(DBusServiceCache, testInvalidation)
+{
+    DBusServiceCache cache(nullptr);
+    cache.insert({"/xyz/openbmc_project/a", "xyz.Intf1"}, "xyz.ServiceA");
+    cache.insert({"/xyz/openbmc_project/a", "xyz.Intf2"}, "xyz.ServiceB");
+    cache.insert({"/xyz/openbmc_project/b", "xyz.Intf1"}, "xyz.ServiceA");
+    cache.insert({"/xyz/openbmc_project/c", "xyz.Intf1"}, "xyz.ServiceC");
+    EXPECT_EQ(cache.size(), 4);
+
+    // Only the entries of the service whose owner changed are dropped
+    cache.serviceChanged("xyz.ServiceA");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.find({"/xyz/openbmc_project/a", "xyz.Intf1"}), nullptr);
+    EXPECT_EQ(cache.find({"/xyz/openbmc_project/b", "xyz.Intf1"}), nullptr);
+    EXPECT_NE(cache.find({"/xyz/openbmc_project/a", "xyz.Intf2"}), nullptr);
+
+    cache.serviceChanged("xyz.Unknown");
+    EXPECT_EQ(cache.size(), 2);
+
+    // Only the entries of the object whose interfaces changed are dropped,
+    // whatever their interface
+    cache.insert({"/xyz/openbmc_project/a", "xyz.Intf3"}, "xyz.ServiceD");
+    cache.objectChanged("/xyz/openbmc_project/a");
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_NE(cache.find({"/xyz/openbmc_project/c", "xyz.Intf1"}), nullptr);
+
+    // Object paths are matched exactly, not by prefix
+    cache.objectChanged("/xyz/openbmc_project");
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(MultipartTransfer, testParts)
+{
+    using namespace pldm::multipart;
+
+    // An empty table is still sent in one part
+    EXPECT_EQ(getPartSize(0, 0), 1);
+    EXPECT_EQ(getNumParts(0, getPartSize(0, 0)), 1);
+
+    EXPECT_EQ(getPartSize(100, 0), 100);
+    EXPECT_EQ(getPartSize(100, 30), 30);
+    EXPECT_EQ(getNumParts(100, 30), 4);
+
+    // The parts grow for the table to fit in maxParts parts
+    EXPECT_EQ(getPartSize(0x20000, 1), 3);
+
+    EXPECT_EQ(getTransferFlag(0, 1), PLDM_START_AND_END);
+    EXPECT_EQ(getTransferFlag(0, 4), PLDM_START);
+    EXPECT_EQ(getTransferFlag(2, 4), PLDM_MIDDLE);
+    EXPECT_EQ(getTransferFlag(3, 4), PLDM_END);
+
+    EXPECT_EQ(getNextTransferHandle(5, 1, 4), toTransferHandle(5, 2));
+    EXPECT_EQ(getNextTransferHandle(5, 3, 4), 0);
+}
+
+TEST(MultipartTransfer, testRequestedPart)
+{
+    using namespace pldm::multipart;
+
+    EXPECT_EQ(getRequestedPart(PLDM_GET_FIRSTPART, 1234, 5, 4), 0);
+    EXPECT_EQ(getRequestedPart(PLDM_GET_NEXTPART, 0, 5, 4), 0);
+    EXPECT_EQ(getRequestedPart(PLDM_GET_NEXTPART, toTransferHandle(5, 2), 5, 4),
+              2);
+
+    // A handle of another version of the table is stale
+    EXPECT_EQ(getRequestedPart(PLDM_GET_NEXTPART, toTransferHandle(4, 2), 5, 4),
+              std::nullopt);
+    EXPECT_EQ(getRequestedPart(PLDM_GET_NEXTPART, toTransferHandle(5, 4), 5, 4),
+              std::nullopt);
+    EXPECT_EQ(getRequestedPart(PLDM_GET_NEXTPART, toTransferHandle(5, 0), 5, 4),
+              std::nullopt);
+}
@@ -135,10 +135,15 @@ using ComponentInfo = std::map<CompKey, CompClassificationIndex>;
 using ComponentInfoMap = std::unordered_map<eid, ComponentInfo>;
 
 // PackageHeaderInformation
+using PackageHeaderFormatRevision = uint8_t;
 using PackageHeaderSize = size_t;
 using PackageVersion = std::string;
 using ComponentBitmapBitLength = uint16_t;
 using PackageHeaderChecksum = uint32_t;
+using PackagePayloadChecksum = uint32_t;
+
+// DownstreamDeviceIDRecords
+using DownstreamDeviceIDRecordCount = uint8_t;
 
 // FirmwareDeviceIDRecords
 using DeviceIDRecordCount = uint8_t;
@@ -9,6 +9,7 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 
+#include <sdbusplus/bus/match.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/client.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <xyz/openbmc_project/Inventory/Item/common.hpp>
@@ -243,9 +244,165 @@ std::optional<std::vector<set_effecter_state_field>> parseEffecterData(
     return std::make_optional(std::move(stateField));
 }
 
+namespace
+{
+
+/** @brief Service cache enabled by the process */
+DBusServiceCache* serviceCache = nullptr;
+
+} // namespace
+
+DBusServiceCache::DBusServiceCache(sdbusplus::bus_t* bus) : bus(bus)
+{
+    serviceCache = this;
+}
+
+DBusServiceCache::~DBusServiceCache()
+{
+    if (serviceCache == this)
+    {
+        serviceCache = nullptr;
+    }
+}
+
+DBusServiceCache* DBusServiceCache::get()
+{
+    return serviceCache;
+}
+
+const std::string* DBusServiceCache::find(const Key& key) const
+{
+    auto it = services.find(key);
+    return it == services.end() ? nullptr : &it->second;
+}
+
+void DBusServiceCache::insert(const Key& key, const std::string& service)
+{
+    services.insert_or_assign(key, service);
+    watch(key, service);
+}
+
+void DBusServiceCache::erase(const Key& key)
+{
+    services.erase(key);
+}
+
+void DBusServiceCache::serviceChanged(const std::string& service)
+{
+    std::erase_if(services, [&service](const auto& entry) {
+        return entry.second == service;
+    });
+}
+
+void DBusServiceCache::objectChanged(const std::string& path)
+{
+    std::erase_if(services, [&path](const auto& entry) {
+        return entry.first.first == path;
+    });
+}
+
+void DBusServiceCache::watch(const Key& key, const std::string& service)
+{
+    std::erase_if(serviceMatches, [this](const auto& match) {
+        return std::ranges::none_of(services, [&match](const auto& entry) {
+            return entry.second == match.first;
+        });
+    });
+    std::erase_if(objectMatches, [this](const auto& match) {
+        return std::ranges::none_of(services, [&match](const auto& entry) {
+            return entry.first.first == match.first;
+        });
+    });
+
+    if (!bus)
+    {
+        return;
+    }
+
+    namespace rules = sdbusplus::bus::match::rules;
+    if (!serviceMatches.contains(service))
+    {
+        serviceMatches.emplace(
+            service,
+            std::make_unique<sdbusplus::bus::match_t>(
+                *bus, rules::nameOwnerChanged(service),
+                [this, service](sdbusplus::message_t&) {
+                    serviceChanged(service);
+                }));
+    }
+
+    const auto& path = key.first;
+    if (!objectMatches.contains(path))
+    {
+        auto dropObject = [this, path](sdbusplus::message_t&) {
+            objectChanged(path);
+        };
+        auto added = std::make_unique<sdbusplus::bus::match_t>(
+            *bus, rules::interfacesAdded() + rules::argNpath(0, path),
+            dropObject);
+        auto removed = std::make_unique<sdbusplus::bus::match_t>(
+            *bus, rules::interfacesRemoved() + rules::argNpath(0, path),
+            dropObject);
+        objectMatches.emplace(
+            path, std::make_pair(std::move(added), std::move(removed)));
+    }
+}
+
+namespace
+{
+
+/** @brief Make a D-Bus call on the service hosting an object. If the service
+ *         was cached and the call fails, the service is resolved again and
+ *         the call retried once, in case the cache is stale.
+ *
+ *  @param[in] handler - D-Bus handler resolving the service
+ *  @param[in] path - D-Bus object path
+ *  @param[in] interface - D-Bus interface
+ *  @param[in] call - callable making the D-Bus call given the service name
+ *
+ *  @return the result of call
+ */
+template <typename Call>
+auto callService(const DBusHandler& handler, const char* path,
+                 const char* interface, Call&& call)
+{
+    auto cache = DBusServiceCache::get();
+    DBusServiceCache::Key key{path, interface ? interface : ""};
+    bool cached = cache && cache->find(key);
+    auto service = handler.getService(path, interface);
+    if (!cached)
+    {
+        return call(service);
+    }
+
+    try
+    {
+        return call(service);
+    }
+    catch (const sdbusplus::exception_t&)
+    {
+        cache->erase(key);
+        auto currentService = handler.getService(path, interface);
+        if (currentService == service)
+        {
+            throw;
+        }
+        return call(currentService);
+    }
+}
+
+} // namespace
+
 std::string DBusHandler::getService(const char* path,
                                     const char* interface) const
 {
+    auto cache = DBusServiceCache::get();
+    DBusServiceCache::Key key{path, interface ? interface : ""};
+    if (auto service = cache ? cache->find(key) : nullptr)
+    {
+        return *service;
+    }
+
     using DbusInterfaceList = std::vector<std::string>;
     std::map<std::string, std::vector<std::string>> mapperResponse;
     auto& bus = DBusHandler::getBus();
@@ -265,6 +422,10 @@ std::string DBusHandler::getService(const char* path,
 
     auto mapperResponseMsg = bus.call(mapper, dbusTimeout);
     mapperResponseMsg.read(mapperResponse);
+    if (cache)
+    {
+        cache->insert(key, mapperResponse.begin()->first);
+    }
     return mapperResponse.begin()->first;
 }
 
@@ -343,93 +504,136 @@ void reportError(const char* errorMsg)
     }
 }
 
+PropertyType toPropertyType(std::string_view typeName)
+{
+    static const std::map<std::string_view, PropertyType> types{
+        {"bool", PropertyType::Bool},
+        {"uint8_t", PropertyType::Uint8},
+        {"int16_t", PropertyType::Int16},
+        {"uint16_t", PropertyType::Uint16},
+        {"int32_t", PropertyType::Int32},
+        {"uint32_t", PropertyType::Uint32},
+        {"int64_t", PropertyType::Int64},
+        {"uint64_t", PropertyType::Uint64},
+        {"double", PropertyType::Double},
+        {"string", PropertyType::String},
+        {"array[string]", PropertyType::ArrayString}};
+
+    auto it = types.find(typeName);
+    return it == types.end() ? PropertyType::Unknown : it->second;
+}
+
 void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
                                   const PropertyValue& value) const
 {
     auto setDbusValue = [&dBusMap, this](const auto& variant) {
-        auto& bus = getBus();
-        auto service =
-            getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
-        auto method = bus.new_method_call(
-            service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
-        method.append(dBusMap.interface.c_str(), dBusMap.propertyName.c_str(),
-                      variant);
-        bus.call_noreply(method, dbusTimeout);
+        callService(*this, dBusMap.objectPath.c_str(),
+                    dBusMap.interface.c_str(),
+                    [&dBusMap, &variant](const std::string& service) {
+                        auto& bus = getBus();
+                        auto method = bus.new_method_call(
+                            service.c_str(), dBusMap.objectPath.c_str(),
+                            dbusProperties, "Set");
+                        method.append(dBusMap.interface.c_str(),
+                                      dBusMap.propertyName.c_str(), variant);
+                        bus.call_noreply(method, dbusTimeout);
+                    });
     };
 
-    if (dBusMap.propertyType == "uint8_t")
-    {
-        std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "bool")
-    {
-        std::variant<bool> v = std::get<bool>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "int16_t")
-    {
-        std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "uint16_t")
-    {
-        std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "int32_t")
-    {
-        std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "uint32_t")
-    {
-        std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "int64_t")
-    {
-        std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "uint64_t")
-    {
-        std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "double")
-    {
-        std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "string")
-    {
-        std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
-    }
-    else if (dBusMap.propertyType == "array[string]")
-    {
-        std::variant<std::vector<std::string>> v =
-            std::get<std::vector<std::string>>(value);
-        setDbusValue(v);
-    }
-    else
-    {
-        error("Unsupported property type '{TYPE}'", "TYPE",
-              dBusMap.propertyType);
-        throw std::invalid_argument("UnSupported Dbus Type");
+    auto type = dBusMap.type;
+    if (type == PropertyType::Unknown)
+    {
+        type = toPropertyType(dBusMap.propertyType);
+    }
+
+    switch (type)
+    {
+        case PropertyType::Uint8:
+            setDbusValue(std::variant<uint8_t>(std::get<uint8_t>(value)));
+            break;
+        case PropertyType::Bool:
+            setDbusValue(std::variant<bool>(std::get<bool>(value)));
+            break;
+        case PropertyType::Int16:
+            setDbusValue(std::variant<int16_t>(std::get<int16_t>(value)));
+            break;
+        case PropertyType::Uint16:
+            setDbusValue(std::variant<uint16_t>(std::get<uint16_t>(value)));
+            break;
+        case PropertyType::Int32:
+            setDbusValue(std::variant<int32_t>(std::get<int32_t>(value)));
+            break;
+        case PropertyType::Uint32:
+            setDbusValue(std::variant<uint32_t>(std::get<uint32_t>(value)));
+            break;
+        case PropertyType::Int64:
+            setDbusValue(std::variant<int64_t>(std::get<int64_t>(value)));
+            break;
+        case PropertyType::Uint64:
+            setDbusValue(std::variant<uint64_t>(std::get<uint64_t>(value)));
+            break;
+        case PropertyType::Double:
+            setDbusValue(std::variant<double>(std::get<double>(value)));
+            break;
+        case PropertyType::String:
+            setDbusValue(
+                std::variant<std::string>(std::get<std::string>(value)));
+            break;
+        case PropertyType::ArrayString:
+            setDbusValue(std::variant<std::vector<std::string>>(
+                std::get<std::vector<std::string>>(value)));
+            break;
+        default:
+            error("Unsupported property type '{TYPE}'", "TYPE",
+                  dBusMap.propertyType);
+            throw std::invalid_argument("UnSupported Dbus Type");
     }
 }
 
 PropertyValue DBusHandler::getDbusPropertyVariant(
     const char* objPath, const char* dbusProp, const char* dbusInterface) const
 {
-    auto& bus = DBusHandler::getBus();
-    auto service = getService(objPath, dbusInterface);
-    auto method =
-        bus.new_method_call(service.c_str(), objPath, dbusProperties, "Get");
-    method.append(dbusInterface, dbusProp);
-    return bus.call(method, dbusTimeout).unpack<PropertyValue>();
+    return callService(
+        *this, objPath, dbusInterface,
+        [objPath, dbusProp, dbusInterface](const std::string& service) {
+            auto& bus = DBusHandler::getBus();
+            auto method = bus.new_method_call(service.c_str(), objPath,
+                                              dbusProperties, "Get");
+            method.append(dbusInterface, dbusProp);
+            return bus.call(method, dbusTimeout).unpack<PropertyValue>();
+        });
+}
+
+DBusWatch DBusHandler::watchDbusProperty(const DBusMapping& dBusMap,
+                                         DBusWatchCallback callback) const
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    return std::make_shared<sdbusplus::bus::match_t>(
+        getBus(),
+        rules::propertiesChanged(dBusMap.objectPath, dBusMap.interface),
+        [propertyName = dBusMap.propertyName,
+         callback = std::move(callback)](sdbusplus::message_t& msg) {
+            std::string interface;
+            DbusChangedProps properties;
+            try
+            {
+                msg.read(interface, properties);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to read PropertiesChanged of property '{PROPERTY}', error - {ERROR}",
+                    "PROPERTY", propertyName, "ERROR", e);
+                callback(std::nullopt);
+                return;
+            }
+
+            auto property = properties.find(propertyName);
+            if (property != properties.end())
+            {
+                callback(property->second);
+            }
+        });
 }
 
 GetAssociatedSubTreeResponse DBusHandler::getAssociatedSubTree(
@@ -12,6 +12,7 @@
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/common.hpp>
 #include <xyz/openbmc_project/Inventory/Manager/client.hpp>
@@ -20,7 +21,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <variant>
@@ -165,12 +169,40 @@ T decimalToBcd(T decimal)
     return bcd;
 }
 
+/** @brief D-Bus property types of the JSON mappings, resolved once from the
+ *         type name when the mapping is parsed
+ */
+enum class PropertyType
+{
+    Unknown,
+    Bool,
+    Uint8,
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Int64,
+    Uint64,
+    Double,
+    String,
+    ArrayString
+};
+
+/** @brief Resolve the type name of a D-Bus property in the JSON mappings
+ *
+ *  @param[in] typeName - type name, e.g. "uint8_t" or "array[string]"
+ *
+ *  @return PropertyType - the property type, Unknown if not supported
+ */
+PropertyType toPropertyType(std::string_view typeName);
+
 struct DBusMapping
 {
     std::string objectPath;   //!< D-Bus object path
     std::string interface;    //!< D-Bus interface
     std::string propertyName; //!< D-Bus property name
     std::string propertyType; //!< D-Bus property type
+    PropertyType type = PropertyType::Unknown; //!< resolved propertyType
 };
 
 using PropertyValue =
@@ -179,6 +211,17 @@ using PropertyValue =
                  std::vector<uint64_t>, std::vector<std::string>>;
 using DbusProp = std::string;
 using DbusChangedProps = std::map<DbusProp, PropertyValue>;
+
+/** @brief Handle of a D-Bus property watch, the watch is removed when the
+ *         last copy of the handle is destroyed
+ */
+using DBusWatch = std::shared_ptr<void>;
+
+/** @brief Callback of a D-Bus property watch, given the new value of the
+ *         property, or std::nullopt if the change could not be read
+ */
+using DBusWatchCallback =
+    std::function<void(const std::optional<PropertyValue>&)>;
 using DBusInterfaceAdded = std::vector<
     std::pair<pldm::dbus::Interface,
               std::vector<std::pair<pldm::dbus::Property,
@@ -217,6 +260,114 @@ using EffecterPDRs = std::vector<EffecterPDR>;
 constexpr auto EnumAttribute =
     "xyz.openbmc_project.BIOSConfig.Manager.AttributeType.Enumeration";
 
+/** @class DBusServiceCache
+ *
+ *  @brief Cache of the mapper GetObject responses used by
+ *         DBusHandler::getService, keyed by object path and interface.
+ *
+ *  The cache is opt-in: it is owned by the process enabling it, typically
+ *  for the lifetime of its event loop, and DBusHandler::getService queries
+ *  the mapper on every call while no cache exists. An entry is dropped when
+ *  the owner of its service changes, or when interfaces are added to or
+ *  removed from its object. The signals are matched per cached service and
+ *  per cached object only.
+ */
+class DBusServiceCache
+{
+  public:
+    using Key = std::pair<std::string, std::string>;
+
+    DBusServiceCache() = delete;
+    DBusServiceCache(const DBusServiceCache&) = delete;
+    DBusServiceCache& operator=(const DBusServiceCache&) = delete;
+    DBusServiceCache(DBusServiceCache&&) = delete;
+    DBusServiceCache& operator=(DBusServiceCache&&) = delete;
+
+    /** @brief Enable the service cache of the process
+     *
+     *  @param[in] bus - bus the invalidating signals are matched on, nullptr
+     *                   to only invalidate through the explicit calls
+     */
+    explicit DBusServiceCache(sdbusplus::bus_t* bus);
+
+    /** @brief Disable the service cache of the process */
+    ~DBusServiceCache();
+
+    /** @brief Get the service cache of the process
+     *
+     *  @return the cache, nullptr if the process did not enable one
+     */
+    static DBusServiceCache* get();
+
+    /** @brief Find the cached service of an object and interface
+     *
+     *  @param[in] key - object path and interface
+     *
+     *  @return the service name, nullptr if not cached
+     */
+    const std::string* find(const Key& key) const;
+
+    /** @brief Cache the service of an object and interface
+     *
+     *  @param[in] key - object path and interface
+     *  @param[in] service - service name
+     */
+    void insert(const Key& key, const std::string& service);
+
+    /** @brief Drop a cached entry
+     *
+     *  @param[in] key - object path and interface
+     */
+    void erase(const Key& key);
+
+    /** @brief Drop the entries of a service whose owner changed
+     *
+     *  @param[in] service - service name
+     */
+    void serviceChanged(const std::string& service);
+
+    /** @brief Drop the entries of an object whose interfaces changed
+     *
+     *  @param[in] path - D-Bus object path
+     */
+    void objectChanged(const std::string& path);
+
+    /** @brief Get the number of cached entries
+     *
+     *  @return size_t - number of entries
+     */
+    size_t size() const
+    {
+        return services.size();
+    }
+
+  private:
+    /** @brief Match the signals invalidating a new entry, and drop the
+     *         matches of the services and objects no longer cached. The
+     *         matches are only dropped here, never from their own callback.
+     *
+     *  @param[in] key - object path and interface of the new entry
+     *  @param[in] service - service name of the new entry
+     */
+    void watch(const Key& key, const std::string& service);
+
+    /** @brief bus the invalidating signals are matched on */
+    sdbusplus::bus_t* bus;
+
+    /** @brief cached services */
+    std::map<Key, std::string> services;
+
+    /** @brief NameOwnerChanged matches, by service name */
+    std::map<std::string, std::unique_ptr<sdbusplus::bus::match_t>>
+        serviceMatches;
+
+    /** @brief InterfacesAdded and InterfacesRemoved matches, by object path */
+    std::map<std::string,
+             std::pair<std::unique_ptr<sdbusplus::bus::match_t>,
+                       std::unique_ptr<sdbusplus::bus::match_t>>>
+        objectMatches;
+};
+
 /**
  * @brief The interface for DBusHandler
  */
@@ -254,6 +405,9 @@ class DBusHandlerInterface
         const sdbusplus::object_path& objectPath,
         const sdbusplus::object_path& subtree, int depth,
         const std::vector<std::string>& ifaceList) const = 0;
+
+    virtual DBusWatch watchDbusProperty(const DBusMapping& dBusMap,
+                                        DBusWatchCallback callback) const = 0;
 };
 
 /**
@@ -278,6 +432,10 @@ class DBusHandler : public DBusHandlerInterface
     /**
      *  @brief Get the DBUS Service name for the input dbus path
      *
+     *  If the process enabled a DBusServiceCache, the mapper responses are
+     *  cached until the owner of the service changes or interfaces are added
+     *  to or removed from the object.
+     *
      *  @param[in] path - DBUS object path
      *  @param[in] interface - DBUS Interface
      *
@@ -400,7 +558,8 @@ class DBusHandler : public DBusHandlerInterface
     /** @brief Set Dbus property
      *
      *  @param[in] dBusMap - Object path, property name, interface and property
-     *                       type for the D-Bus object
+     *                       type for the D-Bus object. The type name is only
+     *                       looked at if the mapping's type is not resolved.
      *  @param[in] value - The value to be set
      *
      *  @throw sdbusplus::exception_t when it fails
@@ -408,6 +567,19 @@ class DBusHandler : public DBusHandlerInterface
     void setDbusProperty(const DBusMapping& dBusMap,
                          const PropertyValue& value) const override;
 
+    /** @brief Watch the changes of a D-Bus property
+     *
+     *  @param[in] dBusMap - Object path, property name and interface of the
+     *                       D-Bus property
+     *  @param[in] callback - called from PropertiesChanged of the property
+     *
+     *  @return DBusWatch - handle of the watch
+     *
+     *  @throw sdbusplus::exception_t when the match cannot be added
+     */
+    DBusWatch watchDbusProperty(const DBusMapping& dBusMap,
+                                DBusWatchCallback callback) const override;
+
     /** @brief This function retrieves the properties of an object managed
      *         by the specified D-Bus service located at the given object path.
      *
@@ -2,6 +2,9 @@
 
 #include "fw-update/update_manager.hpp"
 
+#include <cstddef>
+#include <format>
+
 namespace pldm
 {
 namespace fw_update
@@ -31,6 +34,177 @@ ActivationIntf::Activations Activation::activation(
     return ActivationIntf::activation(value);
 }
 
+void ActivationProgress::reportProgress(uint8_t value)
+{
+    pendingProgress = value;
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = now - lastUpdate;
+    if (value >= 100 || elapsed >= updateInterval)
+    {
+        if (updateTimer.isRunning())
+        {
+            updateTimer.stop();
+        }
+        lastUpdate = now;
+        progress(value);
+        return;
+    }
+
+    if (!updateTimer.isRunning())
+    {
+        updateTimer.start(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                updateInterval - elapsed),
+            false);
+    }
+}
+
+namespace
+{
+
+/** @brief Convert a time to milliseconds since the epoch, the unit of the
+ *         Common.Progress times
+ */
+uint64_t getEpochTimeMs(std::chrono::system_clock::time_point time =
+                            std::chrono::system_clock::now())
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               time.time_since_epoch())
+        .count();
+}
+
+constexpr auto emitsChange = sdbusplus::vtable::property_::emits_change;
+
+/** @brief Names of the properties holding the time spent in each UpdatePhase,
+ *         in milliseconds
+ */
+constexpr std::array<const char*, updatePhaseCount> phaseTimeProperties{
+    "RequestUpdateTime", "PassComponentTableTime", "TransferTime",
+    "VerifyTime",        "ApplyTime",              "ActivateTime"};
+
+} // namespace
+
+void ActivationProgress::reportStart()
+{
+    startTime(getEpochTimeMs());
+    completedTime(0);
+    status(OperationStatus::InProgress);
+}
+
+void ActivationProgress::reportCompletion(bool success)
+{
+    completedTime(getEpochTimeMs());
+    status(success ? OperationStatus::Completed : OperationStatus::Failed);
+}
+
+const sdbusplus::vtable_t UpdateEstimate::vtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::property_o("EstimatedCompletionTime", "t",
+                                  offsetof(Properties, estimatedCompletionTime),
+                                  emitsChange),
+    sdbusplus::vtable::end()};
+
+UpdateEstimate::UpdateEstimate(sdbusplus::bus_t& bus,
+                               const std::string& objPath) :
+    intf(bus, objPath.c_str(),
+         "xyz.openbmc_project.PLDM.FirmwareUpdate.Estimate", vtable,
+         &properties)
+{
+    intf.emit_added();
+}
+
+void UpdateEstimate::reportEstimatedCompletion(std::chrono::seconds remaining)
+{
+    properties.estimatedCompletionTime =
+        getEpochTimeMs(std::chrono::system_clock::now() + remaining);
+    intf.property_changed("EstimatedCompletionTime");
+}
+
+const sdbusplus::vtable_t DeviceUpdateMetrics::vtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::property_o("Progress", "y",
+                                  offsetof(Properties, progress), emitsChange),
+    sdbusplus::vtable::property_o("TransferBytes", "t",
+                                  offsetof(Properties, transferBytes),
+                                  emitsChange),
+    sdbusplus::vtable::property_o("BytesPerSecond", "t",
+                                  offsetof(Properties, bytesPerSecond),
+                                  emitsChange),
+    sdbusplus::vtable::property_o("RetransmittedRequests", "t",
+                                  offsetof(Properties, retransmittedRequests),
+                                  emitsChange),
+    sdbusplus::vtable::property_o("RetransmittedBytes", "t",
+                                  offsetof(Properties, retransmittedBytes),
+                                  emitsChange),
+    sdbusplus::vtable::property_o("TransferRetries", "t",
+                                  offsetof(Properties, transferRetries),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[0], "t",
+                                  offsetof(Properties, phaseTimes),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[1], "t",
+                                  offsetof(Properties, phaseTimes) +
+                                      sizeof(uint64_t),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[2], "t",
+                                  offsetof(Properties, phaseTimes) +
+                                      2 * sizeof(uint64_t),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[3], "t",
+                                  offsetof(Properties, phaseTimes) +
+                                      3 * sizeof(uint64_t),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[4], "t",
+                                  offsetof(Properties, phaseTimes) +
+                                      4 * sizeof(uint64_t),
+                                  emitsChange),
+    sdbusplus::vtable::property_o(phaseTimeProperties[5], "t",
+                                  offsetof(Properties, phaseTimes) +
+                                      5 * sizeof(uint64_t),
+                                  emitsChange),
+    sdbusplus::vtable::end()};
+
+DeviceUpdateMetrics::DeviceUpdateMetrics(
+    sdbusplus::bus_t& bus, const std::string& activationPath, mctp_eid_t eid) :
+    intf(bus, std::format("{}/eid_{}", activationPath, eid).c_str(),
+         "xyz.openbmc_project.PLDM.FirmwareUpdate.DeviceMetrics", vtable,
+         &properties)
+{
+    intf.emit_added();
+}
+
+void DeviceUpdateMetrics::update(const UpdateMetrics& metrics)
+{
+    auto set = [this](auto& property, auto value, const char* name) {
+        if (property != value)
+        {
+            property = value;
+            intf.property_changed(name);
+        }
+    };
+
+    set(properties.progress, metrics.progress, "Progress");
+    set(properties.transferBytes, metrics.transferBytes, "TransferBytes");
+    set(properties.bytesPerSecond, metrics.bytesPerSecond(), "BytesPerSecond");
+    set(properties.retransmittedRequests,
+        static_cast<uint64_t>(metrics.retransmittedRequests),
+        "RetransmittedRequests");
+    set(properties.retransmittedBytes, metrics.retransmittedBytes,
+        "RetransmittedBytes");
+    set(properties.transferRetries,
+        static_cast<uint64_t>(metrics.transferRetries), "TransferRetries");
+    for (size_t phase = 0; phase < updatePhaseCount; ++phase)
+    {
+        set(properties.phaseTimes[phase],
+            static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    metrics.phaseTimes[phase])
+                    .count()),
+            phaseTimeProperties[phase]);
+    }
+}
+
 void Delete::delete_()
 {
     updateManager->resetActivationState();
@@ -1,10 +1,19 @@
 #pragma once
 
+#include "device_updater.hpp"
+
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <xyz/openbmc_project/Common/Progress/server.hpp>
 #include <xyz/openbmc_project/Object/Delete/server.hpp>
 #include <xyz/openbmc_project/Software/Activation/server.hpp>
 #include <xyz/openbmc_project/Software/ActivationProgress/server.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace pldm
@@ -18,14 +27,17 @@ class UpdateManagerBase;
 using ActivationIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Software::server::Activation>;
 using ActivationProgressIntf = sdbusplus::server::object_t<
-    sdbusplus::xyz::openbmc_project::Software::server::ActivationProgress>;
+    sdbusplus::xyz::openbmc_project::Software::server::ActivationProgress,
+    sdbusplus::xyz::openbmc_project::Common::server::Progress>;
 using DeleteIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Object::server::Delete>;
 
 /** @class ActivationProgress
  *
  *  Concrete implementation of xyz.openbmc_project.Software.ActivationProgress
- *  D-Bus interface
+ *  D-Bus interface. The xyz.openbmc_project.Common.Progress interface of the
+ *  same object publishes the StartTime and the CompletedTime of the
+ *  activation.
  */
 class ActivationProgress : public ActivationProgressIntf
 {
@@ -37,10 +49,141 @@ class ActivationProgress : public ActivationProgressIntf
      */
     ActivationProgress(sdbusplus::bus_t& bus, const std::string& objPath) :
         ActivationProgressIntf(bus, objPath.c_str(),
-                               action::emit_interface_added)
+                               action::emit_interface_added),
+        updateTimer([this]() {
+            lastUpdate = std::chrono::steady_clock::now();
+            progress(pendingProgress);
+        })
     {
         progress(0);
     }
+
+    /** @brief Report the progress of the activation
+     *
+     *  The Progress property is set at most once per updateInterval, the
+     *  latest progress reported in between is set when the interval expires.
+     *  Completion is set right away.
+     *
+     *  @param[in] value - progress of the activation, in percent
+     */
+    void reportProgress(uint8_t value);
+
+    /** @brief Report the start of the activation */
+    void reportStart();
+
+    /** @brief Report the completion of the activation
+     *
+     *  @param[in] success - whether the activation succeeded
+     */
+    void reportCompletion(bool success);
+
+  private:
+    /** @brief Minimum interval between two updates of the Progress property */
+    static constexpr std::chrono::milliseconds updateInterval{500};
+
+    /** @brief Latest progress reported */
+    uint8_t pendingProgress = 0;
+
+    /** @brief Time the Progress property was last set */
+    std::chrono::steady_clock::time_point lastUpdate{};
+
+    /** @brief Timer setting the pending progress once updateInterval expires
+     */
+    sdbusplus::Timer updateTimer;
+};
+
+/** @class UpdateEstimate
+ *
+ *  Publishes the estimated completion time of an activation, in milliseconds
+ *  since the epoch, in the EstimatedCompletionTime property of the
+ *  xyz.openbmc_project.PLDM.FirmwareUpdate.Estimate D-Bus interface. The
+ *  property is 0 until the first estimate.
+ */
+class UpdateEstimate
+{
+  public:
+    UpdateEstimate() = delete;
+    UpdateEstimate(const UpdateEstimate&) = delete;
+    UpdateEstimate(UpdateEstimate&&) = delete;
+    UpdateEstimate& operator=(const UpdateEstimate&) = delete;
+    UpdateEstimate& operator=(UpdateEstimate&&) = delete;
+    ~UpdateEstimate() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] bus - Bus to attach to
+     *  @param[in] objPath - D-Bus object path of the activation
+     */
+    UpdateEstimate(sdbusplus::bus_t& bus, const std::string& objPath);
+
+    /** @brief Report the estimated completion time of the activation
+     *
+     *  @param[in] remaining - estimated time to the completion
+     */
+    void reportEstimatedCompletion(std::chrono::seconds remaining);
+
+  private:
+    /** @brief Values of the D-Bus properties, read by sd-bus */
+    struct Properties
+    {
+        uint64_t estimatedCompletionTime = 0;
+    };
+
+    static const sdbusplus::vtable_t vtable[];
+
+    Properties properties;
+    sdbusplus::server::interface_t intf;
+};
+
+/** @class DeviceUpdateMetrics
+ *
+ *  Publishes the timing and throughput of the update of a firmware device in
+ *  the xyz.openbmc_project.PLDM.FirmwareUpdate.DeviceMetrics D-Bus interface,
+ *  on an object below the activation object. The times are in milliseconds.
+ */
+class DeviceUpdateMetrics
+{
+  public:
+    DeviceUpdateMetrics() = delete;
+    DeviceUpdateMetrics(const DeviceUpdateMetrics&) = delete;
+    DeviceUpdateMetrics(DeviceUpdateMetrics&&) = delete;
+    DeviceUpdateMetrics& operator=(const DeviceUpdateMetrics&) = delete;
+    DeviceUpdateMetrics& operator=(DeviceUpdateMetrics&&) = delete;
+    ~DeviceUpdateMetrics() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] bus - Bus to attach to
+     *  @param[in] activationPath - D-Bus object path of the activation
+     *  @param[in] eid - Endpoint ID of the firmware device
+     */
+    DeviceUpdateMetrics(sdbusplus::bus_t& bus,
+                        const std::string& activationPath, mctp_eid_t eid);
+
+    /** @brief Publish the metrics of the update of the device, only the
+     *         changed properties are signalled
+     *
+     *  @param[in] metrics - timing and throughput of the update
+     */
+    void update(const UpdateMetrics& metrics);
+
+  private:
+    /** @brief Values of the D-Bus properties, read by sd-bus */
+    struct Properties
+    {
+        uint8_t progress = 0;
+        uint64_t transferBytes = 0;
+        uint64_t bytesPerSecond = 0;
+        uint64_t retransmittedRequests = 0;
+        uint64_t retransmittedBytes = 0;
+        uint64_t transferRetries = 0;
+        std::array<uint64_t, updatePhaseCount> phaseTimes{};
+    };
+
+    static const sdbusplus::vtable_t vtable[];
+
+    Properties properties;
+    sdbusplus::server::interface_t intf;
 };
 
 /** @class Delete
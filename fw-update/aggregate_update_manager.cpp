@@ -1,7 +1,5 @@
 #include "aggregate_update_manager.hpp"
 
-#include "common/start_lifetime_as.hpp"
-
 #include <memory>
 
 namespace pldm::fw_update
@@ -10,25 +8,39 @@ namespace pldm::fw_update
 Response AggregateUpdateManager::handleRequest(
     mctp_eid_t eid, uint8_t command, const pldm_msg* request, size_t reqMsgLen)
 {
-    Response response;
-    response = UpdateManager::handleRequest(eid, command, request, reqMsgLen);
-    auto responseMsg = std::start_lifetime_as<pldm_msg>(response.data());
-    if (responseMsg->payload[0] != PLDM_FWUP_COMMAND_NOT_EXPECTED)
+    auto route = activeUpdates.find(eid);
+    if (route != activeUpdates.end())
     {
-        return response;
+        auto updateManager = updateManagers.find(route->second);
+        if (updateManager != updateManagers.end())
+        {
+            return updateManager->second->handleRequest(eid, command, request,
+                                                        reqMsgLen);
+        }
     }
-    for (auto& [_, updateManager] : updateManagers)
+
+    return UpdateManager::handleRequest(eid, command, request, reqMsgLen);
+}
+
+void AggregateUpdateManager::routeUpdate(
+    const SoftwareIdentifier& softwareIdentifier, bool active)
+{
+    auto eid = softwareIdentifier.first;
+    if (active)
+    {
+        activeUpdates.insert_or_assign(eid, softwareIdentifier);
+        return;
+    }
+
+    auto route = activeUpdates.find(eid);
+    if (route != activeUpdates.end() && route->second == softwareIdentifier)
     {
-        response =
-            updateManager->handleRequest(eid, command, request, reqMsgLen);
-        auto relayedResponseMsg =
-            std::start_lifetime_as<pldm_msg>(response.data());
-        if (relayedResponseMsg->payload[0] != PLDM_FWUP_COMMAND_NOT_EXPECTED)
+        activeUpdates.erase(route);
+        if (deviceUpdateHandler)
         {
-            return response;
+            deviceUpdateHandler(eid);
         }
     }
-    return response;
 }
 
 void AggregateUpdateManager::createUpdateManager(
@@ -46,12 +58,17 @@ void AggregateUpdateManager::createUpdateManager(
     updateManagers[softwareIdentifier] = std::make_unique<ItemUpdateManager>(
         eid, event, handler, instanceIdDb, updateObjPath, generatedId,
         *descriptorMap[softwareIdentifier],
-        *componentInfoMap[softwareIdentifier]);
+        *componentInfoMap[softwareIdentifier],
+        [this, softwareIdentifier](bool active) {
+            routeUpdate(softwareIdentifier, active);
+        },
+        summaryDir);
 }
 
 void AggregateUpdateManager::eraseUpdateManager(
     const SoftwareIdentifier& softwareIdentifier)
 {
+    routeUpdate(softwareIdentifier, false);
     updateManagers.erase(softwareIdentifier);
     descriptorMap.erase(softwareIdentifier);
     componentInfoMap.erase(softwareIdentifier);
@@ -64,6 +81,7 @@ void AggregateUpdateManager::eraseUpdateManagerIf(
     {
         if (predicate(it->first))
         {
+            routeUpdate(it->first, false);
             descriptorMap.erase(it->first);
             componentInfoMap.erase(it->first);
             it = updateManagers.erase(it);
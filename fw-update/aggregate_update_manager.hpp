@@ -3,6 +3,8 @@
 #include "item_update_manager.hpp"
 #include "update_manager.hpp"
 
+#include <unordered_map>
+
 namespace pldm::fw_update
 {
 
@@ -24,21 +26,29 @@ class AggregateUpdateManager : public UpdateManager
      * @param[in] descriptorMap - Descriptor map for the update manager
      * @param[in] componentInfoMap - Component information map for the update
      * manager
+     * @param[in] deviceUpdateHandler - Invoked when the update of a device
+     * completes, by package or by item
+     * @param[in] summaryDir - Directory the summary of each update, by package
+     * or by item, is written to, empty to not write it
      */
     explicit AggregateUpdateManager(
         Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, const DescriptorMap& descriptorMap,
-        const ComponentInfoMap& componentInfoMap) :
+        const ComponentInfoMap& componentInfoMap,
+        DeviceUpdateHandler deviceUpdateHandler = {},
+        std::filesystem::path summaryDir = {}) :
         UpdateManager(event, handler, instanceIdDb, descriptorMap,
-                      componentInfoMap)
+                      componentInfoMap, std::move(deviceUpdateHandler),
+                      std::move(summaryDir))
     {}
 
     /**
      * @brief Handle PLDM requests for the aggregate update manager
      *
-     * This function processes incoming PLDM requests and dispatches them to the
-     * appropriate update manager based on the software identifier.
+     * This function dispatches incoming PLDM requests to the update manager
+     * currently updating the endpoint, or to the package based update manager
+     * when no item update is in progress for the endpoint.
      *
      * @param[in] eid - Remote MCTP Endpoint ID
      * @param[in] command - PLDM command code
@@ -97,13 +107,32 @@ class AggregateUpdateManager : public UpdateManager
     void eraseUpdateManagerIf(
         std::function<bool(const SoftwareIdentifier&)>&& predicate);
 
-  private:
+  protected:
+    /**
+     * @brief Route the firmware update commands of an endpoint to an
+     *        ItemUpdateManager, or stop routing them
+     *
+     * @param[in] softwareIdentifier - The software identifier of the
+     * ItemUpdateManager
+     * @param[in] active - true when the update starts, false when it is
+     * complete
+     */
+    void routeUpdate(const SoftwareIdentifier& softwareIdentifier,
+                     bool active);
+
+    /**
+     * @brief Software identifier of the ItemUpdateManager updating each
+     * endpoint, keyed by EID
+     */
+    std::unordered_map<mctp_eid_t, SoftwareIdentifier> activeUpdates;
+
     /**
      * @brief Map of UpdateManager instances keyed by software identifier
      */
     std::map<SoftwareIdentifier, std::unique_ptr<ItemUpdateManager>>
         updateManagers;
 
+  private:
     /**
      * @brief Map of descriptor maps keyed by software identifier
      */
@@ -7,7 +7,10 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -23,6 +26,48 @@ static constexpr uint8_t componentVerifyProgressPercent = 98;
 static constexpr uint8_t componentApplyProgressPercent = 99;
 static constexpr uint8_t firmwareActivationProgressPercent = 100;
 
+// Re-arms of the update of a device after failed component transfers
+static constexpr size_t maxTransferRetries = FW_UPDATE_TRANSFER_RETRIES;
+
+/** @brief Add the range [begin, end) to the merged served ranges
+ *
+ *  @param[in,out] ranges - the served ranges, keyed by their start offset
+ *  @param[in] begin - start offset of the range
+ *  @param[in] end - end offset of the range
+ *
+ *  @return the number of bytes of the range not served before
+ */
+static uint32_t addServedRange(std::map<uint32_t, uint32_t>& ranges,
+                               uint32_t begin, uint32_t end)
+{
+    if (begin >= end)
+    {
+        return 0;
+    }
+
+    uint32_t newBytes = end - begin;
+    // The range before begin may reach into or past it
+    auto it = ranges.upper_bound(begin);
+    if (it != ranges.begin() && std::prev(it)->second >= begin)
+    {
+        --it;
+    }
+    while (it != ranges.end() && it->first <= end)
+    {
+        auto overlapBegin = std::max(it->first, begin);
+        auto overlapEnd = std::min(it->second, end);
+        if (overlapEnd > overlapBegin)
+        {
+            newBytes -= overlapEnd - overlapBegin;
+        }
+        begin = std::min(begin, it->first);
+        end = std::max(end, it->second);
+        it = ranges.erase(it);
+    }
+    ranges.emplace(begin, end);
+    return newBytes;
+}
+
 UpdateProgress::UpdateProgress(uint32_t totalSize, mctp_eid_t eid) :
     progress{}, eid{eid}, totalSize{totalSize}, totalUpdated{},
     currentState{state::Update}
@@ -90,8 +135,27 @@ void UpdateProgress::reportFwUpdate(uint32_t amountUpdated)
     return;
 }
 
+uint32_t getMaxTransferSize()
+{
+    // MCTP message type, PLDM header and completion code of the
+    // RequestFirmwareData response
+    constexpr size_t respOverhead =
+        sizeof(uint8_t) + sizeof(pldm_msg_hdr) + sizeof(uint8_t);
+    constexpr uint32_t transportTransferSize =
+        mctpMaxMessageSize - respOverhead;
+
+    uint32_t transferSize = FW_UPDATE_TRANSFER_SIZE;
+    if (!transferSize)
+    {
+        return transportTransferSize;
+    }
+
+    return std::clamp<uint32_t>(transferSize, PLDM_FWUP_BASELINE_TRANSFER_SIZE,
+                                transportTransferSize);
+}
+
 DeviceUpdater::DeviceUpdater(
-    mctp_eid_t eid, std::istream& package,
+    mctp_eid_t eid, const PackageReader& package,
     const FirmwareDeviceIDRecord& fwDeviceIDRecord,
     const ComponentImageInfos& compImageInfos, const ComponentInfo& compInfo,
     uint32_t maxTransferSize, UpdateManagerBase* updateManager) :
@@ -109,11 +173,40 @@ DeviceUpdater::DeviceUpdater(
         const auto& componentSize =
             std::get<6>(compImageInfos[applicableComponent]);
         progress.emplace_back(componentSize, eid);
+        totalCompSize += componentSize;
+    }
+    servedRanges.resize(applicableComponents.size());
+}
+
+void DeviceUpdater::updateProgress(
+    const std::function<void(UpdateProgress&)>& update)
+{
+    // technically this should never happen, as its an invariant
+    // but check to prefer a failed fw update over a pldm crash
+    if (componentIndex >= progress.size())
+    {
+        return;
+    }
+
+    auto& compProgress = progress[componentIndex];
+    auto previousProgress = getProgress();
+    weightedProgress -= static_cast<uint64_t>(compProgress.getTotalSize()) *
+                        compProgress.getProgress();
+    update(compProgress);
+    weightedProgress += static_cast<uint64_t>(compProgress.getTotalSize()) *
+                        compProgress.getProgress();
+
+    auto currentProgress = getProgress();
+    if (updateManager != nullptr && currentProgress != previousProgress)
+    {
+        updateManager->updateActivationProgress(eid, previousProgress,
+                                                currentProgress);
     }
 }
 
 void DeviceUpdater::startFwUpdateFlow()
 {
+    enterPhase(UpdatePhase::RequestUpdate);
     auto instanceIdResult = updateManager->instanceIdDb.next(eid);
     if (!instanceIdResult)
     {
@@ -205,6 +298,7 @@ void DeviceUpdater::requestUpdate(mctp_eid_t eid, const pldm_msg* response,
     }
 
     // Optional fields DeviceMetaData and GetPackageData not handled
+    enterPhase(UpdatePhase::PassComponentTable);
     pldmRequest = std::make_unique<sdeventplus::source::Defer>(
         updateManager->event,
         std::bind(&DeviceUpdater::sendPassCompTableRequest, this,
@@ -371,6 +465,7 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
 void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
 {
     pldmRequest.reset();
+    enterPhase(UpdatePhase::Transfer);
     auto instanceIdResult = updateManager->instanceIdDb.next(eid);
     if (!instanceIdResult)
     {
@@ -457,7 +552,10 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
         error(
             "No response received for update component with endpoint ID {EID}",
             "EID", eid);
-        updateManager->updateDeviceCompletion(eid, false);
+        if (!retryTransfer(true))
+        {
+            updateManager->updateDeviceCompletion(eid, false);
+        }
         return;
     }
 
@@ -555,6 +653,10 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
 void DeviceUpdater::createRequestFwDataTimer()
 {
     reqFwDataTimer = std::make_unique<sdbusplus::Timer>([this]() -> void {
+        if (retryTransfer(false))
+        {
+            return;
+        }
         componentUpdateStatus[componentIndex] = false;
         sendCancelUpdateComponentRequest();
         updateManager->updateDeviceCompletion(eid, false);
@@ -629,24 +731,50 @@ Response DeviceUpdater::requestFwData(const pldm_msg* request,
         padBytes = offset + length - compSize;
     }
 
-    if (componentIndex < progress.size())
+    auto data = package.read(compOffset + offset, length - padBytes);
+    if (data.size() != length - padBytes)
     {
-        // technically this should never happen, as its an invariant
-        // but check to prefer a failed fw update over a pldm crash
-        progress[componentIndex].reportFwUpdate(length);
-        if (updateManager != nullptr)
+        error(
+            "Failed to read component data at offset '{OFFSET}' and length '{LENGTH}' for endpoint ID '{EID}'",
+            "OFFSET", compOffset + offset, "LENGTH", length - padBytes, "EID",
+            eid);
+        rc = encode_request_firmware_data_resp(
+            request->hdr.instance_id, PLDM_FWUP_DATA_OUT_OF_RANGE, responseMsg,
+            sizeof(completionCode));
+        if (rc)
         {
-            updateManager->updateActivationProgress();
+            error(
+                "Failed to encode request firmware date response for endpoint ID '{EID}', response code '{RC}'",
+                "EID", eid, "RC", rc);
         }
+        return response;
+    }
+
+    // Only the data not served before counts towards the progress, the
+    // device may request data in any order and again after a retry
+    auto end = std::min<uint32_t>(offset + length, compSize);
+    auto served = addServedRange(servedRanges[componentIndex], offset, end);
+    if (served < end - offset)
+    {
+        ++retransmittedRequests;
+        retransmittedBytes += end - offset - served;
+    }
+    if (served)
+    {
+        updateProgress([served](UpdateProgress& compProgress) {
+            compProgress.reportFwUpdate(served);
+        });
+    }
+    transferBytes += length;
+    if (!transferStart)
+    {
+        transferStart = std::chrono::steady_clock::now();
     }
 
     response.resize(sizeof(pldm_msg_hdr) + sizeof(completionCode) + length);
     responseMsg = new (response.data()) pldm_msg;
-    package.seekg(compOffset + offset);
-    package.read(
-        reinterpret_cast<char*>(
-            response.data() + sizeof(pldm_msg_hdr) + sizeof(completionCode)),
-        length - padBytes);
+    std::ranges::copy(data, response.begin() + sizeof(pldm_msg_hdr) +
+                                sizeof(completionCode));
     rc = encode_request_firmware_data_resp(
         request->hdr.instance_id, completionCode, responseMsg,
         sizeof(completionCode));
@@ -695,6 +823,12 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
         reqFwDataTimer.reset();
     }
 
+    if (transferStart)
+    {
+        transferTime += std::chrono::steady_clock::now() - *transferStart;
+        transferStart.reset();
+    }
+
     uint8_t transferResult = 0;
     auto rc =
         decode_transfer_complete_req(request, payloadLength, &transferResult);
@@ -725,6 +859,12 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
         info(
             "Component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' transfer complete.",
             "EID", eid, "COMPONENT_VERSION", compVersion);
+        enterPhase(UpdatePhase::Verify);
+        if (componentIndex == applicableComponents.size() - 1)
+        {
+            updateManager->updateTransferCompletion(eid, transferBytes,
+                                                    transferTime);
+        }
     }
     else
     {
@@ -732,9 +872,12 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
             "Failure in transfer of the component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' with transfer result - {RESULT}",
             "EID", eid, "COMPONENT_VERSION", compVersion, "RESULT",
             transferResult);
-        updateManager->updateDeviceCompletion(eid, false);
-        componentUpdateStatus[componentIndex] = false;
-        sendCancelUpdateComponentRequest();
+        if (!retryTransfer(false))
+        {
+            updateManager->updateDeviceCompletion(eid, false);
+            componentUpdateStatus[componentIndex] = false;
+            sendCancelUpdateComponentRequest();
+        }
     }
 
     rc = encode_transfer_complete_resp(request->hdr.instance_id, completionCode,
@@ -780,19 +923,15 @@ Response DeviceUpdater::verifyComplete(const pldm_msg* request,
         std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
-    if (componentIndex < progress.size())
-    {
-        progress[componentIndex].updateState(UpdateProgress::state::Verify);
-        if (updateManager != nullptr)
-        {
-            updateManager->updateActivationProgress();
-        }
-    }
+    updateProgress([](UpdateProgress& compProgress) {
+        compProgress.updateState(UpdateProgress::state::Verify);
+    });
     if (verifyResult == PLDM_FWUP_VERIFY_SUCCESS)
     {
         info(
             "Component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' verification complete.",
             "EID", eid, "COMPONENT_VERSION", compVersion);
+        enterPhase(UpdatePhase::Apply);
     }
     else
     {
@@ -800,6 +939,8 @@ Response DeviceUpdater::verifyComplete(const pldm_msg* request,
             "Failed to verify component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' with transfer result - '{RESULT}'",
             "EID", eid, "COMPONENT_VERSION", compVersion, "RESULT",
             verifyResult);
+        // The image reached the device, transferring it again would fail
+        // the verification the same way
         updateManager->updateDeviceCompletion(eid, false);
         componentUpdateStatus[componentIndex] = false;
         sendCancelUpdateComponentRequest();
@@ -857,14 +998,9 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
         info(
             "Component endpoint ID '{EID}' with '{COMPONENT_VERSION}' apply complete.",
             "EID", eid, "COMPONENT_VERSION", compVersion);
-        if (componentIndex < progress.size())
-        {
-            progress[componentIndex].updateState(UpdateProgress::state::Apply);
-            if (updateManager != nullptr)
-            {
-                updateManager->updateActivationProgress();
-            }
-        }
+        updateProgress([](UpdateProgress& compProgress) {
+            compProgress.updateState(UpdateProgress::state::Apply);
+        });
         if (componentIndex == applicableComponents.size() - 1)
         {
             componentIndex = 0;
@@ -920,6 +1056,7 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
 void DeviceUpdater::sendActivateFirmwareRequest()
 {
     pldmRequest.reset();
+    enterPhase(UpdatePhase::Activate);
     auto instanceIdResult = updateManager->instanceIdDb.next(eid);
     if (!instanceIdResult)
     {
@@ -991,13 +1128,16 @@ void DeviceUpdater::activateFirmware(mctp_eid_t eid, const pldm_msg* response,
         return;
     }
 
+    enterPhase(std::nullopt);
+    auto previousProgress = getProgress();
     activationComplete = true;
     if (updateManager == nullptr)
     {
         return;
     }
 
-    updateManager->updateActivationProgress();
+    updateManager->updateActivationProgress(eid, previousProgress,
+                                            getProgress());
     updateManager->updateDeviceCompletion(eid, true);
 }
 
@@ -1041,12 +1181,18 @@ void DeviceUpdater::sendCancelUpdateComponentRequest()
 void DeviceUpdater::cancelUpdateComponent(
     mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
 {
+    auto rearming = std::exchange(rearmingComponent, false);
+
     // Check if response is valid
     if (response == nullptr || !respMsgLen)
     {
         error(
             "No response received for cancel update component for endpoint ID '{EID}'",
             "EID", eid);
+        if (rearming)
+        {
+            sendCancelUpdateRequest();
+        }
         return;
     }
 
@@ -1059,6 +1205,10 @@ void DeviceUpdater::cancelUpdateComponent(
             "Failed to decode cancel update component response for endpoint ID '{EID}', component index '{COMPONENT_INDEX}', completion code '{CC}'",
             "EID", eid, "COMPONENT_INDEX", componentIndex, "CC",
             completionCode);
+        if (rearming)
+        {
+            sendCancelUpdateRequest();
+        }
         return;
     }
     if (completionCode)
@@ -1067,6 +1217,21 @@ void DeviceUpdater::cancelUpdateComponent(
             "Failed to cancel update component for endpoint ID '{EID}', component index '{COMPONENT_INDEX}', completion code '{CC}'",
             "EID", eid, "COMPONENT_INDEX", componentIndex, "CC",
             completionCode);
+        if (rearming)
+        {
+            sendCancelUpdateRequest();
+        }
+        return;
+    }
+
+    if (rearming)
+    {
+        // Request the same component again, the device is still in update
+        // mode
+        pldmRequest = std::make_unique<sdeventplus::source::Defer>(
+            updateManager->event,
+            std::bind(&DeviceUpdater::sendUpdateComponentRequest, this,
+                      componentIndex));
         return;
     }
 
@@ -1105,6 +1270,147 @@ void DeviceUpdater::cancelUpdateComponent(
     return;
 }
 
+void DeviceUpdater::enterPhase(std::optional<UpdatePhase> phase)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (currentPhase)
+    {
+        phaseTimes[std::to_underlying(*currentPhase)] += now - phaseStart;
+    }
+    currentPhase = phase;
+    phaseStart = now;
+}
+
+UpdateMetrics DeviceUpdater::getMetrics() const
+{
+    UpdateMetrics metrics{};
+    auto now = std::chrono::steady_clock::now();
+
+    metrics.progress = getProgress();
+    metrics.phaseTimes = phaseTimes;
+    if (currentPhase)
+    {
+        metrics.phaseTimes[std::to_underlying(*currentPhase)] +=
+            now - phaseStart;
+    }
+    metrics.transferBytes = transferBytes;
+    metrics.transferTime = transferTime;
+    if (transferStart)
+    {
+        metrics.transferTime += now - *transferStart;
+    }
+    metrics.retransmittedRequests = retransmittedRequests;
+    metrics.retransmittedBytes = retransmittedBytes;
+    metrics.transferRetries = transferRetries;
+    return metrics;
+}
+
+bool DeviceUpdater::retryTransfer(bool restartUpdate)
+{
+    if (transferRetries >= maxTransferRetries)
+    {
+        return false;
+    }
+
+    ++transferRetries;
+    warning(
+        "Re-arming the update of component index '{COMPONENT_INDEX}' on endpoint ID '{EID}', retry {RETRY} of {RETRIES}",
+        "COMPONENT_INDEX", componentIndex, "EID", eid, "RETRY",
+        transferRetries, "RETRIES", maxTransferRetries);
+    if (reqFwDataTimer)
+    {
+        reqFwDataTimer->stop();
+    }
+    if (transferStart)
+    {
+        transferTime += std::chrono::steady_clock::now() - *transferStart;
+        transferStart.reset();
+    }
+
+    if (restartUpdate)
+    {
+        sendCancelUpdateRequest();
+    }
+    else
+    {
+        rearmingComponent = true;
+        sendCancelUpdateComponentRequest();
+    }
+    return true;
+}
+
+void DeviceUpdater::sendCancelUpdateRequest()
+{
+    pldmRequest.reset();
+    auto instanceIdResult = updateManager->instanceIdDb.next(eid);
+    if (!instanceIdResult)
+    {
+        throw pldm::InstanceIdError(instanceIdResult.error());
+    }
+    auto instanceId = instanceIdResult.value();
+    Request request(sizeof(pldm_msg_hdr));
+    auto requestMsg = new (request.data()) pldm_msg;
+
+    auto rc = encode_cancel_update_req(instanceId, requestMsg,
+                                       PLDM_CANCEL_UPDATE_REQ_BYTES);
+    if (rc)
+    {
+        updateManager->instanceIdDb.free(eid, instanceId);
+        error(
+            "Failed to encode cancel update request for endpoint ID '{EID}', response code '{RC}'",
+            "EID", eid, "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
+        return;
+    }
+
+    rc = updateManager->handler.registerRequest(
+        eid, instanceId, PLDM_FWUP, PLDM_CANCEL_UPDATE, std::move(request),
+        [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
+            this->cancelUpdate(eid, response, respMsgLen);
+        });
+    if (rc)
+    {
+        error(
+            "Failed to send cancel update request for endpoint ID '{EID}', response code '{RC}'",
+            "EID", eid, "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
+    }
+}
+
+void DeviceUpdater::cancelUpdate(mctp_eid_t eid, const pldm_msg* response,
+                                 size_t respMsgLen)
+{
+    if (response == nullptr || !respMsgLen)
+    {
+        error("No response received for cancel update for endpoint ID '{EID}'",
+              "EID", eid);
+    }
+    else
+    {
+        uint8_t completionCode = 0;
+        bool8_t nonFunctioningComponentIndication = 0;
+        bitfield64_t nonFunctioningComponentBitmap{0};
+        auto rc = decode_cancel_update_resp(
+            response, respMsgLen, &completionCode,
+            &nonFunctioningComponentIndication, &nonFunctioningComponentBitmap);
+        if (rc || completionCode)
+        {
+            error(
+                "Failed to cancel update for endpoint ID '{EID}', response code '{RC}', completion code '{CC}'",
+                "EID", eid, "RC", rc, "CC", completionCode);
+        }
+    }
+
+    // The device leaves update mode, all the components are passed and
+    // updated again
+    componentIndex = 0;
+    componentUpdateStatus.clear();
+    reqFwDataTimer.reset();
+    pldmRequest = std::make_unique<sdeventplus::source::Defer>(
+        updateManager->event,
+        std::bind(&DeviceUpdater::startFwUpdateFlow, this));
+}
+
 uint8_t DeviceUpdater::getProgress() const
 {
     if (progress.empty())
@@ -1117,25 +1423,13 @@ uint8_t DeviceUpdater::getProgress() const
         return firmwareActivationProgressPercent;
     }
 
-    uint64_t totalSize = 0;
-    uint64_t weightedProgress = 0;
-    for (const auto& el : progress)
-    {
-        totalSize += el.getTotalSize();
-        weightedProgress +=
-            el.getTotalSize() * static_cast<uint64_t>(el.getProgress());
-    }
-
-    if (totalSize == 0)
+    if (totalCompSize == 0)
     {
         error("total component size is 0 on eid {EID}", "EID", eid);
         return 0;
     }
 
-    const double percentage =
-        static_cast<double>(weightedProgress) / static_cast<double>(totalSize);
-
-    return static_cast<uint8_t>(std::floor(percentage));
+    return static_cast<uint8_t>(weightedProgress / totalCompSize);
 }
 
 } // namespace fw_update
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/types.hpp"
+#include "package_reader.hpp"
 
 #include <libpldm/base.h>
 #include <linux/mctp.h>
@@ -9,6 +10,12 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <array>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <optional>
+
 namespace pldm
 {
 
@@ -23,6 +30,78 @@ using ComponentUpdateStatusMap = std::map<size_t, bool>;
 
 class UpdateManagerBase;
 
+/** @brief Largest MCTP message, in bytes, carried by the MCTP transports used
+ *         by pldmd. Both libmctp and the kernel MCTP stack reassemble
+ *         messages of up to 64 KiB, whatever the MTU of the link.
+ */
+constexpr size_t mctpMaxMessageSize = 64 * 1024;
+
+/** @brief Get the MaximumTransferSize to advertise to a firmware device
+ *
+ *  The firmware device picks the size of each RequestFirmwareData within
+ *  this limit. Some devices request the advertised size as is, so the
+ *  sizes above 4096 bytes are opted into by the platform.
+ *
+ *  @return the fw-update-transfer-size option, 4096 by default, or the
+ *          largest RequestFirmwareData payload whose response fits in one
+ *          MCTP message if the option is 0
+ */
+uint32_t getMaxTransferSize();
+
+/** @brief Phases of the update of a firmware device */
+enum class UpdatePhase : size_t
+{
+    RequestUpdate,
+    PassComponentTable,
+    Transfer,
+    Verify,
+    Apply,
+    Activate,
+};
+
+/** @brief Number of UpdatePhase values */
+constexpr size_t updatePhaseCount = 6;
+
+/** @brief Timing and throughput of the update of a firmware device */
+struct UpdateMetrics
+{
+    /** @brief progress of the update, in percent */
+    uint8_t progress = 0;
+
+    /** @brief time spent in each UpdatePhase, UpdateComponent and the wait
+     *         for the first RequestFirmwareData count as Transfer
+     */
+    std::array<std::chrono::steady_clock::duration, updatePhaseCount>
+        phaseTimes{};
+
+    /** @brief component image bytes sent to the device */
+    uint64_t transferBytes = 0;
+
+    /** @brief time spent serving RequestFirmwareData */
+    std::chrono::steady_clock::duration transferTime{};
+
+    /** @brief RequestFirmwareData requests for data already sent */
+    size_t retransmittedRequests = 0;
+
+    /** @brief component image bytes requested again */
+    uint64_t retransmittedBytes = 0;
+
+    /** @brief number of times the update of the device was re-armed */
+    size_t transferRetries = 0;
+
+    /** @brief Get the throughput of the transfer of the component images
+     *
+     *  @return bytes sent per second spent serving RequestFirmwareData, 0 if
+     *          nothing was served yet
+     */
+    uint64_t bytesPerSecond() const
+    {
+        auto seconds = std::chrono::duration<double>(transferTime).count();
+        return seconds > 0 ? static_cast<uint64_t>(transferBytes / seconds)
+                           : 0;
+    }
+};
+
 /** @class UpdateProgress
  *
  *  Attempts to provide accurate reporting of firmware update progress
@@ -124,7 +203,7 @@ class DeviceUpdater
     /** @brief Constructor
      *
      *  @param[in] eid - Endpoint ID of the firmware device
-     *  @param[in] package - File stream for firmware update package
+     *  @param[in] package - Reader of the firmware update package
      *  @param[in] fwDeviceIDRecord - FirmwareDeviceIDRecord in the fw update
      *                                package that matches this firmware device
      *  @param[in] compImageInfos - Component image information for all the
@@ -136,7 +215,7 @@ class DeviceUpdater
      *  @param[in] updateManager - To update the status of fw update of the
      *                             device
      */
-    explicit DeviceUpdater(mctp_eid_t eid, std::istream& package,
+    explicit DeviceUpdater(mctp_eid_t eid, const PackageReader& package,
                            const FirmwareDeviceIDRecord& fwDeviceIDRecord,
                            const ComponentImageInfos& compImageInfos,
                            const ComponentInfo& compInfo,
@@ -145,13 +224,29 @@ class DeviceUpdater
 
     /** @brief Get the progress of updating this device as percentage
      *
-     * Goes through each component for this device and calculates
-     *   the percentage we are through the update process
+     * The progress of the components for this device weighted by their size,
+     *   maintained as the components progress
      *
      * @return The percentage as an int [0-100], 0 is no progress, 100 is done.
      */
     uint8_t getProgress() const;
 
+    /** @brief Get the timing and throughput of the update of this device
+     *
+     * @return the metrics of the update so far, the current phase counts up
+     *         to now
+     */
+    UpdateMetrics getMetrics() const;
+
+    /** @brief Get the size of the components applicable to this device
+     *
+     * @return the total size in bytes of the component images to transfer
+     */
+    uint64_t getTotalSize() const
+    {
+        return totalCompSize;
+    }
+
     /** @brief Start the firmware update flow for the FD
      *
      *  To start the update flow RequestUpdate command is sent to the FD.
@@ -256,6 +351,19 @@ class DeviceUpdater
     void cancelUpdateComponent(mctp_eid_t eid, const pldm_msg* response,
                                size_t respMsgLen);
 
+    /**
+     * @brief Handler for CancelUpdate command response
+     *
+     * The update of the device is restarted with RequestUpdate whatever the
+     * response, a device that reset is no longer in update mode.
+     *
+     * @param[in] eid - Remote MCTP endpoint
+     * @param[in] response - PLDM Response message
+     * @param[in] respMsgLen - Response message length
+     */
+    void cancelUpdate(mctp_eid_t eid, const pldm_msg* response,
+                      size_t respMsgLen);
+
   private:
     /** @brief Send PassComponentTable command request
      *
@@ -277,16 +385,57 @@ class DeviceUpdater
      */
     void sendCancelUpdateComponentRequest();
 
+    /**
+     * @brief Send cancel update request
+     */
+    void sendCancelUpdateRequest();
+
+    /**
+     * @brief Re-arm the update of the device after a failure in the transfer
+     *        of the current component, within the retry policy
+     *
+     * The current component is cancelled with CancelUpdateComponent and
+     * requested again with UpdateComponent. If the device does not accept
+     * the cancel, or if restartUpdate is set, the update is cancelled with
+     * CancelUpdate and restarted with RequestUpdate.
+     *
+     * @param[in] restartUpdate - restart the update of the device
+     *
+     * @return true if the update is re-armed, false if the retries are
+     *         exhausted
+     */
+    bool retryTransfer(bool restartUpdate);
+
+    /**
+     * @brief Account the time spent in the current phase of the update and
+     *        move on to the next one
+     *
+     * @param[in] phase - the next phase, std::nullopt when the update of the
+     *                    device is over
+     */
+    void enterPhase(std::optional<UpdatePhase> phase);
+
     /**
      * @brief Create a timer to handle RequestFirmwareData timeout (UA_T2)
      */
     void createRequestFwDataTimer();
 
+    /**
+     * @brief Update the progress of the component being updated and report
+     *        the progress of the device to the UpdateManager when its
+     *        percentage changes
+     *
+     * @param[in] update - applies the change to the component progress
+     */
+    void updateProgress(const std::function<void(UpdateProgress&)>& update);
+
     /** @brief Endpoint ID of the firmware device */
     mctp_eid_t eid;
 
-    /** @brief File stream for firmware update package */
-    std::istream& package;
+    /** @brief Reader of the firmware update package, shared by the devices
+     *         updated from the package
+     */
+    const PackageReader& package;
 
     /** @brief FirmwareDeviceIDRecord in the fw update package that matches this
      *         firmware device
@@ -344,6 +493,70 @@ class DeviceUpdater
      *         applicable to this device
      */
     std::vector<UpdateProgress> progress;
+
+    /**
+     * @brief the total size in bytes of the components applicable to this
+     *        device
+     */
+    uint64_t totalCompSize = 0;
+
+    /**
+     * @brief the sum of the progress of each component weighted by its size
+     */
+    uint64_t weightedProgress = 0;
+
+    /**
+     * @brief the ranges of each component served to the device, merged and
+     *        keyed by their start offset to their end offset, data requested
+     *        again does not count twice towards the progress
+     */
+    std::vector<std::map<uint32_t, uint32_t>> servedRanges;
+
+    /**
+     * @brief number of times the update of the device was re-armed
+     */
+    size_t transferRetries = 0;
+
+    /**
+     * @brief true while the current component is cancelled to be requested
+     *        again
+     */
+    bool rearmingComponent = false;
+
+    /**
+     * @brief the component image bytes sent to the device
+     */
+    uint64_t transferBytes = 0;
+
+    /**
+     * @brief the time spent transferring the components, from the first
+     *        RequestFirmwareData to TransferComplete of each component
+     */
+    std::chrono::steady_clock::duration transferTime{};
+
+    /**
+     * @brief time of the first RequestFirmwareData of the current component
+     */
+    std::optional<std::chrono::steady_clock::time_point> transferStart;
+
+    /**
+     * @brief number of RequestFirmwareData requests for data already sent,
+     *        and the bytes requested again
+     */
+    size_t retransmittedRequests = 0;
+    uint64_t retransmittedBytes = 0;
+
+    /**
+     * @brief time spent in each phase of the update
+     */
+    std::array<std::chrono::steady_clock::duration, updatePhaseCount>
+        phaseTimes{};
+
+    /**
+     * @brief the current phase of the update and the time it started
+     */
+    std::optional<UpdatePhase> currentPhase;
+    std::chrono::steady_clock::time_point phaseStart{};
     /**
      * @brief Whether this device has gone through application. Needed because
      *        UpdateProgress handles each component but application happens at
@@ -1,22 +1,113 @@
 #include "inventory_manager.hpp"
 
+#include "common/start_lifetime_as.hpp"
 #include "common/utils.hpp"
 
+#include <libpldm/edac.h>
 #include <libpldm/firmware_update.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
 {
 namespace fw_update
 {
+
+// Endpoints queried for their firmware inventory at the same time
+static constexpr size_t maxDiscoveries = FW_UPDATE_INVENTORY_CONCURRENCY;
+
+/** @brief Header of a cached inventory file */
+struct InventoryCacheHeader
+{
+    uint32_t version;
+    uint32_t identifiersCrc;
+    uint32_t dataSize;
+    uint32_t dataCrc;
+};
+
+// Version of the cached inventory file format
+static constexpr uint32_t inventoryCacheVersion = 1;
+
+// Maximum size of a cached GetFirmwareParameters response
+static constexpr uint32_t maxCachedResponseSize = 64 * 1024;
+
+/** @brief Check whether an endpoint UUID can key the cached inventory, an
+ *         endpoint without a UUID reports the all-zero UUID
+ *
+ *  @param[in] uuid - The endpoint UUID
+ *
+ *  @return true if the UUID is not null and is a valid file name
+ */
+static bool isCacheKey(const UUID& uuid)
+{
+    auto isUUIDChar = [](char c) {
+        return std::isxdigit(static_cast<unsigned char>(c)) || c == '-';
+    };
+    auto isNullChar = [](char c) { return c == '0' || c == '-'; };
+    return std::ranges::all_of(uuid, isUUIDChar) &&
+           !std::ranges::all_of(uuid, isNullChar);
+}
+
 void InventoryManager::discoverFDs(const MctpInfos& mctpInfos)
 {
+    if (outstandingRequests.empty() && pendingDiscoveries.empty())
+    {
+        discoveryStartTime = std::chrono::steady_clock::now();
+    }
+
     for (const auto& mctpInfo : mctpInfos)
     {
         auto eid = std::get<pldm::eid>(mctpInfo);
+        const auto& uuid = std::get<UUID>(mctpInfo);
+        if (!isCacheKey(uuid))
+        {
+            endpointUUIDs.erase(eid);
+        }
+        else
+        {
+            // A UUID shared by several endpoints does not identify an FD, the
+            // inventory cached under it may belong to either of them
+            for (const auto& [otherEid, otherUUID] : endpointUUIDs)
+            {
+                if (otherEid != eid && otherUUID == uuid)
+                {
+                    error(
+                        "Endpoint ID {EID} has the same UUID {UUID} as endpoint ID {OTHER_EID}, its inventory is not cached",
+                        "EID", eid, "UUID", uuid, "OTHER_EID", otherEid);
+                    invalidateInventory(otherEid);
+                    break;
+                }
+            }
+            endpointUUIDs.insert_or_assign(eid, uuid);
+        }
+
+        if (outstandingRequests.contains(eid) ||
+            std::ranges::find(pendingDiscoveries, eid) !=
+                pendingDiscoveries.end())
+        {
+            continue;
+        }
+        pendingDiscoveries.push_back(eid);
+    }
+
+    startDiscoveries();
+}
+
+void InventoryManager::startDiscoveries()
+{
+    while (!pendingDiscoveries.empty() &&
+           (!maxDiscoveries || outstandingRequests.size() < maxDiscoveries))
+    {
+        auto eid = pendingDiscoveries.front();
+        pendingDiscoveries.pop_front();
+        ++discoveredFDs;
+
         try
         {
             sendQueryDeviceIdentifiersRequest(eid);
@@ -28,6 +119,160 @@ void InventoryManager::discoverFDs(const MctpInfos& mctpInfos)
                 "EID", eid, "ERROR", e);
         }
     }
+
+    if (outstandingRequests.empty() && pendingDiscoveries.empty() &&
+        discoveredFDs)
+    {
+        auto dur = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - discoveryStartTime)
+                       .count();
+        info(
+            "Firmware inventory discovery time: {DURATION}ms for {COUNT} devices, {CACHED} from cache",
+            "DURATION", dur, "COUNT", discoveredFDs, "CACHED", cachedFDs);
+        discoveredFDs = 0;
+        cachedFDs = 0;
+    }
+}
+
+void InventoryManager::requestSent(mctp_eid_t eid)
+{
+    ++outstandingRequests[eid];
+}
+
+void InventoryManager::responseReceived(mctp_eid_t eid)
+{
+    auto search = outstandingRequests.find(eid);
+    if (search == outstandingRequests.end() || --search->second)
+    {
+        return;
+    }
+
+    outstandingRequests.erase(search);
+    startDiscoveries();
+}
+
+std::filesystem::path InventoryManager::cachePath(mctp_eid_t eid) const
+{
+    auto uuid = endpointUUIDs.find(eid);
+    if (cacheDir.empty() || uuid == endpointUUIDs.end())
+    {
+        return {};
+    }
+
+    // The UUID only identifies the FD when no other endpoint reports it
+    for (const auto& [otherEid, otherUUID] : endpointUUIDs)
+    {
+        if (otherEid != eid && otherUUID == uuid->second)
+        {
+            return {};
+        }
+    }
+
+    return cacheDir / uuid->second;
+}
+
+std::optional<Response> InventoryManager::loadCachedInventory(
+    mctp_eid_t eid, uint32_t identifiersCrc) const
+{
+    auto path = cachePath(eid);
+    if (path.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    InventoryCacheHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.version != inventoryCacheVersion ||
+        header.identifiersCrc != identifiersCrc)
+    {
+        return std::nullopt;
+    }
+
+    // The size is checked before it is allocated
+    if (header.dataSize <= sizeof(pldm_msg_hdr) ||
+        header.dataSize > maxCachedResponseSize)
+    {
+        error("Cached firmware inventory '{PATH}' has an invalid size {SIZE}",
+              "PATH", path, "SIZE", header.dataSize);
+        return std::nullopt;
+    }
+
+    Response firmwareParameters(header.dataSize);
+    if (!file.read(reinterpret_cast<char*>(firmwareParameters.data()),
+                   firmwareParameters.size()) ||
+        pldm_edac_crc32(firmwareParameters.data(), firmwareParameters.size()) !=
+            header.dataCrc)
+    {
+        error("Cached firmware inventory '{PATH}' is corrupted", "PATH", path);
+        return std::nullopt;
+    }
+
+    return firmwareParameters;
+}
+
+void InventoryManager::storeCachedInventory(
+    mctp_eid_t eid, uint32_t identifiersCrc, const pldm_msg* response,
+    size_t respMsgLen)
+{
+    auto path = cachePath(eid);
+    if (path.empty() ||
+        sizeof(pldm_msg_hdr) + respMsgLen > maxCachedResponseSize)
+    {
+        return;
+    }
+
+    auto responseData = reinterpret_cast<const uint8_t*>(response);
+    InventoryCacheHeader header{};
+    header.version = inventoryCacheVersion;
+    header.identifiersCrc = identifiersCrc;
+    header.dataSize = sizeof(pldm_msg_hdr) + respMsgLen;
+    header.dataCrc = pldm_edac_crc32(responseData, header.dataSize);
+
+    // A torn file fails the CRC check, the FD is then queried again
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    try
+    {
+        std::filesystem::create_directories(cacheDir);
+        std::ofstream file(tmpPath, std::ios::out | std::ios::binary |
+                                        std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(responseData),
+                   header.dataSize);
+        file.close();
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write " + tmpPath.string());
+        }
+        std::filesystem::rename(tmpPath, path);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to cache the firmware inventory of endpoint ID {EID}, error - {ERROR}",
+            "EID", eid, "ERROR", e);
+        std::error_code ec;
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+void InventoryManager::invalidateInventory(mctp_eid_t eid)
+{
+    pendingIdentifiers.erase(eid);
+    auto uuid = endpointUUIDs.find(eid);
+    if (cacheDir.empty() || uuid == endpointUUIDs.end())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(cacheDir / uuid->second, ec);
 }
 
 void InventoryManager::removeFDs(const MctpInfos& mctpInfos)
@@ -35,6 +280,9 @@ void InventoryManager::removeFDs(const MctpInfos& mctpInfos)
     for (const auto& mctpInfo : mctpInfos)
     {
         auto eid = std::get<pldm::eid>(mctpInfo);
+        std::erase(pendingDiscoveries, eid);
+        pendingIdentifiers.erase(eid);
+        endpointUUIDs.erase(eid);
         firmwareDeviceNameMap.erase(eid);
         descriptorMap.erase(eid);
         downstreamDescriptorMap.erase(eid);
@@ -71,6 +319,7 @@ void InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
         std::move(requestMsg),
         [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
             this->queryDeviceIdentifiers(eid, response, respMsgLen);
+            this->responseReceived(eid);
         });
     if (rc)
     {
@@ -80,6 +329,7 @@ void InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
         throw std::runtime_error(
             "Failed to send QueryDeviceIdentifiers request");
     }
+    requestSent(eid);
 }
 
 void InventoryManager::queryDeviceIdentifiers(
@@ -180,6 +430,20 @@ void InventoryManager::queryDeviceIdentifiers(
     obtainFirmwareDeviceName(eid, descriptors);
     descriptorMap.insert_or_assign(eid, std::move(descriptors));
 
+    // The cached GetFirmwareParameters response is only used when the FD
+    // reports the identifiers it was cached with
+    auto identifiersCrc = pldm_edac_crc32(response->payload, respMsgLen);
+    pendingIdentifiers.erase(eid);
+    if (auto firmwareParameters = loadCachedInventory(eid, identifiersCrc))
+    {
+        ++cachedFDs;
+        getFirmwareParameters(
+            eid, std::start_lifetime_as<pldm_msg>(firmwareParameters->data()),
+            firmwareParameters->size() - sizeof(pldm_msg_hdr));
+        return;
+    }
+    pendingIdentifiers.insert_or_assign(eid, identifiersCrc);
+
     // Send GetFirmwareParameters request
     sendGetFirmwareParametersRequest(eid);
 }
@@ -210,13 +474,16 @@ void InventoryManager::sendQueryDownstreamDevicesRequest(mctp_eid_t eid)
         std::move(requestMsg),
         [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
             this->queryDownstreamDevices(eid, response, respMsgLen);
+            this->responseReceived(eid);
         });
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamDevices request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        return;
     }
+    requestSent(eid);
 }
 
 void InventoryManager::queryDownstreamDevices(
@@ -329,13 +596,16 @@ void InventoryManager::sendQueryDownstreamIdentifiersRequest(
         std::move(requestMsg),
         [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
             this->queryDownstreamIdentifiers(eid, response, respMsgLen);
+            this->responseReceived(eid);
         });
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamIdentifiers request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        return;
     }
+    requestSent(eid);
 }
 
 void InventoryManager::queryDownstreamIdentifiers(
@@ -507,13 +777,16 @@ void InventoryManager::sendGetDownstreamFirmwareParametersRequest(
         std::move(requestMsg),
         [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
             this->getDownstreamFirmwareParameters(eid, response, respMsgLen);
+            this->responseReceived(eid);
         });
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamFirmwareParameters request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        return;
     }
+    requestSent(eid);
 }
 
 void InventoryManager::getDownstreamFirmwareParameters(
@@ -622,13 +895,16 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
         std::move(requestMsg),
         [this](mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen) {
             this->getFirmwareParameters(eid, response, respMsgLen);
+            this->responseReceived(eid);
         });
     if (rc)
     {
         error(
             "Failed to send get firmware parameters request for endpoint ID {EID}, response code {RC}",
             "EID", eid, "RC", rc);
+        return;
     }
+    requestSent(eid);
 }
 
 void InventoryManager::getFirmwareParameters(
@@ -675,6 +951,9 @@ void InventoryManager::getFirmwareParameters(
     variable_field pendingCompVerStr{};
 
     ComponentInfo componentInfo{};
+    // A pending version is activated by the next reset of the device, the
+    // inventory is not cached
+    bool pendingVersion = pendingCompImageSetVerStr.length > 0;
 
     const auto imageSetVersion = utils::toString(activeCompImageSetVerStr);
 
@@ -730,6 +1009,7 @@ void InventoryManager::getFirmwareParameters(
                 "EID", eid);
         }
 
+        pendingVersion = pendingVersion || pendingCompVerStr.length > 0;
         compParamPtr += sizeof(pldm_component_parameter_entry) +
                         activeCompVerStr.length + pendingCompVerStr.length;
         compParamTableLen -= sizeof(pldm_component_parameter_entry) +
@@ -737,6 +1017,20 @@ void InventoryManager::getFirmwareParameters(
     }
 
     componentInfoMap.insert_or_assign(eid, std::move(componentInfo));
+
+    auto identifiers = pendingIdentifiers.find(eid);
+    if (identifiers == pendingIdentifiers.end())
+    {
+        return;
+    }
+    auto identifiersCrc = identifiers->second;
+    if (pendingVersion)
+    {
+        invalidateInventory(eid);
+        return;
+    }
+    pendingIdentifiers.erase(identifiers);
+    storeCachedInventory(eid, identifiersCrc, response, respMsgLen);
 }
 
 std::optional<SoftwareName> obtainDeviceNameFromConfigurations(
@@ -6,6 +6,11 @@
 #include "firmware_inventory_manager.hpp"
 #include "requester/handler.hpp"
 
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <unordered_map>
+
 namespace pldm
 {
 
@@ -41,6 +46,8 @@ class InventoryManager
      *                                        by the BMC.
      *  @param[out] componentInfoMap - Populate the component info for the FDs
      *                                 managed by the BMC.
+     *  @param[in] cacheDir - Directory the inventory of the FDs is cached in,
+     *                        keyed by endpoint UUID, empty to not cache it
      */
     explicit InventoryManager(
         const pldm::utils::DBusHandler* dbusHandler,
@@ -49,28 +56,47 @@ class InventoryManager
         DownstreamDescriptorMap& downstreamDescriptorMap,
         ComponentInfoMap& componentInfoMap,
         const Configurations& configurations,
-        AggregateUpdateManager& updateManager) :
+        AggregateUpdateManager& updateManager,
+        std::filesystem::path cacheDir = {}) :
         handler(handler), instanceIdDb(instanceIdDb),
         descriptorMap(descriptorMap),
         downstreamDescriptorMap(downstreamDescriptorMap),
         componentInfoMap(componentInfoMap), configurations(configurations),
-        firmwareInventoryManager(dbusHandler, configurations, updateManager)
+        firmwareInventoryManager(dbusHandler, configurations, updateManager),
+        cacheDir(std::move(cacheDir))
     {}
 
     /** @brief Discover the firmware identifiers and component details of FDs
      *
      *  Inventory commands QueryDeviceIdentifiers and GetFirmwareParmeters
      *  commands are sent to every FD and the response is used to populate
-     *  the firmware identifiers and component details of the FDs.
+     *  the firmware identifiers and component details of the FDs. The FDs are
+     *  queried concurrently up to the configured limit. GetFirmwareParameters
+     *  is not sent to an FD reporting the identifiers its inventory was
+     *  cached with under its endpoint UUID, the cached response is used
+     *  instead. Null endpoint UUIDs and endpoint UUIDs shared by several
+     *  endpoints are not used as cache keys.
      *
      *  @param[in] mctpInfos - List of MCTP endpoint information
      */
     void discoverFDs(const MctpInfos& mctpInfos);
 
+    /** @brief Drop the cached inventory of an FD, the FD is queried on its
+     *         next discovery
+     *
+     *  Invoked when the firmware of the FD may have changed, for instance when
+     *  an update of the FD completes.
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    void invalidateInventory(mctp_eid_t eid);
+
     /** @brief Remove the firmware identifiers and component details of FDs
      *
      *  This function removes the firmware identifiers, component details and
-     *  downstream device identifiers of the FDs managed by the BMC.
+     *  downstream device identifiers of the FDs managed by the BMC. Their
+     *  cached inventory is kept, it is checked against the identifiers of
+     *  the FD when the FD comes back, for instance after a reset.
      *
      *  @param[in] mctpInfos - List of MCTP endpoint information
      */
@@ -185,6 +211,58 @@ class InventoryManager
      */
     void sendGetFirmwareParametersRequest(mctp_eid_t eid);
 
+    /** @brief Start the discovery of the queued FDs while there are free
+     *         slots
+     */
+    void startDiscoveries();
+
+    /** @brief Record an inventory request sent to an FD, the discovery of the
+     *         FD holds a slot until all its requests are answered
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    void requestSent(mctp_eid_t eid);
+
+    /** @brief Record the response to an inventory request of an FD, the slot
+     *         of the FD is freed when it has no request left
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    void responseReceived(mctp_eid_t eid);
+
+    /** @brief Get the path of the cached inventory of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return the path of the cached inventory, empty if the inventory is
+     *          not cached or the endpoint UUID of the FD is unknown, null or
+     *          not unique
+     */
+    std::filesystem::path cachePath(mctp_eid_t eid) const;
+
+    /** @brief Load the cached GetFirmwareParameters response of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *  @param[in] identifiersCrc - CRC-32 of the QueryDeviceIdentifiers
+     *                              response payload of the FD
+     *
+     *  @return the cached response, std::nullopt if none was cached for
+     *          these identifiers or it is corrupted
+     */
+    std::optional<Response> loadCachedInventory(mctp_eid_t eid,
+                                                uint32_t identifiersCrc) const;
+
+    /** @brief Cache the GetFirmwareParameters response of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *  @param[in] identifiersCrc - CRC-32 of the QueryDeviceIdentifiers
+     *                              response payload of the FD
+     *  @param[in] response - GetFirmwareParameters response message
+     *  @param[in] respMsgLen - Response message length
+     */
+    void storeCachedInventory(mctp_eid_t eid, uint32_t identifiersCrc,
+                              const pldm_msg* response, size_t respMsgLen);
+
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>& handler;
 
@@ -208,6 +286,36 @@ class InventoryManager
 
     /** @brief Dbus Inventory Item Manager */
     FirmwareInventoryManager firmwareInventoryManager;
+
+    /** @brief Directory the inventory of the FDs is cached in */
+    std::filesystem::path cacheDir;
+
+    /** @brief UUID of the discovered endpoints that can key the cached
+     *         inventory, null UUIDs excluded
+     */
+    std::unordered_map<mctp_eid_t, UUID> endpointUUIDs;
+
+    /** @brief CRC-32 of the QueryDeviceIdentifiers response payload of the
+     *         FDs awaiting a GetFirmwareParameters response to cache
+     */
+    std::unordered_map<mctp_eid_t, uint32_t> pendingIdentifiers;
+
+    /** @brief FDs waiting for a discovery slot */
+    std::deque<mctp_eid_t> pendingDiscoveries;
+
+    /** @brief Number of inventory requests awaiting a response, per FD holding
+     *         a discovery slot
+     */
+    std::unordered_map<mctp_eid_t, size_t> outstandingRequests;
+
+    /** @brief Start of the current discovery of FDs */
+    std::chrono::steady_clock::time_point discoveryStartTime;
+
+    /** @brief Number of FDs discovered since discoveryStartTime, and the
+     *         number of them populated from the cache
+     */
+    size_t discoveredFDs = 0;
+    size_t cachedFDs = 0;
 };
 
 /**
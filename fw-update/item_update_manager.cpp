@@ -41,8 +41,8 @@ bool ItemUpdateManager::processPackage()
         return false;
     }
 
-    auto buffer = std::vector<uint8_t>(packageMap->getBytes().begin(),
-                                       packageMap->getBytes().end());
+    std::ispanstream packageStream(packageMap->getChars(), std::ios::binary);
+    auto buffer = readPkgHeader(packageStream, packageMap->getSize());
     parser = parsePkgHeader(buffer);
     if (parser == nullptr)
     {
@@ -54,7 +54,7 @@ bool ItemUpdateManager::processPackage()
     }
     try
     {
-        parser->parse(buffer, buffer.size());
+        parser->parse(buffer, packageMap->getSize());
     }
     catch (const std::exception& e)
     {
@@ -77,23 +77,49 @@ bool ItemUpdateManager::processPackage()
         return false;
     }
 
+    // The Activation stays NotReady until the payload is verified
+    verifyPayload(*parser, packageMap->getBytes(),
+                  [this, deviceIdRecordOffset](bool valid) {
+                      payloadVerified(valid, *deviceIdRecordOffset);
+                  });
+
+    return true;
+}
+
+void ItemUpdateManager::payloadVerified(
+    bool valid, DeviceIDRecordOffset deviceIdRecordOffset)
+{
+    if (!valid)
+    {
+        error("Invalid PLDM fw update package payload");
+        inProgressActivation->activation(
+            software::Activation::Activations::Invalid);
+        parser.reset();
+        packageMap.reset();
+        dupFd.reset();
+        updateInProgress = false;
+        return;
+    }
+
     const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
     const auto& compImageInfos = parser->getComponentImageInfos();
-    static constexpr uint32_t MAXIMUM_TRANSFER_SIZE = 4096;
 
-    auto packageSpan = packageMap->getChars();
-    packageDataStream =
-        std::make_unique<std::ispanstream>(packageSpan, std::ios::binary);
+    packageReader = std::make_unique<PackageReader>(packageMap->getBytes());
     deviceUpdater = std::make_unique<DeviceUpdater>(
-        eid, *packageDataStream, fwDeviceIDRecords[*deviceIdRecordOffset],
-        compImageInfos, componentInfo, MAXIMUM_TRANSFER_SIZE, this);
+        eid, *packageReader, fwDeviceIDRecords[deviceIdRecordOffset],
+        compImageInfos, componentInfo, getMaxTransferSize(), this);
+    if (updateStateHandler)
+    {
+        updateStateHandler(true);
+    }
     inProgressActivation->activation(software::Activation::Activations::Ready);
     activationProgress = std::make_unique<ActivationProgress>(
         pldm::utils::DBusHandler::getBus(), objPathWithSwId);
+    deviceUpdateMetrics = std::make_unique<DeviceUpdateMetrics>(
+        pldm::utils::DBusHandler::getBus(), objPathWithSwId, eid);
+    lastProgress = 0;
     inProgressActivation->activation(
         software::Activation::Activations::Activating);
-
-    return true;
 }
 
 std::string ItemUpdateManager::processFd(int fd)
@@ -153,7 +179,7 @@ std::optional<DeviceIDRecordOffset> ItemUpdateManager::associatePkgToDevice(
 
 void ItemUpdateManager::updateDeviceCompletion(mctp_eid_t /*eid*/, bool status)
 {
-    activationProgress->progress(100);
+    activationProgress->reportProgress(100);
     packageMap.reset();
     dupFd.reset();
 
@@ -161,12 +187,38 @@ void ItemUpdateManager::updateDeviceCompletion(mctp_eid_t /*eid*/, bool status)
     auto dur =
         std::chrono::duration<double, std::milli>(endTime - startTime).count();
     info("Firmware update time: {DURATION}ms", "DURATION", dur);
+    if (deviceUpdater)
+    {
+        auto metrics = deviceUpdater->getMetrics();
+        if (deviceUpdateMetrics)
+        {
+            deviceUpdateMetrics->update(metrics);
+        }
+
+        pldm::utils::Json summary;
+        summary["Status"] = status ? "Active" : "Failed";
+        summary["ObjectPath"] = objPathWithSwId;
+        summary["DurationMs"] = dur;
+        summary["Progress"] = 100;
+        summary["Devices"] = pldm::utils::Json::array(
+            {getDeviceUpdateSummary(eid, metrics,
+                                    status ? "Succeeded" : "Failed")});
+        writeUpdateSummary(
+            summaryDir,
+            std::filesystem::path(objPathWithSwId).filename().native(),
+            summary);
+    }
+    activationProgress->reportCompletion(status);
     activationProgress.reset();
     inProgressActivation->activation(
         status ? software::Activation::Activations::Active
                : software::Activation::Activations::Failed);
     deviceUpdater.reset();
-    packageDataStream.reset();
+    if (updateStateHandler)
+    {
+        updateStateHandler(false);
+    }
+    packageReader.reset();
     packageMap.reset();
     dupFd.reset();
     updateInProgress = false;
@@ -220,27 +272,39 @@ Response ItemUpdateManager::handleRequest(mctp_eid_t /*eid*/, uint8_t command,
 void ItemUpdateManager::activatePackage()
 {
     startTime = std::chrono::steady_clock::now();
+    activationProgress->reportStart();
     deviceUpdater->startFwUpdateFlow();
 }
 
 void ItemUpdateManager::resetActivationState()
 {
+    cancelPayloadVerification();
     inProgressActivation.reset();
     activationProgress.reset();
+    deviceUpdateMetrics.reset();
+    deviceUpdater.reset();
+    if (updateStateHandler)
+    {
+        updateStateHandler(false);
+    }
+    packageReader.reset();
+    parser.reset();
+    packageMap.reset();
     dupFd.reset();
     updateInProgress = false;
 }
 
-void ItemUpdateManager::updateActivationProgress()
+void ItemUpdateManager::updateActivationProgress(
+    mctp_eid_t /*eid*/, uint8_t /*previousProgress*/, uint8_t progress)
 {
-    if (deviceUpdater)
+    if (activationProgress && progress != lastProgress)
     {
-        auto progress = deviceUpdater->getProgress();
-        if (progress != lastProgress)
-        {
-            activationProgress->progress(progress);
-            lastProgress = progress;
-        }
+        activationProgress->reportProgress(progress);
+        lastProgress = progress;
+    }
+    if (deviceUpdater && deviceUpdateMetrics)
+    {
+        deviceUpdateMetrics->update(deviceUpdater->getMetrics());
     }
 }
 
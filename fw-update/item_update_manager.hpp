@@ -5,8 +5,8 @@
 #include <xyz/openbmc_project/Software/ApplyTime/server.hpp>
 #include <xyz/openbmc_project/Software/Update/server.hpp>
 
+#include <functional>
 #include <span>
-#include <spanstream>
 
 namespace pldm::fw_update
 {
@@ -18,6 +18,12 @@ using ItemUpdateIntf = sdbusplus::server::object_t<
 using ApplyTimeIntf =
     sdbusplus::xyz::openbmc_project::Software::server::ApplyTime;
 
+/** @brief Callback invoked with true when the device starts exchanging
+ *         firmware update commands with an ItemUpdateManager, and with false
+ *         when the update is complete
+ */
+using UpdateStateHandler = std::function<void(bool active)>;
+
 class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
 {
   public:
@@ -39,18 +45,26 @@ class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
      * @param[in] generatedId The software hash identifier
      * @param[in] descriptors The descriptors for the device
      * @param[in] componentInfo The component information for the device
+     * @param[in] updateStateHandler Invoked when an update of the device
+     *                               starts and completes
+     * @param[in] summaryDir Directory the summary of each update is written
+     *                       to, empty to not write it
      */
     explicit ItemUpdateManager(
         mctp_eid_t eid, Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, const std::string& objPath,
         const std::string& generatedId, const Descriptors& descriptors,
-        const ComponentInfo& componentInfo) :
+        const ComponentInfo& componentInfo,
+        UpdateStateHandler updateStateHandler = {},
+        std::filesystem::path summaryDir = {}) :
         UpdateManagerBase(event, handler, instanceIdDb),
         ItemUpdateIntf(pldm::utils::DBusHandler::getBus(),
                        std::format("{}_{}", objPath, generatedId).c_str()),
         eid(eid), objPath(objPath), descriptors(descriptors),
-        componentInfo(componentInfo)
+        componentInfo(componentInfo),
+        updateStateHandler(std::move(updateStateHandler)),
+        summaryDir(std::move(summaryDir))
     {}
 
     /**
@@ -77,7 +91,17 @@ class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
     /**
      * @brief Update the activation progress status
      */
-    void updateActivationProgress() override;
+    void updateActivationProgress(mctp_eid_t eid, uint8_t previousProgress,
+                                  uint8_t progress) override;
+
+    /**
+     * @brief Report the end of the component image transfers, a single
+     * device has no transfer to schedule
+     */
+    void updateTransferCompletion(
+        mctp_eid_t /*eid*/, uint64_t /*transferBytes*/,
+        std::chrono::steady_clock::duration /*transferTime*/) override
+    {}
 
     /**
      * @brief Activate the firmware update package
@@ -133,23 +157,43 @@ class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
      */
     const ComponentInfo& componentInfo;
 
+    /**
+     * @brief Invoked when an update of the device starts and completes
+     */
+    UpdateStateHandler updateStateHandler;
+
+    /**
+     * @brief Directory the summary of each update is written to
+     */
+    std::filesystem::path summaryDir;
+
     /**
      * @brief The package data for the firmware update
      */
     std::unique_ptr<pldm::utils::MMapHandler> packageMap;
 
     /**
-     * @brief The package data stream for the firmware update
+     * @brief The package reader for the firmware update
      */
-    std::unique_ptr<std::ispanstream> packageDataStream;
+    std::unique_ptr<PackageReader> packageReader;
 
     /**
-     * @brief Process the firmware update package
+     * @brief Process the firmware update package, the update starts once the
+     * package payload is verified
      *
      * @return true on success, false on failure
      */
     bool processPackage();
 
+    /**
+     * @brief Create the DeviceUpdater and start the update once the package
+     * payload is verified, or mark the Activation Invalid
+     *
+     * @param[in] valid - Whether the payload matches its checksum
+     * @param[in] deviceIdRecordOffset - The device ID record of the device
+     */
+    void payloadVerified(bool valid, DeviceIDRecordOffset deviceIdRecordOffset);
+
     /**
      * @brief Send the defer request of the firmware update package
      *
@@ -160,6 +204,10 @@ class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
 
     std::unique_ptr<Activation> inProgressActivation;
     std::unique_ptr<ActivationProgress> activationProgress;
+
+    /** @brief D-Bus object with the metrics of the device update */
+    std::unique_ptr<DeviceUpdateMetrics> deviceUpdateMetrics;
+
     std::unique_ptr<PackageParser> parser;
     std::unique_ptr<DeviceUpdater> deviceUpdater;
     decltype(std::chrono::steady_clock::now()) startTime;
@@ -180,7 +228,7 @@ class ItemUpdateManager : public UpdateManagerBase, public ItemUpdateIntf
      * dbus
      *
      */
-    uint8_t lastProgress;
+    uint8_t lastProgress = 0;
 };
 
 } // namespace pldm::fw_update
@@ -44,10 +44,14 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
                      requester::Handler<requester::Request>& handler,
                      pldm::InstanceIdDb& instanceIdDb) :
         updateManager(event, handler, instanceIdDb, descriptorMap,
-                      componentInfoMap),
+                      componentInfoMap,
+                      [this](mctp_eid_t eid) {
+                          inventoryMgr.invalidateInventory(eid);
+                      },
+                      FW_UPDATE_SUMMARY_DIR),
         inventoryMgr(dbusHandler, handler, instanceIdDb, descriptorMap,
                      downstreamDescriptorMap, componentInfoMap, configurations,
-                     updateManager)
+                     updateManager, FW_UPDATE_INVENTORY_CACHE_DIR)
     {}
 
     /** @brief Helper function to invoke registered handlers for
@@ -57,6 +61,7 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
      */
     void handleMctpEndpoints(const MctpInfos& mctpInfos) override
     {
+        updateManager.addEndpoints(mctpInfos);
         inventoryMgr.discoverFDs(mctpInfos);
     }
 
@@ -78,6 +83,7 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
     void handleRemovedMctpEndpoints(const MctpInfos& mctpInfos) override
     {
         inventoryMgr.removeFDs(mctpInfos);
+        updateManager.removeEndpoints(mctpInfos);
     }
 
     /** @brief Helper function to invoke registered handlers for
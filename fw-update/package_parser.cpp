@@ -8,6 +8,8 @@
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 
 PHOSPHOR_LOG2_USING;
@@ -187,6 +189,39 @@ size_t PackageParser::parseCompImageInfoArea(ComponentImageCount compImageCount,
     return offset;
 }
 
+size_t PackageParser::skipDownstreamDeviceIDArea(
+    const std::vector<uint8_t>& pkgHdr, size_t offset)
+{
+    auto recordCount =
+        static_cast<DownstreamDeviceIDRecordCount>(pkgHdr[offset]);
+    offset += sizeof(DownstreamDeviceIDRecordCount);
+
+    // Every record starts with its RecordLength
+    while (recordCount--)
+    {
+        if (offset + sizeof(uint16_t) > pkgHeaderSize)
+        {
+            error(
+                "Failed to find the downstream device ID record at offset '{OFFSET}'",
+                "OFFSET", offset);
+            throw InternalFailure();
+        }
+
+        size_t recordLength = pkgHdr[offset] | (pkgHdr[offset + 1] << 8);
+        if (recordLength < sizeof(uint16_t) ||
+            offset + recordLength > pkgHeaderSize)
+        {
+            error(
+                "Invalid downstream device ID record length '{LENGTH}' at offset '{OFFSET}'",
+                "LENGTH", recordLength, "OFFSET", offset);
+            throw InternalFailure();
+        }
+        offset += recordLength;
+    }
+
+    return offset;
+}
+
 void PackageParser::validatePkgTotalSize(uintmax_t pkgSize)
 {
     uintmax_t calcPkgSize = pkgHeaderSize;
@@ -223,7 +258,7 @@ void PackageParser::validatePkgTotalSize(uintmax_t pkgSize)
 
 void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
 {
-    if (pkgHeaderSize >= pkgHdr.size())
+    if (pkgHeaderSize > pkgHdr.size())
     {
         error("Invalid package header size '{PKG_HDR_SIZE}' ", "PKG_HDR_SIZE",
               pkgHeaderSize);
@@ -248,6 +283,18 @@ void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
               "DREC_CNT", deviceIdRecCount);
         throw InternalFailure();
     }
+
+    if (pkgHeaderFormatRevision >= pkgHeaderFormatRevision2)
+    {
+        if (offset + sizeof(DownstreamDeviceIDRecordCount) >= pkgHeaderSize)
+        {
+            error("Failed to parse package header of size '{PKG_HDR_SIZE}'",
+                  "PKG_HDR_SIZE", pkgHeaderSize);
+            throw InternalFailure();
+        }
+        offset = skipDownstreamDeviceIDArea(pkgHdr, offset);
+    }
+
     if (offset + sizeof(ComponentImageCount) >= pkgHeaderSize)
     {
         error("Failed to parsing package header of size '{PKG_HDR_SIZE}'",
@@ -256,7 +303,7 @@ void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
     }
 
     auto compImageCount = static_cast<ComponentImageCount>(
-        le16toh(pkgHdr[offset] | (pkgHdr[offset + 1] << 8)));
+        pkgHdr[offset] | (pkgHdr[offset + 1] << 8));
     offset += sizeof(ComponentImageCount);
 
     offset = parseCompImageInfoArea(compImageCount, pkgHdr, offset);
@@ -267,7 +314,13 @@ void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
         throw InternalFailure();
     }
 
-    if (offset + sizeof(PackageHeaderChecksum) != pkgHeaderSize)
+    size_t checksumsSize = sizeof(PackageHeaderChecksum);
+    if (pkgHeaderFormatRevision >= pkgHeaderFormatRevision2)
+    {
+        checksumsSize += sizeof(PackagePayloadChecksum);
+    }
+
+    if (offset + checksumsSize != pkgHeaderSize)
     {
         error("Failed to parse package header of size '{PKG_HDR_SIZE}'",
               "PKG_HDR_SIZE", pkgHeaderSize);
@@ -276,8 +329,8 @@ void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
 
     auto calcChecksum = pldm_edac_crc32(pkgHdr.data(), offset);
     auto checksum = static_cast<PackageHeaderChecksum>(
-        le32toh(pkgHdr[offset] | (pkgHdr[offset + 1] << 8) |
-                (pkgHdr[offset + 2] << 16) | (pkgHdr[offset + 3] << 24)));
+        pkgHdr[offset] | (pkgHdr[offset + 1] << 8) |
+        (pkgHdr[offset + 2] << 16) | (pkgHdr[offset + 3] << 24));
     if (calcChecksum != checksum)
     {
         error(
@@ -287,15 +340,152 @@ void PackageParser::parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize)
         throw InternalFailure();
     }
 
+    if (pkgHeaderFormatRevision >= pkgHeaderFormatRevision2)
+    {
+        offset += sizeof(PackageHeaderChecksum);
+        pkgPayloadChecksum = static_cast<PackagePayloadChecksum>(
+            pkgHdr[offset] | (pkgHdr[offset + 1] << 8) |
+            (pkgHdr[offset + 2] << 16) | (pkgHdr[offset + 3] << 24));
+    }
+
     validatePkgTotalSize(pkgSize);
 }
 
+bool PackageParser::verifyPayload(std::span<const uint8_t> package) const
+{
+    PayloadVerifier verifier(*this, package);
+    while (!verifier.verifyChunk())
+    {}
+    return verifier.isValid();
+}
+
+PayloadVerifier::PayloadVerifier(const PackageParser& parser,
+                                 std::span<const uint8_t> package,
+                                 size_t chunkSize) :
+    checksum(parser.getPkgPayloadChecksum()),
+    chunkSize(std::max(chunkSize, sizeof(uint32_t)))
+{
+    if (!checksum)
+    {
+        done = true;
+        valid = true;
+        return;
+    }
+
+    if (package.size() < parser.pkgHeaderSize)
+    {
+        error(
+            "PLDM fw update package length {SIZE} less than the package header size '{PKG_HDR_SIZE}'",
+            "SIZE", package.size(), "PKG_HDR_SIZE", parser.pkgHeaderSize);
+        done = true;
+        return;
+    }
+
+    remaining = package.subspan(parser.pkgHeaderSize);
+}
+
+bool PayloadVerifier::verifyChunk()
+{
+    if (done)
+    {
+        return true;
+    }
+
+    // pldm_edac_crc32() always starts from the initial CRC register, the CRC
+    // of the payload checked so far is carried into the chunk by XORing it
+    // into the first bytes of a copy of the chunk. Only the first chunk may
+    // be shorter than the CRC, the tail of the payload is checked along with
+    // the chunk before it.
+    auto size = std::min(chunkSize, remaining.size());
+    if (remaining.size() - size < sizeof(crc))
+    {
+        size = remaining.size();
+    }
+    auto chunk = remaining.first(size);
+    if (!chunk.empty())
+    {
+        buffer.assign(chunk.begin(), chunk.end());
+        for (size_t i = 0; i < std::min(buffer.size(), sizeof(crc)); ++i)
+        {
+            buffer[i] ^= static_cast<uint8_t>(crc >> (8 * i));
+        }
+        crc = pldm_edac_crc32(buffer.data(), buffer.size());
+    }
+    remaining = remaining.subspan(chunk.size());
+    if (!remaining.empty())
+    {
+        return false;
+    }
+
+    done = true;
+    buffer = {};
+    auto calcChecksum = crc;
+    valid = calcChecksum == *checksum;
+    if (!valid)
+    {
+        error(
+            "Failed to verify package payload for calculated checksum '{CALCULATED_CHECKSUM}' and payload checksum '{PACKAGE_PAYLOAD_CHECKSUM}'",
+            "CALCULATED_CHECKSUM", calcChecksum, "PACKAGE_PAYLOAD_CHECKSUM",
+            *checksum);
+    }
+
+    return true;
+}
+
+std::vector<uint8_t> readPkgHeader(std::istream& package, uintmax_t pkgSize)
+{
+    std::vector<uint8_t> pkgHdr(sizeof(pldm_package_header_information));
+    if (pkgSize < pkgHdr.size())
+    {
+        error(
+            "PLDM fw update package length {SIZE} less than the length of the package header information '{PACKAGE_HEADER_INFO_SIZE}'.",
+            "SIZE", pkgSize, "PACKAGE_HEADER_INFO_SIZE", pkgHdr.size());
+        return {};
+    }
+
+    package.seekg(0);
+    package.read(reinterpret_cast<char*>(pkgHdr.data()), pkgHdr.size());
+    if (!package)
+    {
+        error("Failed to read the PLDM package header information");
+        return {};
+    }
+
+    // PackageHeaderSize follows the header identifier and format revision
+    constexpr size_t pkgHdrSizeOffset = PLDM_FWUP_UUID_LENGTH + 1;
+    size_t pkgHdrSize =
+        pkgHdr[pkgHdrSizeOffset] | (pkgHdr[pkgHdrSizeOffset + 1] << 8);
+    if (pkgHdrSize < pkgHdr.size() + sizeof(PackageHeaderChecksum) ||
+        pkgHdrSize > pkgSize)
+    {
+        error(
+            "Invalid package header size '{PKG_HDR_SIZE}' for package size '{PKG_SIZE}'",
+            "PKG_HDR_SIZE", pkgHdrSize, "PKG_SIZE", pkgSize);
+        return {};
+    }
+
+    auto pkgHdrInfoSize = pkgHdr.size();
+    pkgHdr.resize(pkgHdrSize);
+    package.read(reinterpret_cast<char*>(pkgHdr.data() + pkgHdrInfoSize),
+                 pkgHdrSize - pkgHdrInfoSize);
+    if (!package)
+    {
+        error("Failed to read package header of size '{PKG_HDR_SIZE}'",
+              "PKG_HDR_SIZE", pkgHdrSize);
+        return {};
+    }
+
+    return pkgHdr;
+}
+
 std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgData)
 {
     constexpr std::array<uint8_t, PLDM_FWUP_UUID_LENGTH> hdrIdentifierv1{
         0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43,
         0x98, 0x00, 0xA0, 0x2F, 0x05, 0x9A, 0xCA, 0x02};
-    constexpr uint8_t pkgHdrVersion1 = 0x01;
+    constexpr std::array<uint8_t, PLDM_FWUP_UUID_LENGTH> hdrIdentifierv2{
+        0x12, 0x44, 0xD2, 0x64, 0x8D, 0x7D, 0x47, 0x18,
+        0xA0, 0x30, 0xFC, 0x8A, 0x56, 0x58, 0x7D, 0x5A};
 
     pldm_package_header_information pkgHeader{};
     variable_field pkgVersion{};
@@ -309,15 +499,23 @@ std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgData)
         return nullptr;
     }
 
-    if (std::equal(pkgHeader.uuid, pkgHeader.uuid + PLDM_FWUP_UUID_LENGTH,
-                   hdrIdentifierv1.begin(), hdrIdentifierv1.end()) &&
-        (pkgHeader.package_header_format_version == pkgHdrVersion1))
+    auto isIdentifier = [&pkgHeader](const auto& identifier) {
+        return std::equal(pkgHeader.uuid,
+                          pkgHeader.uuid + PLDM_FWUP_UUID_LENGTH,
+                          identifier.begin(), identifier.end());
+    };
+    auto formatRevision = pkgHeader.package_header_format_version;
+    if ((isIdentifier(hdrIdentifierv1) &&
+         formatRevision == pkgHeaderFormatRevision1) ||
+        (isIdentifier(hdrIdentifierv2) &&
+         formatRevision == pkgHeaderFormatRevision2))
     {
         PackageHeaderSize pkgHdrSize = pkgHeader.package_header_size;
         ComponentBitmapBitLength componentBitmapBitLength =
             pkgHeader.component_bitmap_bit_length;
         return std::make_unique<PackageParser>(
-            pkgHdrSize, utils::toString(pkgVersion), componentBitmapBitLength);
+            pkgHdrSize, utils::toString(pkgVersion), componentBitmapBitLength,
+            formatRevision);
     }
 
     return nullptr;
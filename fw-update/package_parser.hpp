@@ -5,7 +5,10 @@
 #include <libpldm/firmware_update.h>
 
 #include <cstdint>
+#include <istream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace pldm
@@ -14,6 +17,15 @@ namespace pldm
 namespace fw_update
 {
 
+/** @brief PackageHeaderFormatRevision of DSP0267 1.0.x packages */
+constexpr PackageHeaderFormatRevision pkgHeaderFormatRevision1 = 0x01;
+
+/** @brief PackageHeaderFormatRevision of DSP0267 1.1.x packages, which add
+ *         the downstream device identification area and the package payload
+ *         checksum
+ */
+constexpr PackageHeaderFormatRevision pkgHeaderFormatRevision2 = 0x02;
+
 /** @class PackageParser
  *
  *  PackageParser is the class for parsing the PLDM firmware update package.
@@ -36,11 +48,15 @@ class PackageParser
      *                                        represent the bitmap in the
      *                                        ApplicableComponents field for a
      *                                        matching device.
+     *  @param[in] pkgHeaderFormatRevision - Package header format revision
      */
     explicit PackageParser(PackageHeaderSize pkgHeaderSize,
                            const PackageVersion& pkgVersion,
-                           ComponentBitmapBitLength componentBitmapBitLength) :
+                           ComponentBitmapBitLength componentBitmapBitLength,
+                           PackageHeaderFormatRevision pkgHeaderFormatRevision =
+                               pkgHeaderFormatRevision1) :
         pkgHeaderSize(pkgHeaderSize), pkgVersion(pkgVersion),
+        pkgHeaderFormatRevision(pkgHeaderFormatRevision),
         componentBitmapBitLength(componentBitmapBitLength)
     {}
 
@@ -73,12 +89,36 @@ class PackageParser
         return componentImageInfos;
     }
 
+    /** @brief Get the package payload checksum from the package header
+     *
+     *  @return the checksum of the component images, std::nullopt if the
+     *          package header format has none
+     */
+    std::optional<PackagePayloadChecksum> getPkgPayloadChecksum() const
+    {
+        return pkgPayloadChecksum;
+    }
+
+    /** @brief Verify the component images against the package payload
+     *         checksum in one pass, PayloadVerifier checks it in chunks
+     *
+     *  Packages without a payload checksum pass.
+     *
+     *  @param[in] package - the whole firmware update package
+     *
+     *  @return true if the payload matches the checksum or there is none
+     */
+    bool verifyPayload(std::span<const uint8_t> package) const;
+
     /** @brief Device identifiers of the managed FDs */
     const PackageHeaderSize pkgHeaderSize;
 
     /** @brief Package version string */
     const PackageVersion pkgVersion;
 
+    /** @brief Package header format revision */
+    const PackageHeaderFormatRevision pkgHeaderFormatRevision;
+
   protected:
     /** @brief Parse the firmware device identification area
      *
@@ -108,6 +148,22 @@ class PackageParser
                                   const std::vector<uint8_t>& pkgHdr,
                                   size_t offset);
 
+    /** @brief Skip the downstream device identification area
+     *
+     *  The downstream devices are not updated by the BMC, only the size of
+     *  their records is checked.
+     *
+     *  @param[in] pkgHdr - firmware package header
+     *  @param[in] offset - offset in package header which is the start of the
+     *                      downstream device identification area
+     *
+     *  @return On success return the offset which is the end of the
+     *          downstream device identification area, on error throw
+     *          exception.
+     */
+    size_t skipDownstreamDeviceIDArea(const std::vector<uint8_t>& pkgHdr,
+                                      size_t offset);
+
     /** @brief Validate the total size of the package
      *
      *  Verify the total size of the package is the sum of package header and
@@ -125,6 +181,9 @@ class PackageParser
     /** @brief Component Image Information in the package */
     ComponentImageInfos componentImageInfos;
 
+    /** @brief Checksum of the component images, if the header has one */
+    std::optional<PackagePayloadChecksum> pkgPayloadChecksum;
+
     /** @brief The number of bits that will be used to represent the bitmap in
      *         the ApplicableComponents field for matching device. The value
      *         shall be a multiple of 8 and be large enough to contain a bit
@@ -133,6 +192,88 @@ class PackageParser
     const ComponentBitmapBitLength componentBitmapBitLength;
 };
 
+/** @class PayloadVerifier
+ *
+ *  @brief Verifies the component images against the package payload checksum
+ *         a bounded chunk at a time, so that the event loop keeps running
+ *         between the chunks of a large package.
+ */
+class PayloadVerifier
+{
+  public:
+    PayloadVerifier() = delete;
+    PayloadVerifier(const PayloadVerifier&) = delete;
+    PayloadVerifier(PayloadVerifier&&) = delete;
+    PayloadVerifier& operator=(const PayloadVerifier&) = delete;
+    PayloadVerifier& operator=(PayloadVerifier&&) = delete;
+
+    /** @brief Default number of payload bytes checked per chunk */
+    static constexpr size_t defaultChunkSize = 1024 * 1024;
+
+    /** @brief Constructor
+     *
+     *  @param[in] parser - parser of the package header
+     *  @param[in] package - the whole firmware update package, must outlive
+     *                       the verifier
+     *  @param[in] chunkSize - number of payload bytes checked per chunk, at
+     *                         least the size of the CRC-32
+     */
+    PayloadVerifier(const PackageParser& parser,
+                    std::span<const uint8_t> package,
+                    size_t chunkSize = defaultChunkSize);
+
+    /** @brief Check the next chunk of the payload
+     *
+     *  @return true once the whole payload is checked
+     */
+    bool verifyChunk();
+
+    /** @brief Outcome of the verification, once verifyChunk() returned true
+     *
+     *  @return true if the payload matches the checksum or there is none
+     */
+    bool isValid() const
+    {
+        return valid;
+    }
+
+  private:
+    /** @brief Expected checksum of the payload */
+    std::optional<PackagePayloadChecksum> checksum;
+
+    /** @brief Part of the payload not checked yet */
+    std::span<const uint8_t> remaining;
+
+    /** @brief Number of payload bytes checked per chunk */
+    const size_t chunkSize;
+
+    /** @brief CRC-32 of the payload checked so far */
+    uint32_t crc = 0;
+
+    /** @brief Copy of the chunk being checked, see verifyChunk() */
+    std::vector<uint8_t> buffer;
+
+    /** @brief Whether the whole payload is checked */
+    bool done = false;
+
+    /** @brief Outcome of the verification */
+    bool valid = false;
+};
+
+/** @brief Read the package header of a firmware update package
+ *
+ *  Reads the package header information first and then only the remaining
+ *  bytes of the declared package header, so the component images are never
+ *  read into memory.
+ *
+ *  @param[in] package - stream of the firmware update package
+ *  @param[in] pkgSize - size of the firmware update package
+ *
+ *  @return On success return the package header, on failure return an empty
+ *          vector
+ */
+std::vector<uint8_t> readPkgHeader(std::istream& package, uintmax_t pkgSize);
+
 /** @brief Parse the package header information
  *
  *  @param[in] pkgHdrInfo - package header information section in the package
@@ -0,0 +1,69 @@
+#include "package_reader.hpp"
+
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+PackageReader::PackageReader(const std::filesystem::path& path) :
+    packageMap(std::make_unique<utils::MMapHandler>(path)),
+    data(packageMap->getBytes())
+{}
+
+PackageReader::PackageReader(int fd)
+{
+    try
+    {
+        packageMap = std::make_unique<utils::MMapHandler>(fd);
+        data = packageMap->getBytes();
+        return;
+    }
+    catch (const std::exception& e)
+    {
+        info("Reading the package as it cannot be mapped, error - {ERROR}",
+             "ERROR", e);
+    }
+
+    std::array<uint8_t, 4096> chunk{};
+    ssize_t bytesRead = 0;
+    while ((bytesRead = ::read(fd, chunk.data(), chunk.size())) > 0)
+    {
+        buffer.insert(buffer.end(), chunk.begin(), chunk.begin() + bytesRead);
+    }
+
+    if (bytesRead < 0)
+    {
+        throw std::system_error(errno, std::system_category(),
+                                "Failed to read the package");
+    }
+
+    data = buffer;
+}
+
+std::span<const uint8_t> PackageReader::read(uintmax_t offset,
+                                             size_t length) const
+{
+    if (offset >= data.size())
+    {
+        return {};
+    }
+
+    return data.subspan(offset, std::min<uintmax_t>(length,
+                                                    data.size() - offset));
+}
+
+} // namespace fw_update
+
+} // namespace pldm
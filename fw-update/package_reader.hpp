@@ -0,0 +1,99 @@
+#pragma once
+
+#include "common/utils.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class PackageReader
+ *
+ *  Read-only view of a firmware update package. The package is memory mapped
+ *  when possible and reads do not move any shared position, so a single
+ *  PackageReader can serve the RequestFirmwareData commands of every device
+ *  updated from the package.
+ */
+class PackageReader
+{
+  public:
+    PackageReader() = delete;
+    PackageReader(const PackageReader&) = delete;
+    PackageReader(PackageReader&&) = delete;
+    PackageReader& operator=(const PackageReader&) = delete;
+    PackageReader& operator=(PackageReader&&) = delete;
+    ~PackageReader() = default;
+
+    /** @brief Constructor to map a package file
+     *
+     *  @param[in] path - path of the firmware update package
+     *
+     *  @note Throws exception if the file cannot be mapped
+     */
+    explicit PackageReader(const std::filesystem::path& path);
+
+    /** @brief Constructor to map the package behind a file descriptor
+     *
+     *  Descriptors that cannot be mapped, like pipes, are read into memory.
+     *  The descriptor is not owned and can be closed once constructed.
+     *
+     *  @param[in] fd - file descriptor of the firmware update package
+     *
+     *  @note Throws exception if the descriptor cannot be read
+     */
+    explicit PackageReader(int fd);
+
+    /** @brief Constructor for a package already in memory
+     *
+     *  @param[in] data - package data, must outlive the PackageReader
+     */
+    explicit PackageReader(std::span<const uint8_t> data) : data(data) {}
+
+    /** @brief Get the size of the package
+     *
+     *  @return size of the package in bytes
+     */
+    uintmax_t size() const
+    {
+        return data.size();
+    }
+
+    /** @brief Get the package data
+     *
+     *  @return the whole package
+     */
+    std::span<const uint8_t> getData() const
+    {
+        return data;
+    }
+
+    /** @brief Get a range of the package
+     *
+     *  @param[in] offset - offset in the package
+     *  @param[in] length - number of bytes to read
+     *
+     *  @return the requested bytes, truncated at the end of the package
+     */
+    std::span<const uint8_t> read(uintmax_t offset, size_t length) const;
+
+  private:
+    /** @brief Mapping of the package, if mapped */
+    std::unique_ptr<utils::MMapHandler> packageMap;
+
+    /** @brief Copy of a package that could not be mapped */
+    std::vector<uint8_t> buffer;
+
+    /** @brief Package data */
+    std::span<const uint8_t> data;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
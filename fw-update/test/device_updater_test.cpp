@@ -1,9 +1,18 @@
 #include "fw-update/device_updater.hpp"
 #include "fw-update/package_parser.hpp"
+#include "fw-update/update_manager.hpp"
+#include "test/test_instance_id.hpp"
 
 #include <libpldm/firmware_update.h>
 
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <sstream>
+#include <string>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -15,7 +24,7 @@ class DeviceUpdaterTest : public testing::Test
 {
   protected:
     DeviceUpdaterTest() :
-        package("./test_pkg", std::ios::binary | std::ios::in | std::ios::ate)
+        package(std::filesystem::path("./test_pkg"))
     {
         fwDeviceIDRecord = {
             1,
@@ -32,7 +41,7 @@ class DeviceUpdaterTest : public testing::Test
     }
 
     int fd = -1;
-    std::ifstream package;
+    PackageReader package;
     FirmwareDeviceIDRecord fwDeviceIDRecord;
     ComponentImageInfos compImageInfos;
     ComponentInfo compInfo;
@@ -41,18 +50,15 @@ class DeviceUpdaterTest : public testing::Test
 TEST_F(DeviceUpdaterTest, validatePackage)
 {
     constexpr uintmax_t testPkgSize = 1163;
-    uintmax_t packageSize = package.tellg();
+    uintmax_t packageSize = package.size();
     EXPECT_EQ(packageSize, testPkgSize);
 
-    package.seekg(0);
-    std::vector<uint8_t> packageHeader(testPkgSize);
-    package.read(new (packageHeader.data()) char, testPkgSize);
+    auto packageData = package.read(0, testPkgSize);
+    std::vector<uint8_t> packageHeader(packageData.begin(), packageData.end());
 
     auto parser = parsePkgHeader(packageHeader);
     EXPECT_NE(parser, nullptr);
 
-    package.seekg(0);
-
     parser->parse(packageHeader, packageSize);
     const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
     const auto& testPkgCompImageInfos = parser->getComponentImageInfos();
@@ -184,3 +190,569 @@ TEST_F(DeviceUpdaterTest, FullUpdateProgress)
     deviceUpdater.activateFirmware(0, activateMsg, 3);
     EXPECT_EQ(deviceUpdater.getProgress(), 100);
 }
+
+TEST_F(DeviceUpdaterTest, RequestFwDataAgainAfterRetry)
+{
+    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, 512, nullptr);
+
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x02, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq.data());
+    auto response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_EQ(deviceUpdater.getProgress(), 48);
+
+    // The device requests the first 512 bytes again after a re-armed
+    // transfer, the progress does not move
+    auto resentResponse = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(resentResponse[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_EQ(resentResponse, response);
+    EXPECT_EQ(deviceUpdater.getProgress(), 48);
+
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq2{0x8B, 0x05, 0x15, 0x00, 0x02, 0x00,
+                      0x00, 0x00, 0x02, 0x00, 0x00};
+    requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq2.data());
+    response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_EQ(deviceUpdater.getProgress(), 97);
+}
+
+TEST_F(DeviceUpdaterTest, RequestFwDataOutOfOrder)
+{
+    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, 512, nullptr);
+
+    auto requestFwData = [&deviceUpdater](uint8_t offset, uint8_t length) {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                sizeof(pldm_request_firmware_data_req)>
+            request{0x8A, 0x05, 0x15, 0x00, offset, 0x00,
+                    0x00, 0x00, length, 0x00, 0x00};
+        auto response = deviceUpdater.requestFwData(
+            reinterpret_cast<const pldm_msg*>(request.data()),
+            sizeof(pldm_request_firmware_data_req));
+        ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    };
+
+    // The second half of the component first, the first half is still due
+    requestFwData(0x02, 0x02);
+    EXPECT_EQ(deviceUpdater.getProgress(), 48);
+    EXPECT_EQ(deviceUpdater.getMetrics().retransmittedRequests, 0u);
+
+    requestFwData(0x00, 0x02);
+    EXPECT_EQ(deviceUpdater.getProgress(), 97);
+    EXPECT_EQ(deviceUpdater.getMetrics().retransmittedRequests, 0u);
+
+    // Data in the middle of the served ranges is sent again
+    requestFwData(0x01, 0x01);
+    EXPECT_EQ(deviceUpdater.getProgress(), 97);
+    auto metrics = deviceUpdater.getMetrics();
+    EXPECT_EQ(metrics.transferBytes, 1280u);
+    EXPECT_EQ(metrics.retransmittedRequests, 1u);
+    EXPECT_EQ(metrics.retransmittedBytes, 256u);
+}
+
+TEST_F(DeviceUpdaterTest, UpdateMetricsCountRetransmissions)
+{
+    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, 512, nullptr);
+
+    // Offsets 0, 256 and 0 again, the last two overlap the data already sent
+    for (uint8_t offset : {0x00, 0x01, 0x00})
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                sizeof(pldm_request_firmware_data_req)>
+            request{0x8A, 0x05, 0x15, 0x00, offset, 0x00,
+                    0x00, 0x00, 0x02, 0x00, 0x00};
+        auto response = deviceUpdater.requestFwData(
+            reinterpret_cast<const pldm_msg*>(request.data()),
+            sizeof(pldm_request_firmware_data_req));
+        ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    }
+
+    auto metrics = deviceUpdater.getMetrics();
+    EXPECT_EQ(metrics.transferBytes, 1536);
+    EXPECT_EQ(metrics.retransmittedRequests, 2);
+    EXPECT_EQ(metrics.retransmittedBytes, 768);
+    EXPECT_EQ(metrics.transferRetries, 0);
+    EXPECT_EQ(metrics.progress, deviceUpdater.getProgress());
+
+    auto summary = getDeviceUpdateSummary(0, metrics, "InProgress");
+    EXPECT_EQ(summary["EID"], 0);
+    EXPECT_EQ(summary["Status"], "InProgress");
+    EXPECT_EQ(summary["TransferBytes"], 1536);
+    EXPECT_EQ(summary["RetransmittedRequests"], 2);
+    EXPECT_EQ(summary["RetransmittedBytes"], 768);
+    EXPECT_EQ(summary["Phases"].size(), updatePhaseCount);
+    EXPECT_TRUE(summary["Phases"].contains("Transfer"));
+}
+
+TEST(DeviceUpdater, RequestFwDataThroughput)
+{
+    constexpr uint32_t transferSize = 4096;
+    constexpr uint32_t compSize = 4 * 1024 * 1024;
+    std::vector<uint8_t> packageData(compSize);
+    for (size_t i = 0; i < packageData.size(); ++i)
+    {
+        packageData[i] = static_cast<uint8_t>(i * 7);
+    }
+    PackageReader package(packageData);
+
+    FirmwareDeviceIDRecord fwDeviceIDRecord{1, {0x00}, "", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "VersionString"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+
+    for (size_t devices : {1, 16})
+    {
+        // All the devices share the same package reader
+        std::vector<std::unique_ptr<DeviceUpdater>> deviceUpdaters;
+        for (mctp_eid_t eid = 0; eid < devices; ++eid)
+        {
+            deviceUpdaters.emplace_back(std::make_unique<DeviceUpdater>(
+                eid, package, fwDeviceIDRecord, compImageInfos, compInfo,
+                transferSize, nullptr));
+        }
+
+        std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                sizeof(pldm_request_firmware_data_req)>
+            request{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x10, 0x00, 0x00};
+        auto requestMsg = reinterpret_cast<const pldm_msg*>(request.data());
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t offset = 0; offset < compSize; offset += transferSize)
+        {
+            auto offsetLE = htole32(offset);
+            std::memcpy(request.data() + sizeof(pldm_msg_hdr), &offsetLE,
+                        sizeof(offsetLE));
+            for (auto& deviceUpdater : deviceUpdaters)
+            {
+                auto response = deviceUpdater->requestFwData(
+                    requestMsg, sizeof(pldm_request_firmware_data_req));
+                ASSERT_EQ(response.size(),
+                          sizeof(pldm_msg_hdr) + 1 + transferSize);
+                ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+                ASSERT_TRUE(std::equal(
+                    response.begin() + sizeof(pldm_msg_hdr) + 1,
+                    response.end(), packageData.begin() + offset));
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        auto throughput = devices * compSize / (1024 * 1024) / elapsed;
+        ::testing::Test::RecordProperty(
+            "requestFwDataMiBps" + std::to_string(devices) + "Devices",
+            std::to_string(static_cast<uint64_t>(throughput)));
+    }
+}
+
+TEST(DeviceUpdater, RequestFwDataLargeTransfer)
+{
+    // The configured size is clamped to what fits in an MCTP message
+    auto configuredSize = getMaxTransferSize();
+    EXPECT_GE(configuredSize, PLDM_FWUP_BASELINE_TRANSFER_SIZE);
+    EXPECT_LE(sizeof(uint8_t) + sizeof(pldm_msg_hdr) + sizeof(uint8_t) +
+                  configuredSize,
+              mctpMaxMessageSize);
+
+    // The largest size, the MCTP message type, PLDM header and completion
+    // code of the response fill the rest of a 64 KiB MCTP message
+    constexpr uint32_t maxTransferSize = 65531;
+    static_assert(sizeof(uint8_t) + sizeof(pldm_msg_hdr) + sizeof(uint8_t) +
+                      maxTransferSize ==
+                  mctpMaxMessageSize);
+
+    const uint32_t compSize = 2 * maxTransferSize;
+    std::vector<uint8_t> packageData(compSize);
+    for (size_t i = 0; i < packageData.size(); ++i)
+    {
+        packageData[i] = static_cast<uint8_t>(i * 13);
+    }
+    PackageReader package(packageData);
+
+    FirmwareDeviceIDRecord fwDeviceIDRecord{1, {0x00}, "", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "VersionString"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, maxTransferSize, nullptr);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            sizeof(pldm_request_firmware_data_req)>
+        request{0x8A, 0x05, 0x15};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(request.data());
+    auto setRequest = [&request](uint32_t offset, uint32_t length) {
+        offset = htole32(offset);
+        length = htole32(length);
+        std::memcpy(request.data() + sizeof(pldm_msg_hdr), &offset,
+                    sizeof(offset));
+        std::memcpy(request.data() + sizeof(pldm_msg_hdr) + sizeof(offset),
+                    &length, sizeof(length));
+    };
+
+    // The second half of the component in a single transfer
+    setRequest(maxTransferSize, maxTransferSize);
+    auto response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response.size(), sizeof(pldm_msg_hdr) + sizeof(uint8_t) + 65531);
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_TRUE(std::equal(response.begin() + sizeof(pldm_msg_hdr) + 1,
+                           response.end(),
+                           packageData.begin() + maxTransferSize));
+
+    // Larger than the advertised MaximumTransferSize
+    setRequest(0, maxTransferSize + 1);
+    response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response.size(), sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)],
+              PLDM_FWUP_INVALID_TRANSFER_LENGTH);
+}
+
+class ProgressRecorder : public UpdateManagerBase
+{
+  public:
+    ProgressRecorder(Event& event,
+                     requester::Handler<requester::Request>& handler,
+                     InstanceIdDb& instanceIdDb) :
+        UpdateManagerBase(event, handler, instanceIdDb)
+    {}
+
+    void updateDeviceCompletion(mctp_eid_t eid, bool status) override
+    {
+        completions.emplace_back(eid, status);
+    }
+    void updateTransferCompletion(mctp_eid_t eid, uint64_t transferBytes,
+                                  std::chrono::steady_clock::duration) override
+    {
+        transfers.emplace_back(eid, transferBytes);
+    }
+    void activatePackage() override {}
+    void resetActivationState() override {}
+
+    void updateActivationProgress(mctp_eid_t /*eid*/, uint8_t previousProgress,
+                                  uint8_t progress) override
+    {
+        reports.emplace_back(previousProgress, progress);
+    }
+
+    std::vector<std::pair<uint8_t, uint8_t>> reports;
+    std::vector<std::pair<mctp_eid_t, uint64_t>> transfers;
+    std::vector<std::pair<mctp_eid_t, bool>> completions;
+};
+
+TEST(DeviceUpdater, ProgressReportedOnPercentChange)
+{
+    Event event(sdeventplus::Event::get_default());
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> handler(
+        nullptr, event, instanceIdDb, false, std::chrono::seconds(1), 2,
+        std::chrono::milliseconds(100));
+    ProgressRecorder recorder(event, handler, instanceIdDb);
+
+    constexpr uint32_t transferSize = PLDM_FWUP_BASELINE_TRANSFER_SIZE;
+    constexpr uint32_t compSize = 2048 * transferSize;
+    std::vector<uint8_t> packageData(compSize);
+    PackageReader package(packageData);
+
+    FirmwareDeviceIDRecord fwDeviceIDRecord{1, {0x00}, "", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "VersionString"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, transferSize, &recorder);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            sizeof(pldm_request_firmware_data_req)>
+        request{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                0x00, 0x20, 0x00, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(request.data());
+    for (uint32_t offset = 0; offset < compSize; offset += transferSize)
+    {
+        auto offsetLE = htole32(offset);
+        std::memcpy(request.data() + sizeof(pldm_msg_hdr), &offsetLE,
+                    sizeof(offsetLE));
+        auto response = deviceUpdater.requestFwData(
+            requestMsg, sizeof(pldm_request_firmware_data_req));
+        ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    }
+
+    // 2048 transfers report each percent of the transfer phase once
+    ASSERT_EQ(recorder.reports.size(), 97);
+    for (size_t i = 0; i < recorder.reports.size(); ++i)
+    {
+        EXPECT_EQ(recorder.reports[i].first, i);
+        EXPECT_EQ(recorder.reports[i].second, i + 1);
+    }
+    EXPECT_EQ(deviceUpdater.getProgress(), 97);
+}
+
+TEST(DeviceUpdater, TransferCompletionReported)
+{
+    Event event(sdeventplus::Event::get_default());
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> handler(
+        nullptr, event, instanceIdDb, false, std::chrono::seconds(1), 2,
+        std::chrono::milliseconds(100));
+    ProgressRecorder recorder(event, handler, instanceIdDb);
+
+    constexpr uint32_t transferSize = PLDM_FWUP_BASELINE_TRANSFER_SIZE;
+    constexpr uint32_t compSize = 4 * transferSize;
+    std::vector<uint8_t> packageData(compSize);
+    PackageReader package(packageData);
+
+    FirmwareDeviceIDRecord fwDeviceIDRecord{1, {0x00}, "", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "VersionString"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+    DeviceUpdater deviceUpdater(9, package, fwDeviceIDRecord, compImageInfos,
+                                compInfo, transferSize, &recorder);
+    EXPECT_EQ(deviceUpdater.getTotalSize(), compSize);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                            sizeof(pldm_request_firmware_data_req)>
+        request{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                0x00, 0x20, 0x00, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(request.data());
+    for (uint32_t offset = 0; offset < compSize; offset += transferSize)
+    {
+        auto offsetLE = htole32(offset);
+        std::memcpy(request.data() + sizeof(pldm_msg_hdr), &offsetLE,
+                    sizeof(offsetLE));
+        auto response = deviceUpdater.requestFwData(
+            requestMsg, sizeof(pldm_request_firmware_data_req));
+        ASSERT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    }
+    EXPECT_TRUE(recorder.transfers.empty());
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + sizeof(uint8_t)>
+        transferComplete{0x8A, 0x05, 0x16, PLDM_FWUP_TRANSFER_SUCCESS};
+    auto response = deviceUpdater.transferComplete(
+        reinterpret_cast<const pldm_msg*>(transferComplete.data()),
+        sizeof(uint8_t));
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+
+    ASSERT_EQ(recorder.transfers.size(), 1);
+    EXPECT_EQ(recorder.transfers[0].first, 9);
+    EXPECT_EQ(recorder.transfers[0].second, compSize);
+}
+
+/** @brief Commands of the PLDM requests traced by a verbose handler
+ *
+ *  @param[in] trace - standard output captured while the requests were sent
+ *
+ *  @return the PLDM command of each request, in order
+ */
+static std::vector<uint8_t> getSentCommands(const std::string& trace)
+{
+    std::vector<uint8_t> commands;
+    std::istringstream lines(trace);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        // "Tx: " and the first two bytes of the header precede the command
+        if (line.starts_with("Tx: ") && line.size() >= 12)
+        {
+            commands.push_back(
+                static_cast<uint8_t>(std::stoul(line.substr(10, 2), nullptr,
+                                                16)));
+        }
+    }
+    return commands;
+}
+
+/** @brief Drives the retry state machine of a DeviceUpdater, the requests
+ *         are traced by a verbose handler without a transport
+ */
+class DeviceUpdaterRetryTest : public testing::Test
+{
+  protected:
+    DeviceUpdaterRetryTest() :
+        event(sdeventplus::Event::get_default()),
+        handler(nullptr, event, instanceIdDb, true, std::chrono::seconds(1),
+                2, std::chrono::milliseconds(100)),
+        recorder(event, handler, instanceIdDb), packageData(compSize),
+        package(packageData),
+        deviceUpdater(eid, package, fwDeviceIDRecord, compImageInfos,
+                      compInfo, PLDM_FWUP_BASELINE_TRANSFER_SIZE, &recorder)
+    {}
+
+    /** @brief Report a failed transfer of the component */
+    void failTransfer()
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) + sizeof(uint8_t)>
+            transferComplete{0x8A, 0x05, PLDM_TRANSFER_COMPLETE,
+                             PLDM_FWUP_TRANSFER_ERROR_IMAGE_CORRUPT};
+        auto response = deviceUpdater.transferComplete(
+            reinterpret_cast<const pldm_msg*>(transferComplete.data()),
+            sizeof(uint8_t));
+        EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    }
+
+    /** @brief Respond to CancelUpdateComponent and run the deferred request
+     *
+     *  @param[in] completionCode - completion code of the response
+     */
+    void respondCancelUpdateComponent(uint8_t completionCode)
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) + sizeof(uint8_t)> response{
+            0x0A, 0x05, PLDM_CANCEL_UPDATE_COMPONENT, completionCode};
+        deviceUpdater.cancelUpdateComponent(
+            eid, reinterpret_cast<const pldm_msg*>(response.data()),
+            sizeof(uint8_t));
+        sd_event_run(event.get(), 0);
+    }
+
+    /** @brief Respond to CancelUpdate and run the deferred request */
+    void respondCancelUpdate()
+    {
+        std::array<uint8_t, sizeof(pldm_msg_hdr) + 10> response{
+            0x0A, 0x05, PLDM_CANCEL_UPDATE, PLDM_SUCCESS};
+        deviceUpdater.cancelUpdate(
+            eid, reinterpret_cast<const pldm_msg*>(response.data()), 10);
+        sd_event_run(event.get(), 0);
+    }
+
+    static constexpr mctp_eid_t eid = 9;
+    static constexpr uint32_t compSize = 4 * PLDM_FWUP_BASELINE_TRANSFER_SIZE;
+
+    Event event;
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> handler;
+    ProgressRecorder recorder;
+    std::vector<uint8_t> packageData;
+    PackageReader package;
+    FirmwareDeviceIDRecord fwDeviceIDRecord{
+        1, {0x00}, "VersionString", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "VersionString"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+    DeviceUpdater deviceUpdater;
+};
+
+TEST_F(DeviceUpdaterRetryTest, TransferFailureRearmsComponent)
+{
+    if (!FW_UPDATE_TRANSFER_RETRIES)
+    {
+        GTEST_SKIP() << "Transfer retries are disabled";
+    }
+
+    testing::internal::CaptureStdout();
+    failTransfer();
+    respondCancelUpdateComponent(PLDM_SUCCESS);
+    auto commands = getSentCommands(testing::internal::GetCapturedStdout());
+
+    std::vector<uint8_t> expected{PLDM_CANCEL_UPDATE_COMPONENT,
+                                  PLDM_UPDATE_COMPONENT};
+    EXPECT_EQ(commands, expected);
+    EXPECT_EQ(deviceUpdater.getMetrics().transferRetries, 1);
+    EXPECT_TRUE(recorder.completions.empty());
+}
+
+TEST_F(DeviceUpdaterRetryTest, RejectedCancelRestartsUpdate)
+{
+    if (!FW_UPDATE_TRANSFER_RETRIES)
+    {
+        GTEST_SKIP() << "Transfer retries are disabled";
+    }
+
+    testing::internal::CaptureStdout();
+    failTransfer();
+    respondCancelUpdateComponent(PLDM_ERROR);
+    respondCancelUpdate();
+    auto commands = getSentCommands(testing::internal::GetCapturedStdout());
+
+    // The device did not cancel the component, it leaves update mode and the
+    // update starts over
+    std::vector<uint8_t> expected{PLDM_CANCEL_UPDATE_COMPONENT,
+                                  PLDM_CANCEL_UPDATE, PLDM_REQUEST_UPDATE};
+    EXPECT_EQ(commands, expected);
+    EXPECT_EQ(deviceUpdater.getMetrics().transferRetries, 1);
+}
+
+TEST_F(DeviceUpdaterRetryTest, RetriesExhausted)
+{
+    testing::internal::CaptureStdout();
+    for (size_t retry = 0; retry < FW_UPDATE_TRANSFER_RETRIES; ++retry)
+    {
+        failTransfer();
+        respondCancelUpdateComponent(PLDM_SUCCESS);
+    }
+    EXPECT_TRUE(recorder.completions.empty());
+
+    failTransfer();
+    auto commands = getSentCommands(testing::internal::GetCapturedStdout());
+
+    std::vector<uint8_t> expected;
+    for (size_t retry = 0; retry < FW_UPDATE_TRANSFER_RETRIES; ++retry)
+    {
+        expected.push_back(PLDM_CANCEL_UPDATE_COMPONENT);
+        expected.push_back(PLDM_UPDATE_COMPONENT);
+    }
+    expected.push_back(PLDM_CANCEL_UPDATE_COMPONENT);
+    EXPECT_EQ(commands, expected);
+    EXPECT_EQ(deviceUpdater.getMetrics().transferRetries,
+              FW_UPDATE_TRANSFER_RETRIES);
+    ASSERT_EQ(recorder.completions.size(), 1);
+    EXPECT_EQ(recorder.completions[0].first, eid);
+    EXPECT_FALSE(recorder.completions[0].second);
+}
+
+TEST_F(DeviceUpdaterRetryTest, VerifyFailureNotRetried)
+{
+    testing::internal::CaptureStdout();
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + sizeof(uint8_t)> verifyComplete{
+        0x8C, 0x05, PLDM_VERIFY_COMPLETE,
+        PLDM_FWUP_VERIFY_ERROR_VERIFICATION_FAILURE};
+    auto response = deviceUpdater.verifyComplete(
+        reinterpret_cast<const pldm_msg*>(verifyComplete.data()),
+        sizeof(uint8_t));
+    auto commands = getSentCommands(testing::internal::GetCapturedStdout());
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+
+    std::vector<uint8_t> expected{PLDM_CANCEL_UPDATE_COMPONENT};
+    EXPECT_EQ(commands, expected);
+    EXPECT_EQ(deviceUpdater.getMetrics().transferRetries, 0);
+    ASSERT_EQ(recorder.completions.size(), 1);
+    EXPECT_FALSE(recorder.completions[0].second);
+}
+
+TEST(UpdateSummary, OneFilePerUpdate)
+{
+    auto dir = std::filesystem::temp_directory_path() /
+               ("fw-update-summary-test-" + std::to_string(getpid()));
+    std::filesystem::remove_all(dir);
+
+    pldm::utils::Json summary;
+    summary["Status"] = "Activating";
+    writeUpdateSummary(dir, "1", summary);
+    writeUpdateSummary(dir, "2", summary);
+    summary["Status"] = "Active";
+    writeUpdateSummary(dir, "1", summary);
+
+    // Rewriting the summary of an update leaves the others alone
+    std::ifstream file(dir / "1.json");
+    EXPECT_EQ(pldm::utils::Json::parse(file)["Status"], "Active");
+    EXPECT_TRUE(std::filesystem::exists(dir / "2.json"));
+
+    for (size_t update = 3; update <= maxUpdateSummaries + 4; ++update)
+    {
+        writeUpdateSummary(dir, std::to_string(update), summary);
+    }
+    auto count = static_cast<size_t>(
+        std::distance(std::filesystem::directory_iterator(dir),
+                      std::filesystem::directory_iterator()));
+    EXPECT_EQ(count, maxUpdateSummaries);
+    EXPECT_TRUE(std::filesystem::exists(
+        dir / (std::to_string(maxUpdateSummaries + 4) + ".json")));
+
+    std::filesystem::remove_all(dir);
+}
@@ -45,6 +45,29 @@ class FirmwareInventoryManagerTest : public FirmwareInventoryManager
     }
 };
 
+class AggregateUpdateManagerTest : public AggregateUpdateManager
+{
+  public:
+    using AggregateUpdateManager::AggregateUpdateManager;
+    using AggregateUpdateManager::routeUpdate;
+
+    std::optional<SoftwareIdentifier> getRoute(mctp_eid_t eid) const
+    {
+        auto route = activeUpdates.find(eid);
+        if (route == activeUpdates.end())
+        {
+            return std::nullopt;
+        }
+        return route->second;
+    }
+
+    ItemUpdateManager& getUpdateManager(
+        const SoftwareIdentifier& softwareIdentifier)
+    {
+        return *updateManagers.at(softwareIdentifier);
+    }
+};
+
 TEST(GetBoardPath_WithMockHandler, ReturnsExpectedBoardPath)
 {
     MockdBusHandler mockHandler;
@@ -102,3 +125,99 @@ TEST(GetBoardPath_WithMockHandler, ReturnsExpectedBoardPath)
               std::string::npos);
     EXPECT_EQ(inventory->getVersion().version(), firmwareVersion);
 }
+
+TEST(AggregateUpdateManager, UnownedRequestRejectedOnce)
+{
+    Event event(sdeventplus::Event::get_default());
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> handler(
+        nullptr, event, instanceIdDb, false, seconds(1), 2, milliseconds(100));
+
+    DescriptorMap descriptorMap{};
+    ComponentInfoMap componentInfoMap{};
+    AggregateUpdateManager updateManager(event, handler, instanceIdDb,
+                                         descriptorMap, componentInfoMap);
+
+    // Item update managers without an update in progress do not own the
+    // commands of their endpoint
+    pldm::eid endpointId = 1;
+    updateManager.createUpdateManager(
+        {endpointId, 100}, {}, {},
+        "/xyz/openbmc_project/software/PLDM_Device_TestDevice", "1234");
+    updateManager.createUpdateManager(
+        {endpointId, 200}, {}, {},
+        "/xyz/openbmc_project/software/PLDM_Device_TestDevice", "5678");
+
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x02, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq.data());
+    auto response = updateManager.handleRequest(
+        endpointId, PLDM_REQUEST_FIRMWARE_DATA, requestMsg,
+        sizeof(pldm_request_firmware_data_req));
+
+    ASSERT_EQ(response.size(), sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responseMsg = reinterpret_cast<const pldm_msg*>(response.data());
+    EXPECT_EQ(responseMsg->hdr.request, PLDM_RESPONSE);
+    EXPECT_EQ(responseMsg->hdr.command, PLDM_REQUEST_FIRMWARE_DATA);
+    EXPECT_EQ(responseMsg->payload[0], PLDM_FWUP_COMMAND_NOT_EXPECTED);
+}
+
+TEST(AggregateUpdateManager, OwnedRequestRoutedUntilReset)
+{
+    Event event(sdeventplus::Event::get_default());
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> handler(
+        nullptr, event, instanceIdDb, false, seconds(1), 2, milliseconds(100));
+
+    DescriptorMap descriptorMap{};
+    ComponentInfoMap componentInfoMap{};
+    std::vector<mctp_eid_t> completedDevices;
+    AggregateUpdateManagerTest updateManager(
+        event, handler, instanceIdDb, descriptorMap, componentInfoMap,
+        [&completedDevices](mctp_eid_t eid) {
+            completedDevices.emplace_back(eid);
+        });
+
+    pldm::eid endpointId = 1;
+    SoftwareIdentifier owner{endpointId, 100};
+    SoftwareIdentifier other{endpointId, 200};
+    updateManager.createUpdateManager(
+        owner, {}, {}, "/xyz/openbmc_project/software/PLDM_Device_TestDevice",
+        "1234");
+    updateManager.createUpdateManager(
+        other, {}, {}, "/xyz/openbmc_project/software/PLDM_Device_TestDevice",
+        "5678");
+
+    // The item update manager updating the endpoint owns its commands
+    updateManager.routeUpdate(owner, true);
+    EXPECT_EQ(updateManager.getRoute(endpointId), owner);
+
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x02, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq.data());
+    auto response = updateManager.handleRequest(
+        endpointId, PLDM_REQUEST_FIRMWARE_DATA, requestMsg,
+        sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response.size(), sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responseMsg = reinterpret_cast<const pldm_msg*>(response.data());
+    EXPECT_EQ(responseMsg->payload[0], PLDM_FWUP_COMMAND_NOT_EXPECTED);
+    EXPECT_EQ(updateManager.getRoute(endpointId), owner);
+
+    // Resetting another item update manager of the endpoint keeps the route
+    updateManager.getUpdateManager(other).resetActivationState();
+    EXPECT_EQ(updateManager.getRoute(endpointId), owner);
+    EXPECT_TRUE(completedDevices.empty());
+
+    // Resetting the owner drops the route, the endpoint is released once
+    updateManager.getUpdateManager(owner).resetActivationState();
+    EXPECT_EQ(updateManager.getRoute(endpointId), std::nullopt);
+    ASSERT_EQ(completedDevices.size(), 1u);
+    EXPECT_EQ(completedDevices.front(), endpointId);
+
+    updateManager.getUpdateManager(owner).resetActivationState();
+    EXPECT_EQ(completedDevices.size(), 1u);
+}
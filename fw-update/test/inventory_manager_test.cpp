@@ -6,6 +6,9 @@
 
 #include <libpldm/firmware_update.h>
 
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -23,17 +26,71 @@ class InventoryManagerTest : public testing::Test
                    milliseconds(100)),
         updateManager(event, reqHandler, instanceIdDb, outDescriptorMap,
                       outComponentInfoMap),
+        cacheDir(makeCacheDir()),
         inventoryManager(&dBusHandler, reqHandler, instanceIdDb,
                          outDescriptorMap, outDownstreamDescriptorMap,
-                         outComponentInfoMap, configurations, updateManager)
+                         outComponentInfoMap, configurations, updateManager,
+                         cacheDir)
     {}
 
+    ~InventoryManagerTest() override
+    {
+        std::filesystem::remove_all(cacheDir);
+    }
+
+    static std::filesystem::path makeCacheDir()
+    {
+        char tmpdir[] = "/tmp/inventory_manager_test.XXXXXX";
+        return mkdtemp(tmpdir);
+    }
+
+    size_t cachedInventories() const
+    {
+        return std::distance(std::filesystem::directory_iterator(cacheDir),
+                             std::filesystem::directory_iterator());
+    }
+
+    // The request handler has no transport, the responses are handled as if
+    // the endpoint answered the discovery
+    static void respondDeviceIdentifiers(
+        InventoryManager& manager, mctp_eid_t eid, uint8_t ianaByte = 0x0a)
+    {
+        constexpr size_t respLength = 49;
+        std::array<uint8_t, sizeof(pldm_msg_hdr) + respLength> resp{
+            0x00, 0x00, 0x00, 0x00, 0x2b, 0x00, 0x00, 0x00, 0x03, 0x01,
+            0x00, 0x04, 0x00, 0x0a, 0x0b, 0x0c, 0x0d, 0x02, 0x00, 0x10,
+            0x00, 0x12, 0x44, 0xd2, 0x64, 0x8d, 0x7d, 0x47, 0x18, 0xa0,
+            0x30, 0xfc, 0x8a, 0x56, 0x58, 0x7d, 0x5b, 0xFF, 0xFF, 0x0B,
+            0x00, 0x01, 0x07, 0x4f, 0x70, 0x65, 0x6e, 0x42, 0x4d, 0x43,
+            0x01, 0x02};
+        resp[13] = ianaByte;
+        manager.queryDeviceIdentifiers(
+            eid, reinterpret_cast<const pldm_msg*>(resp.data()), respLength);
+    }
+
+    static void respondFirmwareParameters(InventoryManager& manager,
+                                          mctp_eid_t eid)
+    {
+        constexpr size_t respLength = 119;
+        constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) + respLength> resp{
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01,
+            0x0c, 0x00, 0x00, 0x44, 0x65, 0x76, 0x69, 0x63, 0x65, 0x56, 0x65,
+            0x72, 0x32, 0x2e, 0x30, 0x02, 0x00, 0x2e, 0x01, 0x28, 0x00, 0x00,
+            0x00, 0x00, 0x01, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43,
+            0x6f, 0x6d, 0x70, 0x33, 0x76, 0x34, 0x2e, 0x30};
+        manager.getFirmwareParameters(
+            eid, reinterpret_cast<const pldm_msg*>(resp.data()), respLength);
+    }
+
     int fd = -1;
     const pldm::utils::DBusHandler dBusHandler;
     sdeventplus::Event event;
     TestInstanceIdDb instanceIdDb;
     requester::Handler<requester::Request> reqHandler;
     AggregateUpdateManager updateManager;
+    std::filesystem::path cacheDir;
     InventoryManager inventoryManager;
     DescriptorMap outDescriptorMap{};
     DownstreamDescriptorMap outDownstreamDescriptorMap{};
@@ -239,3 +296,126 @@ TEST_F(InventoryManagerTest, getFirmwareParametersResponseErrorCC)
     inventoryManager.getFirmwareParameters(1, responseMsg, respPayloadLength);
     EXPECT_EQ(outComponentInfoMap.size(), 0);
 }
+
+TEST_F(InventoryManagerTest, discoverFDsFromCache)
+{
+    MctpInfos mctpInfos{
+        {1, "12345678-9abc-def0-1234-56789abcdef0", "", 0, std::nullopt}};
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    respondFirmwareParameters(inventoryManager, 1);
+
+    auto descriptorMap = outDescriptorMap;
+    auto componentInfoMap = outComponentInfoMap;
+    ASSERT_EQ(descriptorMap.size(), 1u);
+    ASSERT_EQ(componentInfoMap.size(), 1u);
+    EXPECT_EQ(cachedInventories(), 1u);
+
+    // The endpoint is discovered again with the same identifiers, its
+    // firmware parameters come from the cache
+    outDescriptorMap.clear();
+    outComponentInfoMap.clear();
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    EXPECT_EQ(outDescriptorMap, descriptorMap);
+    EXPECT_EQ(outComponentInfoMap, componentInfoMap);
+
+    // The cache outlives the daemon
+    outDescriptorMap.clear();
+    outComponentInfoMap.clear();
+    InventoryManager restartedManager(
+        &dBusHandler, reqHandler, instanceIdDb, outDescriptorMap,
+        outDownstreamDescriptorMap, outComponentInfoMap, configurations,
+        updateManager, cacheDir);
+    restartedManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(restartedManager, 1);
+    EXPECT_EQ(outDescriptorMap, descriptorMap);
+    EXPECT_EQ(outComponentInfoMap, componentInfoMap);
+
+    // The firmware of the endpoint changed, it is queried again
+    inventoryManager.invalidateInventory(1);
+    EXPECT_EQ(cachedInventories(), 0u);
+    outDescriptorMap.clear();
+    outComponentInfoMap.clear();
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    EXPECT_EQ(outDescriptorMap, descriptorMap);
+    EXPECT_TRUE(outComponentInfoMap.empty());
+}
+
+TEST_F(InventoryManagerTest, cachedInventoryCheckedAgainstIdentifiers)
+{
+    MctpInfos mctpInfos{
+        {1, "12345678-9abc-def0-1234-56789abcdef0", "", 0, std::nullopt}};
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    respondFirmwareParameters(inventoryManager, 1);
+    ASSERT_EQ(outComponentInfoMap.size(), 1u);
+
+    // Another FD behind the same endpoint UUID is queried
+    outDescriptorMap.clear();
+    outComponentInfoMap.clear();
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1, 0x0b);
+    EXPECT_EQ(outDescriptorMap.size(), 1u);
+    EXPECT_TRUE(outComponentInfoMap.empty());
+}
+
+TEST_F(InventoryManagerTest, removeFDsKeepsCache)
+{
+    MctpInfos mctpInfos{
+        {1, "12345678-9abc-def0-1234-56789abcdef0", "", 0, std::nullopt}};
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    respondFirmwareParameters(inventoryManager, 1);
+    auto componentInfoMap = outComponentInfoMap;
+    ASSERT_EQ(componentInfoMap.size(), 1u);
+
+    // The endpoint comes back after a reset of the FD
+    inventoryManager.removeFDs(mctpInfos);
+    EXPECT_TRUE(outDescriptorMap.empty());
+    EXPECT_TRUE(outComponentInfoMap.empty());
+    inventoryManager.discoverFDs(mctpInfos);
+    respondDeviceIdentifiers(inventoryManager, 1);
+    EXPECT_EQ(outComponentInfoMap, componentInfoMap);
+}
+
+TEST_F(InventoryManagerTest, nullUUIDNotCached)
+{
+    for (const UUID& uuid : {"", "00000000-0000-0000-0000-000000000000"})
+    {
+        MctpInfos mctpInfos{{1, uuid, "", 0, std::nullopt}};
+        inventoryManager.discoverFDs(mctpInfos);
+        respondDeviceIdentifiers(inventoryManager, 1);
+        respondFirmwareParameters(inventoryManager, 1);
+        ASSERT_EQ(outComponentInfoMap.size(), 1u);
+        EXPECT_EQ(cachedInventories(), 0u);
+
+        outComponentInfoMap.clear();
+        inventoryManager.discoverFDs(mctpInfos);
+        respondDeviceIdentifiers(inventoryManager, 1);
+        EXPECT_TRUE(outComponentInfoMap.empty());
+        inventoryManager.removeFDs(mctpInfos);
+    }
+}
+
+TEST_F(InventoryManagerTest, duplicateUUIDNotCached)
+{
+    const UUID uuid = "12345678-9abc-def0-1234-56789abcdef0";
+    inventoryManager.discoverFDs({{1, uuid, "", 0, std::nullopt}});
+    respondDeviceIdentifiers(inventoryManager, 1);
+    respondFirmwareParameters(inventoryManager, 1);
+    ASSERT_EQ(cachedInventories(), 1u);
+
+    // A second endpoint reports the same UUID, the UUID identifies neither
+    inventoryManager.discoverFDs({{2, uuid, "", 0, std::nullopt}});
+    EXPECT_EQ(cachedInventories(), 0u);
+    respondDeviceIdentifiers(inventoryManager, 2);
+    respondFirmwareParameters(inventoryManager, 2);
+    EXPECT_EQ(cachedInventories(), 0u);
+
+    outComponentInfoMap.clear();
+    inventoryManager.discoverFDs({{1, uuid, "", 0, std::nullopt}});
+    respondDeviceIdentifiers(inventoryManager, 1);
+    EXPECT_FALSE(outComponentInfoMap.contains(1));
+}
@@ -1,5 +1,8 @@
 #include "fw-update/package_parser.hpp"
 
+#include <libpldm/edac.h>
+
+#include <spanstream>
 #include <typeinfo>
 
 #include <gmock/gmock.h>
@@ -208,3 +211,146 @@ TEST(PackageParser, InvalidPkgBadChecksum)
     imageInsert(fwPkgHdr, compImage);
     EXPECT_EQ(parsePkgHeader(fwPkgHdr), nullptr);
 }
+
+TEST(PackageParser, ReadPkgHeaderFromStream)
+{
+    std::vector<uint8_t> fwPkg{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43, 0x98, 0x00, 0xA0, 0x2F,
+        0x05, 0x9A, 0xCA, 0x02, 0x01, 0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0C, 0xE5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0E,
+        0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69, 0x6E,
+        0x67, 0x31, 0x01, 0x2E, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E,
+        0x00, 0x00, 0x01, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74,
+        0x72, 0x69, 0x6E, 0x67, 0x32, 0x02, 0x00, 0x10, 0x00, 0x16, 0x20, 0x23,
+        0xC9, 0x3E, 0xC5, 0x41, 0x15, 0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+        0x75, 0x01, 0x00, 0x0A, 0x00, 0x64, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x01,
+        0x0E, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69,
+        0x6E, 0x67, 0x33, 0x4F, 0x96, 0xAE, 0x56};
+
+    constexpr uintmax_t pkgSize = 166;
+    constexpr uintmax_t pkgHeaderSize = 139;
+    std::vector<uint8_t> compImage;
+    imageGenerate(compImage, pkgSize - pkgHeaderSize);
+    imageInsert(fwPkg, compImage);
+
+    std::ispanstream stream(
+        std::span(reinterpret_cast<const char*>(fwPkg.data()), fwPkg.size()));
+    auto pkgHdr = readPkgHeader(stream, pkgSize);
+    ASSERT_EQ(pkgHdr.size(), pkgHeaderSize);
+    EXPECT_TRUE(std::equal(pkgHdr.begin(), pkgHdr.end(), fwPkg.begin()));
+
+    auto parser = parsePkgHeader(pkgHdr);
+    ASSERT_NE(parser, nullptr);
+    EXPECT_NO_THROW(parser->parse(pkgHdr, pkgSize));
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 139, 27, "VersionString3"}};
+    EXPECT_EQ(parser->getComponentImageInfos(), compImageInfos);
+
+    // The declared package header does not fit in a truncated package
+    std::ispanstream truncated(
+        std::span(reinterpret_cast<const char*>(fwPkg.data()), 100));
+    EXPECT_TRUE(readPkgHeader(truncated, 100).empty());
+}
+
+TEST(PackageParser, ValidPkgPayloadChecksum)
+{
+    std::vector<uint8_t> fwPkgV1{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43, 0x98, 0x00, 0xA0, 0x2F,
+        0x05, 0x9A, 0xCA, 0x02, 0x01, 0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0C, 0xE5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0E,
+        0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69, 0x6E,
+        0x67, 0x31, 0x01, 0x2E, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E,
+        0x00, 0x00, 0x01, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74,
+        0x72, 0x69, 0x6E, 0x67, 0x32, 0x02, 0x00, 0x10, 0x00, 0x16, 0x20, 0x23,
+        0xC9, 0x3E, 0xC5, 0x41, 0x15, 0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+        0x75, 0x01, 0x00, 0x0A, 0x00, 0x64, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x01,
+        0x0E, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69,
+        0x6E, 0x67, 0x33, 0x4F, 0x96, 0xAE, 0x56};
+    constexpr size_t fdAreaEnd = 97;
+    constexpr size_t compAreaEnd = 135;
+    constexpr uintmax_t pkgImageSize = 27;
+
+    // A package header format revision 2 with the same content and a
+    // downstream device ID record
+    std::vector<uint8_t> fwPkg(fwPkgV1.begin(), fwPkgV1.begin() + fdAreaEnd);
+    constexpr std::array<uint8_t, 16> hdrIdentifierv2{
+        0x12, 0x44, 0xD2, 0x64, 0x8D, 0x7D, 0x47, 0x18,
+        0xA0, 0x30, 0xFC, 0x8A, 0x56, 0x58, 0x7D, 0x5A};
+    std::ranges::copy(hdrIdentifierv2, fwPkg.begin());
+    fwPkg[16] = pkgHeaderFormatRevision2;
+    const std::vector<uint8_t> downstreamArea{0x01, 0x0B, 0x00, 0x00,
+                                              0x00, 0x00, 0x00, 0x00,
+                                              0x00, 0x00, 0x00, 0x00};
+    fwPkg.insert(fwPkg.end(), downstreamArea.begin(), downstreamArea.end());
+    auto compAreaOffset = fwPkg.size();
+    fwPkg.insert(fwPkg.end(), fwPkgV1.begin() + fdAreaEnd,
+                 fwPkgV1.begin() + compAreaEnd);
+
+    auto putLE32 = [](std::vector<uint8_t>& data, size_t offset,
+                      uint32_t value) {
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            data[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    };
+    const uintmax_t pkgHeaderSize = fwPkg.size() + 2 * sizeof(uint32_t);
+    const uintmax_t pkgSize = pkgHeaderSize + pkgImageSize;
+    fwPkg[17] = static_cast<uint8_t>(pkgHeaderSize);
+    fwPkg[18] = static_cast<uint8_t>(pkgHeaderSize >> 8);
+    // ComponentLocationOffset
+    putLE32(fwPkg, compAreaOffset + 14, pkgHeaderSize);
+
+    std::vector<uint8_t> compImage;
+    imageGenerate(compImage, pkgImageSize);
+    auto payloadChecksum = pldm_edac_crc32(compImage.data(), compImage.size());
+    fwPkg.resize(pkgHeaderSize);
+    putLE32(fwPkg, pkgHeaderSize - 8,
+            pldm_edac_crc32(fwPkg.data(), pkgHeaderSize - 8));
+    putLE32(fwPkg, pkgHeaderSize - 4, payloadChecksum);
+    imageInsert(fwPkg, compImage);
+
+    PackageParser parser(pkgHeaderSize, "VersionString1", 8,
+                         pkgHeaderFormatRevision2);
+    std::vector<uint8_t> pkgHdr(fwPkg.begin(), fwPkg.begin() + pkgHeaderSize);
+    ASSERT_NO_THROW(parser.parse(pkgHdr, pkgSize));
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, pkgHeaderSize, 27, "VersionString3"}};
+    EXPECT_EQ(parser.getComponentImageInfos(), compImageInfos);
+    EXPECT_EQ(parser.getFwDeviceIDRecords().size(), 1);
+    EXPECT_EQ(parser.getPkgPayloadChecksum(), payloadChecksum);
+    EXPECT_TRUE(parser.verifyPayload(fwPkg));
+
+    // The payload checked a chunk at a time matches the same checksum
+    PayloadVerifier verifier(parser, fwPkg, 7);
+    size_t chunks = 1;
+    while (!verifier.verifyChunk())
+    {
+        ++chunks;
+    }
+    EXPECT_EQ(chunks, (pkgImageSize + 6) / 7);
+    EXPECT_TRUE(verifier.isValid());
+    EXPECT_TRUE(verifier.verifyChunk());
+
+    // Any chunk size matches, a tail shorter than the CRC is checked with the
+    // chunk before it
+    for (size_t chunkSize = 1; chunkSize <= pkgImageSize + 1; ++chunkSize)
+    {
+        PayloadVerifier chunkVerifier(parser, fwPkg, chunkSize);
+        while (!chunkVerifier.verifyChunk())
+        {}
+        EXPECT_TRUE(chunkVerifier.isValid()) << "chunk size " << chunkSize;
+    }
+
+    // A corrupted component image fails before any device is updated
+    fwPkg.back() ^= 0xFF;
+    EXPECT_FALSE(parser.verifyPayload(fwPkg));
+
+    // Format revision 1 packages carry no payload checksum
+    auto parserV1 = parsePkgHeader(fwPkgV1);
+    ASSERT_NE(parserV1, nullptr);
+    parserV1->parse(fwPkgV1, fwPkgV1.size() + pkgImageSize);
+    EXPECT_EQ(parserV1->getPkgPayloadChecksum(), std::nullopt);
+    EXPECT_TRUE(parserV1->verifyPayload(fwPkgV1));
+}
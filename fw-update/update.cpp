@@ -28,22 +28,10 @@ sdbusplus::object_path Update::startUpdate(
     }
 
     info("Starting update for image {FD}", "FD", image.fd);
-    char buffer[4096];
-    ssize_t bytesRead = 0;
-    imageStream.str(std::string());
+    auto packageReader = std::make_unique<PackageReader>(image.fd);
 
-    while ((bytesRead = read(image, buffer, sizeof(buffer))) > 0)
-    {
-        imageStream.write(buffer, bytesRead);
-    }
-
-    if (bytesRead < 0)
-    {
-        throw std::runtime_error("Failed to read image file descriptor");
-    }
-
-    return sdbusplus::object_path(updateManager->processStreamDefer(
-        imageStream, imageStream.str().size()));
+    return sdbusplus::object_path(
+        updateManager->processStreamDefer(std::move(packageReader)));
 }
 
 } // namespace fw_update
@@ -47,7 +47,6 @@ class Update : public UpdateIntf
   private:
     UpdateManager* updateManager;
     const std::string objPath;
-    std::stringstream imageStream;
 };
 
 } // namespace fw_update
@@ -7,10 +7,13 @@
 #include <phosphor-logging/lg2.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
+#include <spanstream>
 #include <string>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -23,6 +26,133 @@ namespace fw_update
 namespace fs = std::filesystem;
 namespace software = sdbusplus::xyz::openbmc_project::Software::server;
 
+namespace
+{
+
+/** @brief Names of the UpdatePhase values in the update summary */
+constexpr std::array<const char*, updatePhaseCount> phaseNames{
+    "RequestUpdate", "PassComponentTable", "Transfer",
+    "Verify",        "Apply",              "Activate"};
+
+double toMilliseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+pldm::utils::Json getDeviceUpdateSummary(mctp_eid_t eid,
+                                         const UpdateMetrics& metrics,
+                                         std::string_view status)
+{
+    pldm::utils::Json phases = pldm::utils::Json::object();
+    for (size_t phase = 0; phase < updatePhaseCount; ++phase)
+    {
+        phases[phaseNames[phase]] = toMilliseconds(metrics.phaseTimes[phase]);
+    }
+
+    pldm::utils::Json summary;
+    summary["EID"] = eid;
+    summary["Status"] = std::string(status);
+    summary["Progress"] = metrics.progress;
+    summary["TransferBytes"] = metrics.transferBytes;
+    summary["TransferMs"] = toMilliseconds(metrics.transferTime);
+    summary["BytesPerSecond"] = metrics.bytesPerSecond();
+    summary["RetransmittedRequests"] = metrics.retransmittedRequests;
+    summary["RetransmittedBytes"] = metrics.retransmittedBytes;
+    summary["TransferRetries"] = metrics.transferRetries;
+    summary["Phases"] = std::move(phases);
+    return summary;
+}
+
+void writeUpdateSummary(const fs::path& dir, std::string_view updateId,
+                        const pldm::utils::Json& summary)
+{
+    if (dir.empty())
+    {
+        return;
+    }
+
+    auto path = dir / (std::string(updateId) + ".json");
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    try
+    {
+        fs::create_directories(dir);
+        {
+            std::ofstream file(tmpPath, std::ios::out | std::ios::trunc);
+            file << summary.dump(4) << '\n';
+            if (!file.flush())
+            {
+                throw std::runtime_error("Failed to write " +
+                                         tmpPath.string());
+            }
+        }
+        fs::rename(tmpPath, path);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to write firmware update summary '{PATH}', error - {ERROR}",
+            "PATH", path, "ERROR", e);
+        std::error_code ec;
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    // Keep the summaries of the most recent updates only
+    std::error_code ec;
+    std::vector<std::pair<fs::file_time_type, fs::path>> summaries;
+    for (const auto& entry : fs::directory_iterator(dir, ec))
+    {
+        if (entry.path().extension() == ".json" && entry.path() != path)
+        {
+            summaries.emplace_back(entry.last_write_time(ec), entry.path());
+        }
+    }
+    if (summaries.size() < maxUpdateSummaries)
+    {
+        return;
+    }
+
+    std::ranges::sort(summaries);
+    for (size_t i = 0; i <= summaries.size() - maxUpdateSummaries; ++i)
+    {
+        fs::remove(summaries[i].second, ec);
+    }
+}
+
+void UpdateManagerBase::verifyPayload(const PackageParser& parser,
+                                      std::span<const uint8_t> package,
+                                      PayloadVerifiedHandler callback)
+{
+    payloadVerifier = std::make_unique<PayloadVerifier>(parser, package);
+    payloadVerifiedHandler = std::move(callback);
+    payloadVerifierHandler = std::make_unique<sdeventplus::source::Defer>(
+        event, [this](sdeventplus::source::EventBase& source) {
+            if (!payloadVerifier->verifyChunk())
+            {
+                // Check the next chunk once the pending events are handled
+                source.set_enabled(Enabled::OneShot);
+                return;
+            }
+
+            source.set_enabled(Enabled::Off);
+            auto valid = payloadVerifier->isValid();
+            auto callback = std::move(payloadVerifiedHandler);
+            payloadVerifiedHandler = nullptr;
+            payloadVerifier.reset();
+            callback(valid);
+        });
+}
+
+void UpdateManagerBase::cancelPayloadVerification()
+{
+    payloadVerifierHandler.reset();
+    payloadVerifiedHandler = nullptr;
+    payloadVerifier.reset();
+}
+
 std::string UpdateManager::getSwId()
 {
     return std::to_string(
@@ -59,20 +189,20 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         }
     }
 
-    package.open(packageFilePath,
-                 std::ios::binary | std::ios::in | std::ios::ate);
-    if (!package.good())
+    std::unique_ptr<PackageReader> packageReader;
+    try
+    {
+        packageReader = std::make_unique<PackageReader>(packageFilePath);
+    }
+    catch (const std::exception& e)
     {
         error(
             "Failed to open the PLDM fw update package file '{FILE}', error - {ERROR}.",
-            "ERROR", errno, "FILE", packageFilePath);
-        package.close();
+            "ERROR", e, "FILE", packageFilePath);
         std::filesystem::remove(packageFilePath);
         return -1;
     }
 
-    uintmax_t packageSize = package.tellg();
-
     auto swId = getSwId();
     objPath = swRootPath + swId;
 
@@ -80,21 +210,21 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
 
     try
     {
-        processStream(package, packageSize);
+        processStream(std::move(packageReader));
         return 0;
     }
     catch (sdbusplus::exception_t& e)
     {
         error("Exception occurred while processing the package: {ERROR}",
               "ERROR", e);
-        package.close();
+        package.reset();
         std::filesystem::remove(packageFilePath);
         return -1;
     }
 }
 
-std::string UpdateManager::processStreamDefer(std::istream& package,
-                                              uintmax_t packageSize)
+std::string UpdateManager::processStreamDefer(
+    std::unique_ptr<PackageReader> packageReader)
 {
     auto swId = getSwId();
     objPath = swRootPath + swId;
@@ -107,17 +237,21 @@ std::string UpdateManager::processStreamDefer(std::istream& package,
         throw sdbusplus::xyz::openbmc_project::Common::Error::Unavailable();
     }
 
+    package = std::move(packageReader);
     updateDeferHandler = std::make_unique<sdeventplus::source::Defer>(
-        event, [this, &package, packageSize](sdeventplus::source::EventBase&) {
-            this->processStream(package, packageSize);
+        event, [this](sdeventplus::source::EventBase&) {
+            this->processStream(std::move(package));
         });
 
     return objPath;
 }
 
-void UpdateManager::processStream(std::istream& package, uintmax_t packageSize)
+void UpdateManager::processStream(
+    std::unique_ptr<PackageReader> packageReader)
 {
     startTime = std::chrono::steady_clock::now();
+    package = std::move(packageReader);
+    auto packageSize = package->size();
     if (packageSize < sizeof(pldm_package_header_information))
     {
         error(
@@ -132,10 +266,12 @@ void UpdateManager::processStream(std::istream& package, uintmax_t packageSize)
             InvalidImage();
     }
 
-    package.seekg(0);
-    std::vector<uint8_t> packageHeader(packageSize);
-    package.read(reinterpret_cast<char*>(packageHeader.data()), packageSize);
-
+    auto packageData = package->getData();
+    std::ispanstream packageStream(
+        std::span(reinterpret_cast<const char*>(packageData.data()),
+                  packageData.size()),
+        std::ios::binary);
+    auto packageHeader = readPkgHeader(packageStream, packageSize);
     parser = parsePkgHeader(packageHeader);
     if (parser == nullptr)
     {
@@ -148,7 +284,6 @@ void UpdateManager::processStream(std::istream& package, uintmax_t packageSize)
             InvalidImage();
     }
 
-    package.seekg(0);
     try
     {
         parser->parse(packageHeader, packageSize);
@@ -179,10 +314,35 @@ void UpdateManager::processStream(std::istream& package, uintmax_t packageSize)
             Incompatible();
     }
 
+    // The Activation stays NotReady until the payload is verified
+    activation = std::make_unique<Activation>(
+        pldm::utils::DBusHandler::getBus(), objPath,
+        software::Activation::Activations::NotReady, this);
+    verifyPayload(*parser, package->getData(),
+                  [this, deviceUpdaterInfos =
+                             std::move(deviceUpdaterInfos)](bool valid) {
+                      payloadVerified(valid, deviceUpdaterInfos);
+                  });
+}
+
+void UpdateManager::payloadVerified(
+    bool valid, const DeviceUpdaterInfos& deviceUpdaterInfos)
+{
+    if (!valid)
+    {
+        error("Invalid PLDM fw update package payload");
+        activation->activation(software::Activation::Activations::Invalid);
+        parser.reset();
+        package.reset();
+        std::error_code ec;
+        std::filesystem::remove(fwPackageFilePath, ec);
+        return;
+    }
+
     const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
     const auto& compImageInfos = parser->getComponentImageInfos();
 
-    static constexpr uint32_t MAXIMUM_TRANSFER_SIZE = 4096;
+    auto maxTransferSize = getMaxTransferSize();
     for (const auto& deviceUpdaterInfo : deviceUpdaterInfos)
     {
         const auto& fwDeviceIDRecord =
@@ -191,15 +351,29 @@ void UpdateManager::processStream(std::istream& package, uintmax_t packageSize)
         deviceUpdaterMap.emplace(
             deviceUpdaterInfo.first,
             std::make_unique<DeviceUpdater>(
-                deviceUpdaterInfo.first, package, fwDeviceIDRecord,
-                compImageInfos, search->second, MAXIMUM_TRANSFER_SIZE, this));
+                deviceUpdaterInfo.first, *package, fwDeviceIDRecord,
+                compImageInfos, search->second, maxTransferSize, this));
     }
 
-    activation = std::make_unique<Activation>(
-        pldm::utils::DBusHandler::getBus(), objPath,
-        software::Activation::Activations::Ready, this);
+    progressBuckets.fill(0);
+    progressBuckets[0] = deviceUpdaterMap.size();
+    lastProgress = 0;
+    progressSum = 0;
+    lastEstimate = 0;
+    deviceMetrics.clear();
+
+    activation->activation(software::Activation::Activations::Ready);
     activationProgress = std::make_unique<ActivationProgress>(
         pldm::utils::DBusHandler::getBus(), objPath);
+    updateEstimate = std::make_unique<UpdateEstimate>(
+        pldm::utils::DBusHandler::getBus(), objPath);
+    deviceUpdateMetrics.clear();
+    for (const auto& [eid, deviceUpdater] : deviceUpdaterMap)
+    {
+        deviceUpdateMetrics.emplace(
+            eid, std::make_unique<DeviceUpdateMetrics>(
+                     pldm::utils::DBusHandler::getBus(), objPath, eid));
+    }
 
 #ifndef FW_UPDATE_INOTIFY_ENABLED
     activation->activation(software::Activation::Activations::Activating);
@@ -235,8 +409,41 @@ DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
 void UpdateManager::updateDeviceCompletion(mctp_eid_t eid, bool status)
 {
     deviceUpdateCompletionMap.emplace(eid, status);
+    auto search = deviceUpdaterMap.find(eid);
+    if (search != deviceUpdaterMap.end())
+    {
+        auto [metrics, inserted] =
+            deviceMetrics.emplace(eid, search->second->getMetrics());
+        auto deviceMetricsIntf = deviceUpdateMetrics.find(eid);
+        if (inserted && deviceMetricsIntf != deviceUpdateMetrics.end())
+        {
+            deviceMetricsIntf->second->update(metrics->second);
+        }
+    }
+    releaseTransfer(eid);
+    if (deviceUpdateHandler)
+    {
+        deviceUpdateHandler(eid);
+    }
     if (deviceUpdateCompletionMap.size() == deviceUpdaterMap.size())
     {
+        auto endTime = std::chrono::steady_clock::now();
+        auto dur =
+            std::chrono::duration<double, std::milli>(endTime - startTime)
+                .count();
+        info("Firmware update time: {DURATION}ms for {COUNT} devices",
+             "DURATION", dur, "COUNT", deviceUpdaterMap.size());
+
+        auto failed = std::ranges::any_of(
+            deviceUpdateCompletionMap,
+            [](const auto& completion) { return !completion.second; });
+        writeUpdateSummary(summaryDir, fs::path(objPath).filename().native(),
+                           getUpdateSummary(failed ? "Failed" : "Active"));
+        if (activationProgress)
+        {
+            activationProgress->reportCompletion(!failed);
+        }
+
         for (const auto& [eid, status] : deviceUpdateCompletionMap)
         {
             if (!status)
@@ -248,16 +455,28 @@ void UpdateManager::updateDeviceCompletion(mctp_eid_t eid, bool status)
             }
         }
 
-        auto endTime = std::chrono::steady_clock::now();
-        auto dur =
-            std::chrono::duration<double, std::milli>(endTime - startTime)
-                .count();
-        info("Firmware update time: {DURATION}ms", "DURATION", dur);
         activation->activation(software::Activation::Activations::Active);
     }
     return;
 }
 
+void UpdateManager::updateTransferCompletion(
+    mctp_eid_t eid, uint64_t transferBytes,
+    std::chrono::steady_clock::duration transferTime)
+{
+    auto seconds = std::chrono::duration<double>(transferTime).count();
+    if (transferBytes && seconds > 0)
+    {
+        transferRates[eid] = transferBytes / seconds;
+        info(
+            "Firmware transfer to endpoint ID {EID} took {DURATION}ms, {RATE} bytes/s",
+            "EID", eid, "DURATION", seconds * 1000, "RATE",
+            static_cast<uint64_t>(transferRates[eid]));
+    }
+
+    releaseTransfer(eid);
+}
+
 Response UpdateManager::handleRequest(mctp_eid_t eid, uint8_t command,
                                       const pldm_msg* request, size_t reqMsgLen)
 {
@@ -305,47 +524,251 @@ Response UpdateManager::handleRequest(mctp_eid_t eid, uint8_t command,
 void UpdateManager::activatePackage()
 {
     startTime = std::chrono::steady_clock::now();
+    if (activationProgress)
+    {
+        activationProgress->reportStart();
+    }
+    scheduleTransfers();
+}
+
+void UpdateManager::scheduleTransfers()
+{
+    pendingTransfers.clear();
+    activeTransfers.clear();
+    transferringDevices.clear();
+
+    // Devices never measured are assumed to be as fast as the average of the
+    // measured ones, so the first update is ordered by size
+    double defaultRate = 1;
+    if (!transferRates.empty())
+    {
+        double sum = 0;
+        for (const auto& [eid, rate] : transferRates)
+        {
+            sum += rate;
+        }
+        defaultRate = sum / transferRates.size();
+    }
+
+    std::vector<std::pair<double, mctp_eid_t>> transfers;
+    transfers.reserve(deviceUpdaterMap.size());
     for (const auto& [eid, deviceUpdaterPtr] : deviceUpdaterMap)
     {
-        deviceUpdaterPtr->startFwUpdateFlow();
+        auto search = transferRates.find(eid);
+        auto rate =
+            search != transferRates.end() ? search->second : defaultRate;
+        transfers.emplace_back(deviceUpdaterPtr->getTotalSize() / rate, eid);
+    }
+
+    // Starting the longest transfers first keeps the shorter ones, and the
+    // verify and apply phases, for the tail of the update
+    std::ranges::sort(transfers, std::ranges::greater{});
+    for (const auto& [estimate, eid] : transfers)
+    {
+        pendingTransfers[getNetworkId(eid)].push_back(eid);
+    }
+
+    for (const auto& [networkId, eids] : pendingTransfers)
+    {
+        startTransfers(networkId);
+    }
+}
+
+void UpdateManager::startTransfers(NetworkId networkId)
+{
+    constexpr size_t maxTransfers = FW_UPDATE_CONCURRENT_TRANSFERS;
+    auto& pending = pendingTransfers[networkId];
+    auto& active = activeTransfers[networkId];
+
+    while (!pending.empty() && (!maxTransfers || active < maxTransfers))
+    {
+        auto eid = pending.front();
+        pending.pop_front();
+        transferringDevices.emplace(eid, networkId);
+        ++active;
+        try
+        {
+            deviceUpdaterMap.at(eid)->startFwUpdateFlow();
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to start the firmware update of endpoint ID {EID}, error - {ERROR}",
+                "EID", eid, "ERROR", e);
+            updateDeviceCompletion(eid, false);
+        }
+    }
+}
+
+void UpdateManager::releaseTransfer(mctp_eid_t eid)
+{
+    auto search = transferringDevices.find(eid);
+    if (search == transferringDevices.end())
+    {
+        return;
+    }
+
+    auto networkId = search->second;
+    transferringDevices.erase(search);
+    auto& active = activeTransfers[networkId];
+    if (active)
+    {
+        --active;
+    }
+    startTransfers(networkId);
+}
+
+NetworkId UpdateManager::getNetworkId(mctp_eid_t eid) const
+{
+    auto search = endpointNetworks.find(eid);
+    return search != endpointNetworks.end() ? search->second : NetworkId{};
+}
+
+void UpdateManager::addEndpoints(const MctpInfos& mctpInfos)
+{
+    for (const auto& mctpInfo : mctpInfos)
+    {
+        endpointNetworks[std::get<pldm::eid>(mctpInfo)] =
+            std::get<NetworkId>(mctpInfo);
+    }
+}
+
+void UpdateManager::removeEndpoints(const MctpInfos& mctpInfos)
+{
+    for (const auto& mctpInfo : mctpInfos)
+    {
+        auto eid = std::get<pldm::eid>(mctpInfo);
+        endpointNetworks.erase(eid);
+        transferRates.erase(eid);
     }
 }
 
 void UpdateManager::resetActivationState()
 {
+    cancelPayloadVerification();
     activation.reset();
     activationProgress.reset();
+    updateEstimate.reset();
+    deviceUpdateMetrics.clear();
     objPath.clear();
 
-    if (package.is_open())
-    {
-        package.close();
-    }
     deviceUpdaterMap.clear();
+    package.reset();
     deviceUpdateCompletionMap.clear();
     parser.reset();
     std::filesystem::remove(fwPackageFilePath);
     totalNumComponentUpdates = 0;
+    progressBuckets.fill(0);
+    lastProgress = 0;
+    progressSum = 0;
+    lastEstimate = 0;
+    deviceMetrics.clear();
+    pendingTransfers.clear();
+    activeTransfers.clear();
+    transferringDevices.clear();
 }
 
-void UpdateManager::updateActivationProgress()
+void UpdateManager::updateActivationProgress(
+    mctp_eid_t eid, uint8_t previousProgress, uint8_t progress)
 {
-    using mapEl = std::pair<const mctp_eid_t, std::unique_ptr<DeviceUpdater>>;
-    auto min = std::ranges::min_element(
-        deviceUpdaterMap, [](const mapEl& lhs, const mapEl& rhs) {
-            return lhs.second->getProgress() < rhs.second->getProgress();
-        });
+    if (previousProgress >= progressBuckets.size() ||
+        progress >= progressBuckets.size() ||
+        !progressBuckets[previousProgress])
+    {
+        return;
+    }
+
+    --progressBuckets[previousProgress];
+    ++progressBuckets[progress];
+    progressSum = progressSum + progress - previousProgress;
+    reportEstimatedCompletion();
+
+    auto deviceUpdater = deviceUpdaterMap.find(eid);
+    auto deviceMetricsIntf = deviceUpdateMetrics.find(eid);
+    if (deviceUpdater != deviceUpdaterMap.end() &&
+        deviceMetricsIntf != deviceUpdateMetrics.end())
+    {
+        deviceMetricsIntf->second->update(deviceUpdater->second->getMetrics());
+    }
+
+    // Devices only move forward, the slowest one is at or above the last
+    // reported progress unless this device was reported below it
+    size_t minProgress = std::min(lastProgress, progress);
+    while (minProgress < progressBuckets.size() - 1 &&
+           !progressBuckets[minProgress])
+    {
+        ++minProgress;
+    }
+
+    if (minProgress != lastProgress && activationProgress)
+    {
+        lastProgress = static_cast<uint8_t>(minProgress);
+        activationProgress->reportProgress(lastProgress);
+    }
+}
+
+pldm::utils::Json UpdateManager::getUpdateSummary(std::string_view status) const
+{
+    pldm::utils::Json devices = pldm::utils::Json::array();
+    for (const auto& [eid, deviceUpdater] : deviceUpdaterMap)
+    {
+        auto completion = deviceUpdateCompletionMap.find(eid);
+        std::string_view deviceStatus = "InProgress";
+        if (completion != deviceUpdateCompletionMap.end())
+        {
+            deviceStatus = completion->second ? "Succeeded" : "Failed";
+        }
 
-    if (min == deviceUpdaterMap.end())
+        // Completed devices are reported as they completed, a failed device
+        // would otherwise keep accounting time to its last phase
+        auto metrics = deviceMetrics.find(eid);
+        devices.push_back(getDeviceUpdateSummary(
+            eid,
+            metrics != deviceMetrics.end() ? metrics->second
+                                           : deviceUpdater->getMetrics(),
+            deviceStatus));
+    }
+
+    pldm::utils::Json summary;
+    summary["Status"] = std::string(status);
+    summary["ObjectPath"] = objPath;
+    summary["DurationMs"] =
+        toMilliseconds(std::chrono::steady_clock::now() - startTime);
+    summary["Progress"] = lastProgress;
+    summary["Devices"] = std::move(devices);
+    return summary;
+}
+
+void UpdateManager::reportEstimatedCompletion()
+{
+    if (deviceUpdaterMap.empty())
     {
         return;
     }
 
-    uint8_t progress = min->second->getProgress();
-    if (progress != lastProgress)
+    auto average = progressSum / deviceUpdaterMap.size();
+    auto estimate = static_cast<uint8_t>(average / 10);
+    if (estimate <= lastEstimate || average >= 100)
+    {
+        return;
+    }
+    lastEstimate = estimate;
+
+    // The devices progress concurrently, the rest of the update is expected
+    // to go at the average pace so far
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+    auto remaining = static_cast<uint64_t>(elapsed * (100 - average) / average);
+    info(
+        "Firmware update at {PROGRESS}% after {ELAPSED}s, estimated completion in {REMAINING}s",
+        "PROGRESS", average, "ELAPSED", static_cast<uint64_t>(elapsed),
+        "REMAINING", remaining);
+
+    if (updateEstimate)
     {
-        activationProgress->progress(progress);
-        lastProgress = progress;
+        updateEstimate->reportEstimatedCompletion(
+            std::chrono::seconds(remaining));
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "common/instance_id.hpp"
 #include "common/types.hpp"
+#include "common/utils.hpp"
 #include "device_updater.hpp"
 #include "fw-update/activation.hpp"
 #include "fw-update/update.hpp"
@@ -9,6 +10,7 @@
 #include "fw-update/watch.hpp"
 #endif
 #include "package_parser.hpp"
+#include "package_reader.hpp"
 #include "requester/handler.hpp"
 
 #include <libpldm/base.h>
@@ -17,9 +19,14 @@
 #include <sdbusplus/server/object.hpp>
 #include <xyz/openbmc_project/Software/Activation/server.hpp>
 
+#include <array>
 #include <chrono>
+#include <deque>
 #include <filesystem>
-#include <fstream>
+#include <functional>
+#include <map>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 
 namespace pldm
@@ -37,6 +44,45 @@ using DeviceUpdaterInfo = std::pair<mctp_eid_t, DeviceIDRecordOffset>;
 using DeviceUpdaterInfos = std::vector<DeviceUpdaterInfo>;
 using TotalComponentUpdates = size_t;
 
+/** @brief Callback invoked when the update of a device completes, successfully
+ *         or not, the firmware of the device may have changed
+ */
+using DeviceUpdateHandler = std::function<void(mctp_eid_t eid)>;
+
+/** @brief Callback invoked with the outcome of the verification of a package
+ *         payload
+ */
+using PayloadVerifiedHandler = std::function<void(bool valid)>;
+
+/** @brief Summarize the update of a firmware device
+ *
+ *  @param[in] eid - Endpoint ID of the firmware device
+ *  @param[in] metrics - timing and throughput of the update of the device
+ *  @param[in] status - outcome of the update of the device
+ *
+ *  @return JSON object with the phase timing, throughput and retransmissions
+ */
+pldm::utils::Json getDeviceUpdateSummary(mctp_eid_t eid,
+                                         const UpdateMetrics& metrics,
+                                         std::string_view status);
+
+/** @brief Maximum number of update summaries kept, the oldest are removed */
+constexpr size_t maxUpdateSummaries = 16;
+
+/** @brief Write the summary of a firmware update to its own file, replacing
+ *         the previous summary of the same update. Only the summaries of the
+ *         most recent updates are kept.
+ *
+ *  @param[in] dir - directory to write the summary to, nothing is written if
+ *                   empty
+ *  @param[in] updateId - identifier of the update, the software ID of its
+ *                        D-Bus object, the file is named after it
+ *  @param[in] summary - summary of the firmware update
+ */
+void writeUpdateSummary(const std::filesystem::path& dir,
+                        std::string_view updateId,
+                        const pldm::utils::Json& summary);
+
 /**
  * @brief The base class of the UpdateManager and the
  *        ItemBaseUpdateManager
@@ -65,13 +111,61 @@ class UpdateManagerBase
     {}
 
     virtual void updateDeviceCompletion(mctp_eid_t eid, bool status) = 0;
-    virtual void updateActivationProgress() = 0;
+
+    /** @brief Report a change of the progress of a device
+     *
+     *  @param[in] eid - Endpoint ID of the firmware device
+     *  @param[in] previousProgress - previous progress of the device
+     *  @param[in] progress - progress of the device, in percent
+     */
+    virtual void updateActivationProgress(
+        mctp_eid_t eid, uint8_t previousProgress, uint8_t progress) = 0;
+
+    /** @brief Report that a device received its last component image, the
+     *         device moves on to verify and apply
+     *
+     *  @param[in] eid - Endpoint ID of the firmware device
+     *  @param[in] transferBytes - component image bytes sent to the device
+     *  @param[in] transferTime - time spent serving RequestFirmwareData
+     */
+    virtual void updateTransferCompletion(
+        mctp_eid_t eid, uint64_t transferBytes,
+        std::chrono::steady_clock::duration transferTime) = 0;
     virtual void activatePackage() = 0;
     virtual void resetActivationState() = 0;
 
     Event& event;               //!< reference to PLDM daemon's main event loop
     pldm::requester::Handler<pldm::requester::Request>& handler;
     InstanceIdDb& instanceIdDb; //!< reference to an InstanceIdDb
+
+  protected:
+    /** @brief Verify the payload checksum of a package from the event loop,
+     *         a chunk per iteration, replacing any verification in progress
+     *
+     *  @param[in] parser - parser of the package header
+     *  @param[in] package - the whole firmware update package, both must
+     *                       outlive the verification
+     *  @param[in] callback - invoked with the outcome once the whole payload
+     *                        is checked
+     */
+    void verifyPayload(const PackageParser& parser,
+                       std::span<const uint8_t> package,
+                       PayloadVerifiedHandler callback);
+
+    /** @brief Stop the verification in progress, its callback is not
+     *         invoked
+     */
+    void cancelPayloadVerification();
+
+  private:
+    /** @brief Verifier of the package payload in progress */
+    std::unique_ptr<PayloadVerifier> payloadVerifier;
+
+    /** @brief Invoked when the verification in progress completes */
+    PayloadVerifiedHandler payloadVerifiedHandler;
+
+    /** @brief Event source checking a chunk of the payload per iteration */
+    std::unique_ptr<sdeventplus::source::Defer> payloadVerifierHandler;
 };
 
 class UpdateManager : public UpdateManagerBase
@@ -84,12 +178,28 @@ class UpdateManager : public UpdateManagerBase
     UpdateManager& operator=(UpdateManager&&) = delete;
     virtual ~UpdateManager() = default;
 
+    /** @brief Constructor
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] handler - PLDM request handler
+     *  @param[in] instanceIdDb - Managing instance ID for PLDM requests
+     *  @param[in] descriptorMap - Device identifiers of the managed FDs
+     *  @param[in] componentInfoMap - Component information of the managed FDs
+     *  @param[in] deviceUpdateHandler - Invoked when the update of a device
+     *                                   completes
+     *  @param[in] summaryDir - directory the summary of each update is written
+     *                          to, empty to not write it
+     */
     explicit UpdateManager(
         Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, const DescriptorMap& descriptorMap,
-        const ComponentInfoMap& componentInfoMap) :
+        const ComponentInfoMap& componentInfoMap,
+        DeviceUpdateHandler deviceUpdateHandler = {},
+        std::filesystem::path summaryDir = {}) :
         UpdateManagerBase(event, handler, instanceIdDb),
+        deviceUpdateHandler(std::move(deviceUpdateHandler)),
+        summaryDir(std::move(summaryDir)),
         descriptorMap(descriptorMap), componentInfoMap(componentInfoMap),
 #ifdef FW_UPDATE_INOTIFY_ENABLED
         watch(event.get(),
@@ -122,26 +232,27 @@ class UpdateManager : public UpdateManagerBase
 
     /** @brief Process the firmware update package
      *
-     *  @param[in] packageStream - Stream of the firmware update package
-     *  @param[in] packageSize - Size of the firmware update package
-     *
-     *  @return Object path of the created Software object
+     *  @param[in] packageReader - Reader of the firmware update package
      */
-    void processStream(std::istream& packageStream, uintmax_t packageSize);
+    void processStream(std::unique_ptr<PackageReader> packageReader);
 
     /** @brief Defers processing the package stream
      *
-     *  @param[in] packageStream - Stream of the firmware update package
-     *  @param[in] packageSize - Size of the firmware update package
+     *  @param[in] packageReader - Reader of the firmware update package
      *
      *  @return Object path of the created Software object as a string
      */
-    std::string processStreamDefer(std::istream& packageStream,
-                                   uintmax_t packageSize);
+    std::string processStreamDefer(
+        std::unique_ptr<PackageReader> packageReader);
 
     void updateDeviceCompletion(mctp_eid_t eid, bool status) override;
 
-    void updateActivationProgress() override;
+    void updateActivationProgress(mctp_eid_t eid, uint8_t previousProgress,
+                                  uint8_t progress) override;
+
+    void updateTransferCompletion(
+        mctp_eid_t eid, uint64_t transferBytes,
+        std::chrono::steady_clock::duration transferTime) override;
 
     /** @brief Callback function that will be invoked when the
      *         RequestedActivation will be set to active in the Activation
@@ -151,6 +262,19 @@ class UpdateManager : public UpdateManagerBase
 
     void resetActivationState() override;
 
+    /** @brief Record the MCTP network of the discovered endpoints, the
+     *         component image transfers are limited per network
+     *
+     *  @param[in] mctpInfos - information of discovered MCTP endpoints
+     */
+    void addEndpoints(const MctpInfos& mctpInfos);
+
+    /** @brief Forget the MCTP network of the removed endpoints
+     *
+     *  @param[in] mctpInfos - information of removed MCTP endpoints
+     */
+    void removeEndpoints(const MctpInfos& mctpInfos);
+
     /** @brief
      *
      */
@@ -169,6 +293,13 @@ class UpdateManager : public UpdateManagerBase
 
     std::unique_ptr<Activation> activation;
 
+  protected:
+    /** @brief Invoked when the update of a device completes */
+    DeviceUpdateHandler deviceUpdateHandler;
+
+    /** @brief Directory the summary of each update is written to */
+    std::filesystem::path summaryDir;
+
   private:
     /** @brief Device identifiers of the managed FDs */
     const DescriptorMap& descriptorMap;
@@ -181,11 +312,23 @@ class UpdateManager : public UpdateManagerBase
 #endif
 
     std::unique_ptr<ActivationProgress> activationProgress;
+
+    /** @brief Estimated completion time of the update */
+    std::unique_ptr<UpdateEstimate> updateEstimate;
+
+    /** @brief D-Bus objects with the metrics of the device updates */
+    std::unordered_map<mctp_eid_t, std::unique_ptr<DeviceUpdateMetrics>>
+        deviceUpdateMetrics;
+
     std::string objPath;
 
     std::filesystem::path fwPackageFilePath;
     std::unique_ptr<PackageParser> parser;
-    std::ifstream package;
+
+    /** @brief Reader of the firmware update package, shared by all the
+     *         DeviceUpdaters
+     */
+    std::unique_ptr<PackageReader> package;
 
     std::unordered_map<mctp_eid_t, std::unique_ptr<DeviceUpdater>>
         deviceUpdaterMap;
@@ -203,7 +346,93 @@ class UpdateManager : public UpdateManagerBase
      * dbus
      *
      */
-    uint8_t lastProgress;
+    uint8_t lastProgress = 0;
+
+    /** @brief Number of devices at each percentage of progress, the
+     *         activation progress is the lowest non-empty one
+     */
+    std::array<size_t, 101> progressBuckets{};
+
+    /** @brief Sum of the progress of the devices, for the estimated
+     *         completion time
+     */
+    size_t progressSum = 0;
+
+    /** @brief The last average progress, in tens of percent, the estimated
+     *         completion time was reported at
+     */
+    uint8_t lastEstimate = 0;
+
+    /** @brief Metrics of the devices whose update completed */
+    std::unordered_map<mctp_eid_t, UpdateMetrics> deviceMetrics;
+
+    /** @brief Summarize the update of the package
+     *
+     *  @param[in] status - outcome of the update
+     *
+     *  @return JSON object with the duration and the summary of every device
+     */
+    pldm::utils::Json getUpdateSummary(std::string_view status) const;
+
+    /** @brief Create the DeviceUpdaters and make the Activation Ready once
+     *         the package payload is verified, or mark it Invalid
+     *
+     *  @param[in] valid - whether the payload matches its checksum
+     *  @param[in] deviceUpdaterInfos - devices the package applies to
+     */
+    void payloadVerified(bool valid,
+                         const DeviceUpdaterInfos& deviceUpdaterInfos);
+
+    /** @brief Estimate the completion time of the update from the average
+     *         progress of the devices, reported at every ten percent
+     */
+    void reportEstimatedCompletion();
+
+    /** @brief Queue the devices of the package per MCTP network, the devices
+     *         expected to transfer the longest first, and start as many as
+     *         the networks allow
+     */
+    void scheduleTransfers();
+
+    /** @brief Start the queued devices of a network while it has free
+     *         transfer slots
+     *
+     *  @param[in] networkId - MCTP network of the devices
+     */
+    void startTransfers(NetworkId networkId);
+
+    /** @brief Free the transfer slot held by a device and start the next
+     *         device of its network
+     *
+     *  @param[in] eid - Endpoint ID of the firmware device
+     */
+    void releaseTransfer(mctp_eid_t eid);
+
+    /** @brief Get the MCTP network of an endpoint
+     *
+     *  @param[in] eid - Endpoint ID of the firmware device
+     *
+     *  @return the network of the endpoint, the default network if unknown
+     */
+    NetworkId getNetworkId(mctp_eid_t eid) const;
+
+    /** @brief MCTP network of the discovered endpoints */
+    std::unordered_map<mctp_eid_t, NetworkId> endpointNetworks;
+
+    /** @brief Component image throughput in bytes per second measured on the
+     *         last update of each device, kept across packages to order the
+     *         transfers
+     */
+    std::unordered_map<mctp_eid_t, double> transferRates;
+
+    /** @brief Devices waiting for a transfer slot, per MCTP network */
+    std::map<NetworkId, std::deque<mctp_eid_t>> pendingTransfers;
+
+    /** @brief Number of devices transferring, per MCTP network */
+    std::map<NetworkId, size_t> activeTransfers;
+
+    /** @brief Devices holding a transfer slot and their MCTP network */
+    std::unordered_map<mctp_eid_t, NetworkId> transferringDevices;
 };
 
 } // namespace fw_update
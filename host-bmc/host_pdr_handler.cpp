@@ -1,5 +1,6 @@
 #include "host_pdr_handler.hpp"
 
+#include "common/pdr_journal.hpp"
 #include "common/types.hpp"
 #include "host-bmc/utils.hpp"
 
@@ -125,11 +126,14 @@ HostPDRHandler::HostPDRHandler(
                     // when the host is powered off, set the availability
                     // state of all the dbus objects to false
                     this->setPresenceFrus();
-                    pldm_pdr_remove_remote_pdrs(repo);
+                    pldm::utils::recordPDRDelta(
+                        this->pdrJournal, repo,
+                        [repo] { pldm_pdr_remove_remote_pdrs(repo); });
                     pldm_entity_association_tree_destroy_root(entityTree);
                     pldm_entity_association_tree_copy_root(bmcEntityTree,
                                                            entityTree);
                     this->sensorMap.clear();
+                    this->announcedRecordHandles.clear();
                     this->responseReceived = false;
                     this->mergedHostParents = false;
 
@@ -162,19 +166,13 @@ void HostPDRHandler::setPresenceFrus()
     }
 }
 
-void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles)
+void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles,
+                              PDRRecordHandles&& modifiedRecordHandles)
 {
-    pdrRecordHandles.clear();
-    modifiedPDRRecordHandles.clear();
-
-    if (isHostPdrModified)
-    {
-        modifiedPDRRecordHandles = std::move(recordHandles);
-    }
-    else
-    {
-        pdrRecordHandles = std::move(recordHandles);
-    }
+    pdrRecordHandles = std::move(recordHandles);
+    modifiedPDRRecordHandles = std::move(modifiedRecordHandles);
+    isHostPdrModified = !modifiedPDRRecordHandles.empty();
+    fetchAllPDRs = pdrRecordHandles.empty() && modifiedPDRRecordHandles.empty();
 
     // Defer the actual fetch of PDRs from the host (by queuing the call on the
     // main event loop). That way, we can respond to the platform event msg from
@@ -272,7 +270,10 @@ void HostPDRHandler::mergeEntityAssociations(
     {
         // Adding the remote range PDRs to the repo before merging it
         uint32_t handle = record_handle;
-        pldm_pdr_add(repo, pdr.data(), size, true, 0xFFFF, &handle);
+        if (!pldm_pdr_add(repo, pdr.data(), size, true, 0xFFFF, &handle))
+        {
+            recordPDRChange(PLDM_RECORDS_ADDED, handle);
+        }
     }
 
     pldm_entity_association_pdr_extract(pdr.data(), pdr.size(), &numEntities,
@@ -348,11 +349,19 @@ void HostPDRHandler::mergeEntityAssociations(
                     pldm_entity_association_pdr_add_from_node_with_record_handle(
                         node, repo, &entities, numEntities, true,
                         TERMINUS_HANDLE, (record_handle + 1));
+                if (!rc)
+                {
+                    recordPDRChange(PLDM_RECORDS_ADDED, record_handle + 1);
+                }
             }
             else
             {
-                rc = pldm_entity_association_pdr_add_from_node(
-                    node, repo, &entities, numEntities, true, TERMINUS_HANDLE);
+                // The handle of the added PDR is not returned
+                pldm::utils::recordPDRDelta(pdrJournal, repo, [&] {
+                    rc = pldm_entity_association_pdr_add_from_node(
+                        node, repo, &entities, numEntities, true,
+                        TERMINUS_HANDLE);
+                });
             }
 
             if (rc)
@@ -386,12 +395,16 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
                                                   nullptr, nullptr);
             if (record && pldm_pdr_record_is_remote(record))
             {
-                changeEntries[0].push_back(
-                    pldm_pdr_get_record_handle(repo, record));
+                auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+                // Only announce the records the host has not fetched yet
+                if (announcedRecordHandles.emplace(recordHandle).second)
+                {
+                    changeEntries[0].push_back(recordHandle);
+                }
             }
         } while (record);
     }
-    if (changeEntries.empty())
+    if (changeEntries[0].empty())
     {
         return;
     }
@@ -647,6 +660,7 @@ void HostPDRHandler::processHostPDRs(
                 {
                     pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid,
                                            tlValid);
+                    recordTLPDRUpdate(terminusHandle, tid, tlEid);
 
                     if (!isHostUp())
                     {
@@ -658,6 +672,17 @@ void HostPDRHandler::processHostPDRs(
                 }
                 else
                 {
+                    if (!fetchAllPDRs)
+                    {
+                        // An announced record replaces the copy of it that
+                        // may already be in the repo, both are kept under
+                        // the handle the host gave the record
+                        rh = pdrHdr->record_handle;
+                        if (!pldm_pdr_delete_by_record_handle(repo, rh, true))
+                        {
+                            recordPDRChange(PLDM_RECORDS_DELETED, rh);
+                        }
+                    }
                     rc = pldm_pdr_add(repo, pdr.data(), respCount, true,
                                       pdrTerminusHandle, &rh);
                     if (rc)
@@ -665,12 +690,21 @@ void HostPDRHandler::processHostPDRs(
                         // pldm_pdr_add() assert()ed on failure to add a PDR.
                         throw std::runtime_error("Failed to add PDR");
                     }
+                    recordPDRChange(PLDM_RECORDS_ADDED, rh);
                 }
             }
         }
     }
+    if (!fetchAllPDRs && pdrRecordHandles.empty() &&
+        modifiedPDRRecordHandles.empty())
+    {
+        // Only the announced records are fetched, not the rest of the host
+        // repository that follows them
+        nextRecordHandle = 0;
+    }
     if (!nextRecordHandle)
     {
+        isHostPdrModified = false;
         updateEntityAssociation(entityAssociations, entityTree, objPathMap,
                                 entityMaps, oemPlatformHandler);
         if (oemUtilsHandler)
@@ -701,19 +735,14 @@ void HostPDRHandler::processHostPDRs(
     }
     else
     {
-        if (modifiedPDRRecordHandles.empty() && isHostPdrModified)
+        if (modifiedPDRRecordHandles.empty())
         {
             isHostPdrModified = false;
         }
-        else
-        {
-            deferredFetchPDREvent =
-                std::make_unique<sdeventplus::source::Defer>(
-                    event,
-                    std::bind(
-                        std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
-                        this, nextRecordHandle, std::placeholders::_1));
-        }
+        deferredFetchPDREvent = std::make_unique<sdeventplus::source::Defer>(
+            event,
+            std::bind(std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
+                      this, nextRecordHandle, std::placeholders::_1));
     }
 }
 
@@ -730,16 +759,16 @@ void HostPDRHandler::_processFetchPDREvent(
     uint32_t nextRecordHandle, sdeventplus::source::EventBase& /*source */)
 {
     deferredFetchPDREvent.reset();
-    if (!this->pdrRecordHandles.empty())
-    {
-        nextRecordHandle = this->pdrRecordHandles.front();
-        this->pdrRecordHandles.pop_front();
-    }
     if (isHostPdrModified && (!this->modifiedPDRRecordHandles.empty()))
     {
         nextRecordHandle = this->modifiedPDRRecordHandles.front();
         this->modifiedPDRRecordHandles.pop_front();
     }
+    else if (!this->pdrRecordHandles.empty())
+    {
+        nextRecordHandle = this->pdrRecordHandles.front();
+        this->pdrRecordHandles.pop_front();
+    }
     this->getHostPDR(nextRecordHandle);
 }
 
@@ -1263,6 +1292,46 @@ void HostPDRHandler::createDbusObjects(const PDRList& fruRecordSetPDRs)
     getFRURecordTableMetadataByRemote(fruRecordSetPDRs);
 }
 
+void HostPDRHandler::recordPDRChange(uint8_t eventDataOp,
+                                     uint32_t recordHandle)
+{
+    if (pdrJournal)
+    {
+        pdrJournal->recordChange(eventDataOp, recordHandle);
+    }
+}
+
+void HostPDRHandler::recordTLPDRUpdate(uint16_t terminusHandle, uint8_t tid,
+                                       uint8_t tlEid)
+{
+    if (!pdrJournal)
+    {
+        return;
+    }
+
+    // Same match as pldm_pdr_update_TL_pdr()
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize{};
+    const pldm_pdr_record* record = nullptr;
+    while ((record = pldm_pdr_find_record_by_type(
+                repo, PLDM_TERMINUS_LOCATOR_PDR, record, &pdrData, &pdrSize)))
+    {
+        if (pdrSize < sizeof(pldm_terminus_locator_pdr))
+        {
+            continue;
+        }
+        auto tlpdr =
+            std::start_lifetime_as<pldm_terminus_locator_pdr>(pdrData);
+        if (tlpdr->terminus_handle == terminusHandle && tlpdr->tid == tid &&
+            tlpdr->terminus_locator_value[0] == tlEid)
+        {
+            pdrJournal->recordChange(PLDM_RECORDS_MODIFIED,
+                                     pldm_pdr_get_record_handle(repo, record));
+            return;
+        }
+    }
+}
+
 void HostPDRHandler::deletePDRFromRepo(PDRRecordHandles&& recordHandles)
 {
     for (auto& recordHandle : recordHandles)
@@ -1272,7 +1341,9 @@ void HostPDRHandler::deletePDRFromRepo(PDRRecordHandles&& recordHandles)
         {
             error("Failed to delete the record handle: {REC_HANDLE}",
                   "REC_HANDLE", recordHandle);
+            continue;
         }
+        recordPDRChange(PLDM_RECORDS_DELETED, recordHandle);
     }
 }
 
@@ -17,6 +17,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 namespace pldm
@@ -97,10 +98,14 @@ class HostPDRHandler
 
     /** @brief fetch PDRs from host firmware. See @class.
      *  @param[in] recordHandles - list of record handles pointing to host's
-     *             PDRs that need to be fetched.
+     *             PDRs that were added and need to be fetched.
+     *  @param[in] modifiedRecordHandles - list of record handles pointing to
+     *             host's PDRs that were modified and need to be refetched.
+     *  @note Only the listed records are fetched. Without any record handle,
+     *        the entire host repository is fetched.
      */
-
-    void fetchPDR(PDRRecordHandles&& recordHandles);
+    void fetchPDR(PDRRecordHandles&& recordHandles,
+                  PDRRecordHandles&& modifiedRecordHandles = {});
 
     /** @brief delete PDRs from remote pldm endpoint.
      *  @param[in] recordHandles - list of record handles pointing to remote
@@ -193,10 +198,38 @@ class HostPDRHandler
         oemUtilsHandler = handler;
     }
 
+    /** @brief Set the change journal the changes of the host PDRs in the
+     *         repository are recorded in
+     *
+     *  @param[in] journal - change journal of the PDR repository
+     */
+    inline void setPDRJournal(pldm::utils::PDRJournal* journal)
+    {
+        pdrJournal = journal;
+    }
+
     /** @brief map that captures various terminus information **/
     TLPDRMap tlPDRInfo;
 
   private:
+    /** @brief Record a change of a PDR record in the change journal, if set
+     *
+     *  @param[in] eventDataOp - PLDM_RECORDS_ADDED, PLDM_RECORDS_DELETED or
+     *                           PLDM_RECORDS_MODIFIED
+     *  @param[in] recordHandle - handle of the changed PDR record
+     */
+    void recordPDRChange(uint8_t eventDataOp, uint32_t recordHandle);
+
+    /** @brief Record the update of the terminus locator PDR made by
+     *         pldm_pdr_update_TL_pdr() in the change journal, if set
+     *
+     *  @param[in] terminusHandle - terminus handle of the PDR
+     *  @param[in] tid - terminus ID of the PDR
+     *  @param[in] tlEid - MCTP EID of the terminus locator of the PDR
+     */
+    void recordTLPDRUpdate(uint16_t terminusHandle, uint8_t tid,
+                           uint8_t tlEid);
+
     /** @brief deferred function to fetch PDR from Host, scheduled to work on
      *  the event loop. The PDR exchg with the host is async.
      *  @param[in] source - sdeventplus event source
@@ -299,6 +332,8 @@ class HostPDRHandler
     sdeventplus::Event& event;
     /** @brief pointer to BMC's primary PDR repo, host PDRs are added here */
     pldm_pdr* repo;
+    /** @brief change journal of the repo, nullptr if not tracked */
+    pldm::utils::PDRJournal* pdrJournal = nullptr;
 
     pldm::responder::events::StateSensorHandler stateSensorHandler;
     /** @brief Pointer to BMC's and Host's entity association tree */
@@ -326,6 +361,17 @@ class HostPDRHandler
     /** @brief list of PDR record handles modified pointing to host PDRs */
     PDRRecordHandles modifiedPDRRecordHandles;
 
+    /** @brief whether the entire host repository is being fetched, rather
+     *         than the records listed in pdrRecordHandles and
+     *         modifiedPDRRecordHandles
+     */
+    bool fetchAllPDRs = true;
+
+    /** @brief record handles of the merged entity association PDRs already
+     *         announced to the host firmware
+     */
+    std::set<ChangeEntry> announcedRecordHandles;
+
     /** @brief D-Bus property changed signal match */
     std::unique_ptr<sdbusplus::match> hostOffMatch;
 
@@ -1,11 +1,15 @@
 #include "bios.hpp"
 
+#include "common/multipart_transfer.hpp"
 #include "common/utils.hpp"
 
+#include <libpldm/platform.h>
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Time/EpochTime/common.hpp>
 #include <xyz/openbmc_project/Time/Synchronization/common.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <string>
@@ -67,16 +71,29 @@ namespace bios
 {
 using EpochTimeUS = uint64_t;
 
+namespace
+{
+
+/** @brief Maximum size of a table set in multiple parts. The tables built
+ *         from the BIOS JSONs are a few KiB.
+ */
+constexpr size_t maxSetTableSize = 1024 * 1024;
+
+} // namespace
+
 DBusHandler dbusHandler;
 
 Handler::Handler(
     int fd, uint8_t eid, pldm::InstanceIdDb* instanceIdDb,
     pldm::requester::Handler<pldm::requester::Request>* handler,
     pldm::responder::platform_config::Handler* platformConfigHandler,
-    pldm::responder::bios::Callback requestPLDMServiceName) :
-    biosConfig(BIOS_JSONS_DIR, BIOS_TABLES_DIR, &dbusHandler, fd, eid,
+    pldm::responder::bios::Callback requestPLDMServiceName,
+    const char* jsonDir, const char* tableDir,
+    pldm::utils::DBusHandler* dBusIntf, size_t transferSize) :
+    biosConfig(jsonDir, tableDir, dBusIntf ? dBusIntf : &dbusHandler, fd, eid,
                instanceIdDb, handler, platformConfigHandler,
-               requestPLDMServiceName)
+               requestPLDMServiceName),
+    transferSize(transferSize)
 {
     handlers.emplace(
         PLDM_SET_DATE_TIME,
@@ -224,6 +241,63 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
     return ccOnlyResponse(request, PLDM_SUCCESS);
 }
 
+const std::vector<Response>* Handler::getBIOSTableResponses(uint8_t tableType)
+{
+    if (tableType >= tableResponses.size())
+    {
+        return nullptr;
+    }
+
+    auto type = static_cast<pldm_bios_table_types>(tableType);
+    auto version = biosConfig.getBIOSTableVersion(type);
+    auto& cached = tableResponses[tableType];
+    if (!cached.responses.empty() && cached.version == version)
+    {
+        return &cached.responses;
+    }
+
+    cached.responses.clear();
+    auto table = biosConfig.getBIOSTable(type);
+    if (!table)
+    {
+        return nullptr;
+    }
+
+    auto partSize =
+        multipart::getPartSize(table->size(), transferSize);
+    auto numParts = multipart::getNumParts(table->size(), partSize);
+
+    for (size_t part = 0; part < numParts; ++part)
+    {
+        auto offset = part * partSize;
+        auto length = std::min(partSize, table->size() - offset);
+        auto transferFlag = multipart::getTransferFlag(part, numParts);
+        auto nextTransferHandle =
+            multipart::getNextTransferHandle(version, part, numParts);
+
+        Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + length);
+        auto responsePtr = new (response.data()) pldm_msg;
+        auto rc = encode_get_bios_table_resp(
+            0 /* instanceId, set per request */, PLDM_SUCCESS,
+            nextTransferHandle, transferFlag, table->data() + offset,
+            response.size(), responsePtr);
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to encode BIOS table type {TYPE}, response code '{RC}'",
+                "TYPE", tableType, "RC", rc);
+            cached.responses.clear();
+            return nullptr;
+        }
+
+        cached.responses.push_back(std::move(response));
+    }
+
+    cached.version = version;
+    return &cached.responses;
+}
+
 Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
 {
     uint32_t transferHandle{};
@@ -237,25 +311,35 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    auto table =
-        biosConfig.getBIOSTable(static_cast<pldm_bios_table_types>(tableType));
-    if (!table)
+    if (transferOpFlag != PLDM_GET_FIRSTPART &&
+        transferOpFlag != PLDM_GET_NEXTPART)
     {
-        return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        return ccOnlyResponse(request,
+                              PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG);
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
-    auto responsePtr = new (response.data()) pldm_msg;
+    auto responses = getBIOSTableResponses(tableType);
+    if (!responses)
+    {
+        return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+    }
 
-    rc = encode_get_bios_table_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0 /* nxtTransferHandle */,
-        PLDM_START_AND_END, table->data(), response.size(), responsePtr);
-    if (rc != PLDM_SUCCESS)
+    auto part = multipart::getRequestedPart(
+        transferOpFlag, transferHandle, tableResponses[tableType].version,
+        responses->size());
+    if (!part)
     {
-        return ccOnlyResponse(request, rc);
+        error(
+            "Stale or invalid transfer handle {HANDLE} for BIOS table type {TYPE}",
+            "HANDLE", transferHandle, "TYPE", tableType);
+        return ccOnlyResponse(request,
+                              PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
     }
 
+    Response response = (*responses)[*part];
+    auto responsePtr = new (response.data()) pldm_msg;
+    responsePtr->hdr.instance_id = request->hdr.instance_id;
+
     return response;
 }
 
@@ -273,24 +357,75 @@ Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    Table table(field.ptr, field.ptr + field.length);
-    rc = biosConfig.setBIOSTable(tableType, table);
-    if (rc != PLDM_SUCCESS)
+    auto encodeResponse = [request](uint32_t nextTransferHandle) {
+        Response response(
+            sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
+        auto responsePtr = new (response.data()) pldm_msg;
+
+        auto encodeRc = encode_set_bios_table_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, nextTransferHandle,
+            responsePtr);
+        if (encodeRc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, encodeRc);
+        }
+        return response;
+    };
+
+    Table table;
+    switch (transferOpFlag)
     {
-        return ccOnlyResponse(request, rc);
+        case PLDM_START_AND_END:
+            tableTransfer.reset();
+            table.assign(field.ptr, field.ptr + field.length);
+            break;
+        case PLDM_START:
+            tableTransfer = TableTransfer{
+                tableType, 1, Table(field.ptr, field.ptr + field.length)};
+            return encodeResponse(tableTransfer->nextTransferHandle);
+        case PLDM_MIDDLE:
+        case PLDM_END:
+            if (!tableTransfer || tableTransfer->tableType != tableType ||
+                tableTransfer->nextTransferHandle != transferHandle)
+            {
+                error(
+                    "Stale or invalid transfer handle {HANDLE} for BIOS table type {TYPE}",
+                    "HANDLE", transferHandle, "TYPE", tableType);
+                tableTransfer.reset();
+                return ccOnlyResponse(
+                    request, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+            }
+            if (tableTransfer->table.size() + field.length > maxSetTableSize ||
+                tableTransfer->nextTransferHandle >= multipart::maxParts)
+            {
+                error(
+                    "BIOS table type {TYPE} set in parts exceeds {SIZE} bytes",
+                    "TYPE", tableType, "SIZE", maxSetTableSize);
+                tableTransfer.reset();
+                return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+            }
+            tableTransfer->table.insert(tableTransfer->table.end(), field.ptr,
+                                        field.ptr + field.length);
+            if (transferOpFlag == PLDM_MIDDLE)
+            {
+                return encodeResponse(++tableTransfer->nextTransferHandle);
+            }
+            table = std::move(tableTransfer->table);
+            tableTransfer.reset();
+            break;
+        default:
+            tableTransfer.reset();
+            return ccOnlyResponse(
+                request, PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG);
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
-    auto responsePtr = new (response.data()) pldm_msg;
-
-    rc = encode_set_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                    0 /* nxtTransferHandle */, responsePtr);
+    rc = biosConfig.setBIOSTable(tableType, table);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    return response;
+    return encodeResponse(0);
 }
 
 Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
@@ -308,14 +443,12 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    auto table = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    if (!table)
+    if (!biosConfig.hasBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE))
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
 
-    auto entry = pldm_bios_table_attr_value_find_by_handle(
-        table->data(), table->size(), attributeHandle);
+    auto entry = biosConfig.findAttrValueEntry(attributeHandle);
     if (entry == nullptr)
     {
         return ccOnlyResponse(request, PLDM_INVALID_BIOS_ATTR_HANDLE);
@@ -10,8 +10,11 @@
 #include <libpldm/bios.h>
 #include <libpldm/bios_table.h>
 
+#include <array>
 #include <cstdint>
 #include <ctime>
+#include <optional>
+#include <vector>
 
 namespace pldm
 {
@@ -34,11 +37,20 @@ class Handler : public CmdHandler
      *  @param[in] platformConfigHandler - pointer to platform config object
      *  @param[in] requestPLDMServiceName - Callback for registering the PLDM
      *                                      service
+     *  @param[in] jsonDir - directory of the BIOS JSONs
+     *  @param[in] tableDir - directory the BIOS tables are persisted to
+     *  @param[in] dBusIntf - D-Bus handler, the default one if nullptr
+     *  @param[in] transferSize - maximum number of table bytes in a
+     *                            GetBIOSTable response, 0 to never split
      */
     Handler(int fd, uint8_t eid, pldm::InstanceIdDb* instanceIdDb,
             pldm::requester::Handler<pldm::requester::Request>* handler,
             pldm::responder::platform_config::Handler* platformConfigHandler,
-            pldm::responder::bios::Callback requestPLDMServiceName);
+            pldm::responder::bios::Callback requestPLDMServiceName,
+            const char* jsonDir = BIOS_JSONS_DIR,
+            const char* tableDir = BIOS_TABLES_DIR,
+            pldm::utils::DBusHandler* dBusIntf = nullptr,
+            size_t transferSize = BIOS_TABLE_TRANSFER_SIZE);
 
     /** @brief Handler for GetDateTime
      *
@@ -48,6 +60,10 @@ class Handler : public CmdHandler
     Response getDateTime(const pldm_msg* request, size_t payloadLength);
 
     /** @brief Handler for GetBIOSTable
+     *
+     *  Tables larger than BIOS_TABLE_TRANSFER_SIZE are sent as a multipart
+     *  transfer. The transfer handles identify the table version, a
+     *  transfer of a table replaced meanwhile is rejected.
      *
      *  @param[in] request - Request message
      *  @param[in] payload_length - Request message payload length
@@ -55,7 +71,7 @@ class Handler : public CmdHandler
      */
     Response getBIOSTable(const pldm_msg* request, size_t payloadLength);
 
-    /** @brief Handler for SetBIOSTable
+    /** @brief Handler for SetBIOSTable, single or multipart
      *
      *  @param[in] request - Request message
      *  @param[in] payload_length - Request message payload length
@@ -101,7 +117,44 @@ class Handler : public CmdHandler
     }
 
   private:
+    /** @brief Get the GetBIOSTable responses of a table, encoded once per
+     *         version of the table
+     *
+     *  @param[in] tableType - The table type
+     *  @return The responses in transfer order, nullptr if the table is
+     *          unavailable
+     */
+    const std::vector<Response>* getBIOSTableResponses(uint8_t tableType);
+
     BIOSConfig biosConfig;
+
+    /** @brief Maximum number of table bytes in a GetBIOSTable response */
+    size_t transferSize;
+
+    /** @struct TableResponses
+     *  @brief GetBIOSTable responses of a version of a table
+     */
+    struct TableResponses
+    {
+        uint32_t version = 0;
+        std::vector<Response> responses;
+    };
+
+    /** @brief GetBIOSTable responses, indexed by table type */
+    std::array<TableResponses, 3> tableResponses;
+
+    /** @struct TableTransfer
+     *  @brief Multipart SetBIOSTable in progress
+     */
+    struct TableTransfer
+    {
+        uint8_t tableType;
+        uint32_t nextTransferHandle;
+        Table table;
+    };
+
+    /** @brief Multipart SetBIOSTable in progress, if any */
+    std::optional<TableTransfer> tableTransfer;
 };
 
 } // namespace bios
@@ -6,11 +6,16 @@
 #include "bios_table.hpp"
 #include "common/bios_utils.hpp"
 
+#include <libpldm/edac.h>
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/server.hpp>
 
+#include <chrono>
 #include <filesystem>
+#include <format>
 #include <fstream>
+#include <iterator>
 
 #ifdef OEM_IBM
 #include "oem/ibm/libpldmresponder/platform_oem_ibm.hpp"
@@ -37,6 +42,55 @@ constexpr auto stringTableFile = "stringTable";
 constexpr auto attrTableFile = "attributeTable";
 constexpr auto attrValueTableFile = "attributeValueTable";
 
+/** @brief Directory, under the table directory, of the tables compiled from
+ *         the BIOS attribute JSONs
+ */
+constexpr auto tableCacheDir = "cache";
+
+/** @brief Delay coalescing bursts of table changes into one write */
+constexpr auto persistDelay = std::chrono::milliseconds(500);
+
+/** @brief Delay coalescing bursts of attribute changes into one
+ *         BaseBIOSTable update
+ */
+constexpr auto baseBIOSTableDelay = std::chrono::milliseconds(100);
+
+const char* tableFile(uint8_t tableType)
+{
+    switch (tableType)
+    {
+        case PLDM_BIOS_STRING_TABLE:
+            return stringTableFile;
+        case PLDM_BIOS_ATTR_TABLE:
+            return attrTableFile;
+        default:
+            return attrValueTableFile;
+    }
+}
+
+/** @brief Key of the tables compiled from a BIOS attribute JSON, the CRC32
+ *         of the JSON content and the system type
+ *
+ *  @param[in] jsonFile - The BIOS attribute JSON
+ *  @param[in] systemType - The system type
+ *  @return The key, std::nullopt if the JSON can't be read
+ */
+std::optional<uint32_t> tableCacheKey(const fs::path& jsonFile,
+                                      const std::string& systemType)
+{
+    std::ifstream file(jsonFile, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> content{std::istreambuf_iterator<char>(file),
+                                 std::istreambuf_iterator<char>()};
+    content.push_back(0);
+    content.insert(content.end(), systemType.begin(), systemType.end());
+    return pldm_edac_crc32(content.data(), content.size());
+}
+
 } // namespace
 
 BIOSConfig::BIOSConfig(
@@ -48,7 +102,9 @@ BIOSConfig::BIOSConfig(
     jsonDir(jsonDir), tableDir(tableDir), dbusHandler(dbusHandler), eid(eid),
     instanceIdDb(instanceIdDb), handler(handler),
     platformConfigHandler(platformConfigHandler),
-    requestPLDMServiceName(requestPLDMServiceName)
+    requestPLDMServiceName(requestPLDMServiceName),
+    persistTimer([this]() { persistTables(); }),
+    baseBIOSTableTimer([this]() { publishBaseBIOSTable(); })
 {
     fs::create_directories(tableDir);
     removeTables();
@@ -62,6 +118,11 @@ BIOSConfig::BIOSConfig(
     listenPendingAttributes();
 }
 
+BIOSConfig::~BIOSConfig()
+{
+    persistTables();
+}
+
 void BIOSConfig::checkSystemTypeAvailability()
 {
     if (platformConfigHandler)
@@ -85,6 +146,7 @@ void BIOSConfig::checkSystemTypeAvailability()
 void BIOSConfig::initBIOSAttributes(const std::string& systemType,
                                     bool registerService)
 {
+    auto start = std::chrono::steady_clock::now();
     sysType = systemType;
     fs::path dir{jsonDir / sysType};
     if (!fs::exists(dir) && !fs::is_symlink(dir))
@@ -99,6 +161,20 @@ void BIOSConfig::initBIOSAttributes(const std::string& systemType,
     }
     constructAttributes();
     buildTables();
+
+    // steady_clock is CLOCK_MONOTONIC, its epoch is the boot of the BMC
+    auto now = std::chrono::steady_clock::now();
+    info(
+        "BIOS tables ready in {DURATION} ms, {UPTIME} ms after boot, string table cached '{CACHED}', attribute tables cached '{ATTR_CACHED}'",
+        "DURATION",
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start)
+            .count(),
+        "UPTIME",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch())
+            .count(),
+        "CACHED", stringTableCached, "ATTR_CACHED", attrTablesCached);
+
     if (registerService)
     {
         requestPLDMServiceName();
@@ -107,38 +183,113 @@ void BIOSConfig::initBIOSAttributes(const std::string& systemType,
 
 void BIOSConfig::buildTables()
 {
-    auto stringTable = buildAndStoreStringTable();
+    cacheKey = tableCacheKey(jsonDir / sysType / attributesJsonFile, sysType);
+
+    auto stringTable = loadCachedTable(PLDM_BIOS_STRING_TABLE);
+    stringTableCached = stringTable.has_value();
+    attrTablesCached = false;
+    if (stringTableCached)
+    {
+        setBIOSTable(PLDM_BIOS_STRING_TABLE, *stringTable);
+
+        // The attribute table was compiled from the same JSON, the attribute
+        // value table holds the values of the previous run
+        auto attrTable = loadCachedTable(PLDM_BIOS_ATTR_TABLE);
+        auto attrValueTable = loadCachedTable(PLDM_BIOS_ATTR_VAL_TABLE);
+        attrTablesCached =
+            attrTable && attrValueTable &&
+            setBIOSTable(PLDM_BIOS_ATTR_TABLE, *attrTable) == PLDM_SUCCESS &&
+            setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *attrValueTable) ==
+                PLDM_SUCCESS;
+        if (attrTablesCached)
+        {
+            return;
+        }
+    }
+    else
+    {
+        stringTable = buildAndStoreStringTable();
+        if (stringTable)
+        {
+            storeCachedTable(PLDM_BIOS_STRING_TABLE, *stringTable);
+        }
+    }
+
     if (stringTable)
     {
         buildAndStoreAttrTables(*stringTable);
+
+        // The attribute value table is cached when it is persisted
+        if (tables[PLDM_BIOS_ATTR_TABLE])
+        {
+            storeCachedTable(PLDM_BIOS_ATTR_TABLE,
+                             *tables[PLDM_BIOS_ATTR_TABLE]);
+        }
     }
 }
 
 std::optional<Table> BIOSConfig::getBIOSTable(pldm_bios_table_types tableType)
 {
-    fs::path tablePath;
-    switch (tableType)
+    if (static_cast<size_t>(tableType) >= tables.size())
     {
-        case PLDM_BIOS_STRING_TABLE:
-            tablePath = tableDir / stringTableFile;
-            break;
-        case PLDM_BIOS_ATTR_TABLE:
-            tablePath = tableDir / attrTableFile;
-            break;
-        case PLDM_BIOS_ATTR_VAL_TABLE:
-            tablePath = tableDir / attrValueTableFile;
-            break;
+        return std::nullopt;
+    }
+    return tables[tableType];
+}
+
+uint32_t BIOSConfig::getBIOSTableVersion(
+    pldm_bios_table_types tableType) const
+{
+    if (static_cast<size_t>(tableType) >= tableVersions.size())
+    {
+        return 0;
+    }
+    return tableVersions[tableType];
+}
+
+bool BIOSConfig::hasBIOSTable(pldm_bios_table_types tableType) const
+{
+    return static_cast<size_t>(tableType) < tables.size() &&
+           tables[tableType].has_value();
+}
+
+const pldm_bios_attr_table_entry* BIOSConfig::findAttrEntry(
+    uint16_t attrHandle) const
+{
+    auto it = attrEntryOffsets.find(attrHandle);
+    if (it == attrEntryOffsets.end())
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const pldm_bios_attr_table_entry*>(
+        tables[PLDM_BIOS_ATTR_TABLE]->data() + it->second);
+}
+
+const pldm_bios_attr_val_table_entry* BIOSConfig::findAttrValueEntry(
+    uint16_t attrHandle) const
+{
+    auto it = attrValueEntryOffsets.find(attrHandle);
+    if (it == attrValueEntryOffsets.end())
+    {
+        return nullptr;
     }
-    return loadTable(tablePath);
+    return reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+        tables[PLDM_BIOS_ATTR_VAL_TABLE]->data() + it->second);
+}
+
+BIOSAttribute* BIOSConfig::findAttribute(const std::string& attrName) const
+{
+    auto it = attrIndexes.find(attrName);
+    if (it == attrIndexes.end())
+    {
+        return nullptr;
+    }
+    return biosAttributes[it->second].get();
 }
 
 int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
                              bool updateBaseBIOSTable)
 {
-    fs::path stringTablePath(tableDir / stringTableFile);
-    fs::path attrTablePath(tableDir / attrTableFile);
-    fs::path attrValueTablePath(tableDir / attrValueTableFile);
-
     if (!pldm_bios_table_checksum(table.data(), table.size()))
     {
         return PLDM_INVALID_BIOS_TABLE_DATA_INTEGRITY_CHECK;
@@ -146,12 +297,11 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 
     if (tableType == PLDM_BIOS_STRING_TABLE)
     {
-        storeTable(stringTablePath, table);
+        updateTable(tableType, table);
     }
     else if (tableType == PLDM_BIOS_ATTR_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        if (biosStringTable.isEmpty())
+        if (!tables[PLDM_BIOS_STRING_TABLE])
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -162,13 +312,11 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
             return rc;
         }
 
-        storeTable(attrTablePath, table);
+        updateTable(tableType, table);
     }
     else if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        BIOSTable biosStringValueTable(attrTablePath.c_str());
-        if (biosStringTable.isEmpty() || biosStringValueTable.isEmpty())
+        if (!tables[PLDM_BIOS_STRING_TABLE] || !tables[PLDM_BIOS_ATTR_TABLE])
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -179,7 +327,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
             return rc;
         }
 
-        storeTable(attrValueTablePath, table);
+        updateTable(tableType, table);
     }
     else
     {
@@ -194,19 +342,110 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
     return PLDM_SUCCESS;
 }
 
+void BIOSConfig::updateTable(uint8_t tableType, const Table& table)
+{
+    tables[tableType] = table;
+    ++tableVersions[tableType];
+    indexTable(tableType);
+    dirtyTables.emplace(tableType);
+    if (!persistTimer.isEnabled())
+    {
+        persistTimer.start(persistDelay);
+    }
+}
+
+void BIOSConfig::indexTable(uint8_t tableType)
+{
+    using namespace pldm::bios::utils;
+    const auto& biosTable = tables[tableType];
+
+    switch (tableType)
+    {
+        case PLDM_BIOS_STRING_TABLE:
+            stringTableIndex.reset();
+            baseBIOSTableSources.clear();
+            if (biosTable)
+            {
+                stringTableIndex.emplace(*biosTable);
+            }
+            break;
+        case PLDM_BIOS_ATTR_TABLE:
+            attrEntryOffsets.clear();
+            attrHandles.clear();
+            baseBIOSTableSources.clear();
+            if (!biosTable || biosTable->empty())
+            {
+                break;
+            }
+            for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+                     biosTable->data(), biosTable->size()))
+            {
+                auto header = table::attribute::decodeHeader(entry);
+                auto offset =
+                    reinterpret_cast<const uint8_t*>(entry) - biosTable->data();
+                attrEntryOffsets.emplace(header.attrHandle, offset);
+                attrHandles.emplace(header.stringHandle, header.attrHandle);
+            }
+            break;
+        case PLDM_BIOS_ATTR_VAL_TABLE:
+            attrValueEntryOffsets.clear();
+            if (!biosTable || biosTable->empty())
+            {
+                break;
+            }
+            for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(
+                     biosTable->data(), biosTable->size()))
+            {
+                auto header = table::attribute_value::decodeHeader(entry);
+                auto offset =
+                    reinterpret_cast<const uint8_t*>(entry) - biosTable->data();
+                attrValueEntryOffsets.emplace(header.attrHandle, offset);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void BIOSConfig::persistTables()
+{
+    for (auto tableType : dirtyTables)
+    {
+        try
+        {
+            BIOSTable biosTable((tableDir / tableFile(tableType)).c_str());
+            if (tables[tableType])
+            {
+                biosTable.store(*tables[tableType]);
+                if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
+                {
+                    storeCachedTable(tableType, *tables[tableType]);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to persist BIOS table type {TYPE}, error - {ERROR}",
+                  "TYPE", tableType, "ERROR", e);
+        }
+    }
+    dirtyTables.clear();
+}
+
 int BIOSConfig::checkAttributeTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    if (!stringTableIndex)
+    {
+        return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
     for (auto entry :
          BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(table.data(), table.size()))
     {
         auto attrNameHandle =
             pldm_bios_table_attr_entry_decode_string_handle(entry);
 
-        auto stringEnty = pldm_bios_table_string_find_by_handle(
-            stringTable->data(), stringTable->size(), attrNameHandle);
-        if (stringEnty == nullptr)
+        if (!stringTableIndex->hasHandle(attrNameHandle))
         {
             return PLDM_INVALID_BIOS_ATTR_HANDLE;
         }
@@ -234,9 +473,7 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 
                 for (size_t i = 0; i < pvHandls.size(); i++)
                 {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        stringTable->data(), stringTable->size(), pvHandls[i]);
-                    if (stringEntry == nullptr)
+                    if (!stringTableIndex->hasHandle(pvHandls[i]))
                     {
                         return PLDM_INVALID_BIOS_ATTR_HANDLE;
                     }
@@ -244,10 +481,8 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 
                 for (size_t i = 0; i < defIndices.size(); i++)
                 {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        stringTable->data(), stringTable->size(),
-                        pvHandls[defIndices[i]]);
-                    if (stringEntry == nullptr)
+                    if (defIndices[i] >= pvHandls.size() ||
+                        !stringTableIndex->hasHandle(pvHandls[defIndices[i]]))
                     {
                         return PLDM_INVALID_BIOS_ATTR_HANDLE;
                     }
@@ -272,10 +507,17 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 int BIOSConfig::checkAttributeValueTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
-    baseBIOSTableMaps.clear();
+    BaseBIOSTable biosTable{};
+    std::unordered_map<uint16_t, Table> sources{};
+    std::vector<AttributeName> changed{};
+
+    // Entries reused from baseBIOSTableMaps are moved back if the table is
+    // rejected
+    auto reject = [this, &biosTable](int rc) {
+        baseBIOSTableMaps.merge(biosTable);
+        return rc;
+    };
 
     for (auto tableEntry :
          BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(table.data(), table.size()))
@@ -298,31 +540,41 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
         auto attrType = static_cast<pldm_bios_attribute_type>(
             pldm_bios_table_attr_value_entry_decode_attribute_type(tableEntry));
 
-        auto attrEntry = pldm_bios_table_attr_find_by_handle(
-            attrTable->data(), attrTable->size(), attrValueHandle);
+        auto attrEntry = findAttrEntry(attrValueHandle);
         if (attrEntry == nullptr)
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            return reject(PLDM_INVALID_BIOS_ATTR_HANDLE);
         }
         auto attrHandle =
             pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
         auto attrNameHandle =
             pldm_bios_table_attr_entry_decode_string_handle(attrEntry);
 
-        auto stringEntry = pldm_bios_table_string_find_by_handle(
-            stringTable->data(), stringTable->size(), attrNameHandle);
-        if (stringEntry == nullptr)
+        try
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            attributeName = stringTableIndex->findString(attrNameHandle);
         }
-        auto strLength =
-            pldm_bios_table_string_entry_decode_string_length(stringEntry);
-        std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-        // Preconditions are upheld therefore no error check necessary
-        pldm_bios_table_string_entry_decode_string(stringEntry, buffer.data(),
-                                                   buffer.size());
+        catch (const std::invalid_argument&)
+        {
+            return reject(PLDM_INVALID_BIOS_ATTR_HANDLE);
+        }
+
+        auto entryData = reinterpret_cast<const uint8_t*>(tableEntry);
+        Table source(entryData,
+                     entryData +
+                         pldm_bios_table_attr_value_entry_length(tableEntry));
 
-        attributeName = std::string(buffer.data(), buffer.data() + strLength);
+        // Reuse the decoded entry if the value did not change
+        auto sourceIt = baseBIOSTableSources.find(attrValueHandle);
+        auto cached = baseBIOSTableMaps.find(attributeName);
+        if (sourceIt != baseBIOSTableSources.end() &&
+            sourceIt->second == source && cached != baseBIOSTableMaps.end())
+        {
+            biosTable.insert(baseBIOSTableMaps.extract(cached));
+            sources.emplace(attrValueHandle, std::move(source));
+            continue;
+        }
+        sources.emplace(attrValueHandle, std::move(source));
 
         if (!biosAttributes.empty())
         {
@@ -349,22 +601,8 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                     valueDisplayNames.insert(valueDisplayNames.end(),
                                              vdn.begin(), vdn.end());
                 }
-                auto getValue =
-                    [](uint16_t handle, const Table& table) -> std::string {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        table.data(), table.size(), handle);
-
-                    auto strLength =
-                        pldm_bios_table_string_entry_decode_string_length(
-                            stringEntry);
-                    std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-                    // Preconditions are upheld therefore no error check
-                    // necessary
-                    pldm_bios_table_string_entry_decode_string(
-                        stringEntry, buffer.data(), buffer.size());
-
-                    return std::string(buffer.data(),
-                                       buffer.data() + strLength);
+                auto getValue = [this](uint16_t handle) {
+                    return stringTableIndex->findString(handle);
                 };
 
                 attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
@@ -385,7 +623,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                     options.push_back(
                         std::make_tuple("xyz.openbmc_project.BIOSConfig."
                                         "Manager.BoundType.OneOf",
-                                        getValue(pvHandls[i], *stringTable),
+                                        getValue(pvHandls[i]),
                                         valueDisplayNames[i]));
                 }
 
@@ -399,7 +637,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                 // get current_value
                 for (size_t i = 0; i < handles.size(); i++)
                 {
-                    currentValue = getValue(pvHandls[handles[i]], *stringTable);
+                    currentValue = getValue(pvHandls[handles[i]]);
                 }
 
                 uint8_t defNum = 0;
@@ -413,8 +651,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                 // get default_value
                 for (size_t i = 0; i < defIndices.size(); i++)
                 {
-                    defaultValue =
-                        getValue(pvHandls[defIndices[i]], *stringTable);
+                    defaultValue = getValue(pvHandls[defIndices[i]]);
                 }
 
                 break;
@@ -488,23 +725,46 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                 break;
             }
             default:
-                return PLDM_INVALID_BIOS_ATTR_HANDLE;
+                return reject(PLDM_INVALID_BIOS_ATTR_HANDLE);
         }
-        baseBIOSTableMaps.emplace(
+        changed.push_back(attributeName);
+        biosTable.emplace(
             std::move(attributeName),
             std::make_tuple(attributeType, readonlyStatus, displayName,
                             description, menuPath, currentValue, defaultValue,
                             std::move(options)));
     }
 
+    // the attributes removed from the table change it too
+    for (const auto& [attrName, attr] : baseBIOSTableMaps)
+    {
+        if (!biosTable.contains(attrName))
+        {
+            changed.push_back(attrName);
+        }
+    }
+
+    baseBIOSTableMaps = std::move(biosTable);
+    baseBIOSTableSources = std::move(sources);
+    dirtyBaseBIOSAttributes.insert(std::make_move_iterator(changed.begin()),
+                                   std::make_move_iterator(changed.end()));
+
     return PLDM_SUCCESS;
 }
 
 void BIOSConfig::updateBaseBIOSTableProperty()
+{
+    if (!baseBIOSTableTimer.isEnabled())
+    {
+        baseBIOSTableTimer.start(baseBIOSTableDelay);
+    }
+}
+
+void BIOSConfig::publishBaseBIOSTable()
 {
     constexpr static auto dbusProperties = "org.freedesktop.DBus.Properties";
 
-    if (baseBIOSTableMaps.empty())
+    if (baseBIOSTableMaps.empty() || dirtyBaseBIOSAttributes.empty())
     {
         return;
     }
@@ -525,6 +785,7 @@ void BIOSConfig::updateBaseBIOSTableProperty()
                       BIOSConfigManager::property_names::base_bios_table,
                       value);
         bus.call_noreply(method, dbusTimeout);
+        dirtyBaseBIOSAttributes.clear();
     }
     catch (const std::exception& e)
     {
@@ -658,14 +919,24 @@ std::optional<Table> BIOSConfig::buildAndStoreStringTable()
     return table;
 }
 
-void BIOSConfig::storeTable(const fs::path& path, const Table& table)
+fs::path BIOSConfig::cachedTablePath(uint8_t tableType) const
 {
-    BIOSTable biosTable(path.c_str());
-    biosTable.store(table);
+    if (!cacheKey)
+    {
+        return {};
+    }
+    return tableDir / tableCacheDir /
+           std::format("{}-{:08x}", tableFile(tableType), *cacheKey);
 }
 
-std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
+std::optional<Table> BIOSConfig::loadCachedTable(uint8_t tableType)
 {
+    auto path = cachedTablePath(tableType);
+    if (path.empty())
+    {
+        return std::nullopt;
+    }
+
     BIOSTable biosTable(path.c_str());
     if (biosTable.isEmpty())
     {
@@ -673,10 +944,58 @@ std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
     }
 
     Table table;
-    biosTable.load(table);
+    try
+    {
+        biosTable.load(table);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to load cached BIOS table type {TYPE}, error - {ERROR}",
+            "TYPE", tableType, "ERROR", e);
+        return std::nullopt;
+    }
+
+    if (!pldm_bios_table_checksum(table.data(), table.size()))
+    {
+        error("Cached BIOS table '{PATH}' is corrupted", "PATH", path);
+        return std::nullopt;
+    }
     return table;
 }
 
+void BIOSConfig::storeCachedTable(uint8_t tableType, const Table& table)
+{
+    auto path = cachedTablePath(tableType);
+    if (path.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        // Only the table of the current JSON and system type is kept
+        auto cacheDir = path.parent_path();
+        fs::create_directories(cacheDir);
+        auto prefix = std::string(tableFile(tableType)) + "-";
+        for (const auto& file : fs::directory_iterator(cacheDir))
+        {
+            if (file.path() != path &&
+                file.path().filename().string().starts_with(prefix))
+            {
+                fs::remove(file.path());
+            }
+        }
+        BIOSTable biosTable(path.c_str());
+        biosTable.store(table);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to cache BIOS table type {TYPE}, error - {ERROR}",
+              "TYPE", tableType, "ERROR", e);
+    }
+}
+
 void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
 {
     std::ifstream file;
@@ -710,24 +1029,9 @@ void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
     }
 }
 
-std::string BIOSConfig::decodeStringFromStringEntry(
-    const pldm_bios_string_table_entry* stringEntry)
-{
-    auto strLength =
-        pldm_bios_table_string_entry_decode_string_length(stringEntry);
-    std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-    // Preconditions are upheld therefore no error check necessary
-    pldm_bios_table_string_entry_decode_string(stringEntry, buffer.data(),
-                                               buffer.size());
-    return std::string(buffer.data(), buffer.data() + strLength);
-}
-
-std::string BIOSConfig::displayStringHandle(
-    uint16_t handle, uint8_t index, const std::optional<Table>& attrTable,
-    const std::optional<Table>& stringTable)
+std::string BIOSConfig::displayStringHandle(uint16_t handle, uint8_t index)
 {
-    auto attrEntry = pldm_bios_table_attr_find_by_handle(
-        attrTable->data(), attrTable->size(), handle);
+    auto attrEntry = findAttrEntry(handle);
     uint8_t pvNum = 0;
     int rc = pldm_bios_table_attr_entry_enum_decode_pv_num(attrEntry, &pvNum);
     if (rc != PLDM_SUCCESS)
@@ -746,10 +1050,7 @@ std::string BIOSConfig::displayStringHandle(
 
     std::string displayString = std::to_string(pvHandls[index]);
 
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable->data(), stringTable->size(), pvHandls[index]);
-
-    auto decodedStr = decodeStringFromStringEntry(stringEntry);
+    auto decodedStr = stringTableIndex->findString(pvHandls[index]);
 
     return decodedStr + "(" + displayString + ")";
 }
@@ -758,15 +1059,11 @@ void BIOSConfig::traceBIOSUpdate(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
     const pldm_bios_attr_table_entry* attrEntry, bool isBMC)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
     auto [attrHandle,
           attrType] = table::attribute_value::decodeHeader(attrValueEntry);
 
     auto attrHeader = table::attribute::decodeHeader(attrEntry);
-    BIOSStringTable biosStringTable(*stringTable);
-    auto attrName = biosStringTable.findString(attrHeader.stringHandle);
+    auto attrName = stringTableIndex->findString(attrHeader.stringHandle);
 
     switch (attrType)
     {
@@ -781,8 +1078,7 @@ void BIOSConfig::traceBIOSUpdate(
 
             for (uint8_t handle : handles)
             {
-                auto nwVal = displayStringHandle(attrHandle, handle, attrTable,
-                                                 stringTable);
+                auto nwVal = displayStringHandle(attrHandle, handle);
                 auto chkBMC = isBMC ? "true" : "false";
                 info(
                     "BIOS attribute '{ATTRIBUTE}' updated to value '{VALUE}' by BMC '{CHECK_BMC}'",
@@ -891,21 +1187,31 @@ int BIOSConfig::checkAttrValueToUpdate(
 int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
                              bool updateDBus, bool updateBaseBIOSTable)
 {
-    auto attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    if (!attrValueTable || !attrTable || !stringTable)
+    auto data = static_cast<const uint8_t*>(entry);
+    return setAttrValues({Table(data, data + size)}, isBMC, updateDBus,
+                         updateBaseBIOSTable);
+}
+
+int BIOSConfig::checkAttrValueEntry(const Table& entry,
+                                    AttrValueChange& change)
+{
+    auto& stringTable = tables[PLDM_BIOS_STRING_TABLE];
+    if (!tables[PLDM_BIOS_ATTR_TABLE] || !stringTable)
     {
         return PLDM_BIOS_TABLE_UNAVAILABLE;
     }
 
+    if (entry.size() < sizeof(pldm_bios_attr_val_table_entry))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
     auto attrValueEntry =
-        reinterpret_cast<const pldm_bios_attr_val_table_entry*>(entry);
+        reinterpret_cast<const pldm_bios_attr_val_table_entry*>(entry.data());
 
     auto attrValHeader = table::attribute_value::decodeHeader(attrValueEntry);
 
-    auto attrEntry =
-        table::attribute::findByHandle(*attrTable, attrValHeader.attrHandle);
+    auto attrEntry = findAttrEntry(attrValHeader.attrHandle);
     if (!attrEntry)
     {
         return PLDM_ERROR;
@@ -917,49 +1223,137 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
         return rc;
     }
 
-    auto destTable =
-        table::attribute_value::updateTable(*attrValueTable, entry, size);
+    try
+    {
+        auto attrHeader = table::attribute::decodeHeader(attrEntry);
+        auto attrName = stringTableIndex->findString(attrHeader.stringHandle);
+        auto attribute = findAttribute(attrName);
+        if (attribute == nullptr)
+        {
+            return PLDM_ERROR;
+        }
+        change = {attrValueEntry, attrEntry, attribute};
+    }
+    catch (const std::exception& e)
+    {
+        error("Set attribute value error - {ERROR}", "ERROR", e);
+        return PLDM_ERROR;
+    }
+
+    return PLDM_SUCCESS;
+}
+
+int BIOSConfig::setAttrValues(const std::vector<Table>& entries, bool isBMC,
+                              bool updateDBus, bool updateBaseBIOSTable)
+{
+    std::vector<AttrValueChange> changes(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        auto rc = checkAttrValueEntry(entries[i], changes[i]);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
+    }
+
+    return applyAttrValues(entries, changes, isBMC, updateDBus,
+                           updateBaseBIOSTable);
+}
 
+int BIOSConfig::applyAttrValues(const std::vector<Table>& entries,
+                                const std::vector<AttrValueChange>& changes,
+                                bool isBMC, bool updateDBus,
+                                bool updateBaseBIOSTable)
+{
+    auto& attrValueTable = tables[PLDM_BIOS_ATTR_VAL_TABLE];
+    if (!attrValueTable || !tables[PLDM_BIOS_ATTR_TABLE] ||
+        !tables[PLDM_BIOS_STRING_TABLE])
+    {
+        return PLDM_BIOS_TABLE_UNAVAILABLE;
+    }
+
+    auto destTable = table::attribute_value::updateTable(*attrValueTable,
+                                                         entries);
     if (!destTable)
     {
         return PLDM_ERROR;
     }
 
-    try
+    // keep the previous table to roll back to if a D-Bus set fails
+    auto prevTable = *attrValueTable;
+    auto rc = setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable,
+                           updateBaseBIOSTable);
+    if (rc != PLDM_SUCCESS)
     {
-        auto attrHeader = table::attribute::decodeHeader(attrEntry);
-
-        BIOSStringTable biosStringTable(*stringTable);
-        auto attrName = biosStringTable.findString(attrHeader.stringHandle);
-        auto iter = std::find_if(
-            biosAttributes.begin(), biosAttributes.end(),
-            [&attrName](const auto& attr) { return attr->name == attrName; });
+        return rc;
+    }
 
-        if (iter == biosAttributes.end())
+    if (updateDBus)
+    {
+        size_t applied = 0;
+        try
         {
-            return PLDM_ERROR;
+            for (; applied < changes.size(); ++applied)
+            {
+                const auto& change = changes[applied];
+                change.attribute->setAttrValueOnDbus(
+                    change.attrValueEntry, change.attrEntry,
+                    *stringTableIndex);
+            }
         }
-        if (updateDBus)
+        catch (const std::exception& e)
         {
-            (*iter)->setAttrValueOnDbus(attrValueEntry, attrEntry,
-                                        biosStringTable);
+            error("Set attribute value error - {ERROR}", "ERROR", e);
+
+            while (applied--)
+            {
+                const auto& change = changes[applied];
+                auto attrHandle =
+                    table::attribute_value::decodeHeader(change.attrValueEntry)
+                        .attrHandle;
+                auto prevEntry = table::attribute_value::findByHandle(
+                    prevTable, attrHandle);
+                if (!prevEntry)
+                {
+                    continue;
+                }
+                try
+                {
+                    change.attribute->setAttrValueOnDbus(
+                        prevEntry, change.attrEntry, *stringTableIndex);
+                }
+                catch (const std::exception& e)
+                {
+                    error(
+                        "Failed to roll back BIOS attribute handle {HANDLE}, error - {ERROR}",
+                        "HANDLE", attrHandle, "ERROR", e);
+                }
+            }
+            setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, prevTable,
+                         updateBaseBIOSTable);
+            return PLDM_ERROR;
         }
     }
-    catch (const std::exception& e)
+
+    for (const auto& change : changes)
     {
-        error("Set attribute value error - {ERROR}", "ERROR", e);
-        return PLDM_ERROR;
+        traceBIOSUpdate(change.attrValueEntry, change.attrEntry, isBMC);
     }
 
-    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable, updateBaseBIOSTable);
-
-    traceBIOSUpdate(attrValueEntry, attrEntry, isBMC);
-
     return PLDM_SUCCESS;
 }
 
 void BIOSConfig::removeTables()
 {
+    tables = {};
+    for (size_t tableType = 0; tableType < tables.size(); ++tableType)
+    {
+        ++tableVersions[tableType];
+        indexTable(static_cast<uint8_t>(tableType));
+    }
+    dirtyTables.clear();
+    persistTimer.stop();
+
     try
     {
         fs::remove(tableDir / stringTableFile);
@@ -986,17 +1380,15 @@ void BIOSConfig::processBiosAttrChangeNotification(
     }
 
     PropertyValue newPropVal = it->second;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    if (!stringTable.has_value())
+    if (!stringTableIndex)
     {
         error("BIOS string table unavailable");
         return;
     }
-    BIOSStringTable biosStringTable(*stringTable);
     uint16_t attrNameHdl{};
     try
     {
-        attrNameHdl = biosStringTable.findHandle(attrName);
+        attrNameHdl = stringTableIndex->findHandle(attrName);
     }
     catch (const std::invalid_argument& e)
     {
@@ -1006,14 +1398,16 @@ void BIOSConfig::processBiosAttrChangeNotification(
         return;
     }
 
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    if (!attrTable.has_value())
+    if (!tables[PLDM_BIOS_ATTR_TABLE])
     {
         error("BIOS Attribute table not present");
         return;
     }
+    auto attrHandleIt = attrHandles.find(attrNameHdl);
     const struct pldm_bios_attr_table_entry* tableEntry =
-        table::attribute::findByStringHandle(*attrTable, attrNameHdl);
+        attrHandleIt == attrHandles.end()
+            ? nullptr
+            : findAttrEntry(attrHandleIt->second);
     if (tableEntry == nullptr)
     {
         error(
@@ -1025,7 +1419,7 @@ void BIOSConfig::processBiosAttrChangeNotification(
     auto [attrHdl, attrType,
           stringHdl] = table::attribute::decodeHeader(tableEntry);
 
-    auto attrValueSrcTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    const auto& attrValueSrcTable = tables[PLDM_BIOS_ATTR_VAL_TABLE];
 
     if (!attrValueSrcTable.has_value())
     {
@@ -1047,7 +1441,7 @@ void BIOSConfig::processBiosAttrChangeNotification(
         *attrValueSrcTable, newValue.data(), newValue.size());
     if (destTable.has_value())
     {
-        storeTable(tableDir / attrValueTableFile, *destTable);
+        updateTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable);
     }
 
     rc = setAttrValue(newValue.data(), newValue.size(), true, false);
@@ -1061,85 +1455,121 @@ void BIOSConfig::processBiosAttrChangeNotification(
 
 uint16_t BIOSConfig::findAttrHandle(const std::string& attrName)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
-    BIOSStringTable biosStringTable(*stringTable);
-    pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE> attrTableIter(
-        attrTable->data(), attrTable->size());
-    auto stringHandle = biosStringTable.findHandle(attrName);
-
-    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
-             attrTable->data(), attrTable->size()))
+    if (!stringTableIndex)
     {
-        auto header = table::attribute::decodeHeader(entry);
-        if (header.stringHandle == stringHandle)
-        {
-            return header.attrHandle;
-        }
+        throw std::invalid_argument("BIOS string table unavailable");
     }
 
-    throw std::invalid_argument("Unknown attribute Name");
+    auto it = attrHandles.find(stringTableIndex->findHandle(attrName));
+    if (it == attrHandles.end())
+    {
+        throw std::invalid_argument("Unknown attribute Name");
+    }
+    return it->second;
 }
 
 void BIOSConfig::constructPendingAttribute(
     const PendingAttributes& pendingAttributes)
 {
     std::vector<uint16_t> listOfHandles{};
+    std::vector<Table> attrValueEntries{};
+    attrValueEntries.reserve(pendingAttributes.size());
 
+    // Build and validate every entry before applying any, a single unknown
+    // or invalid pending attribute rejects the whole batch
     for (auto& attribute : pendingAttributes)
     {
         std::string attributeName = attribute.first;
         auto& [attributeType, attributevalue] = attribute.second;
 
-        auto iter = std::find_if(biosAttributes.begin(), biosAttributes.end(),
-                                 [&attributeName](const auto& attr) {
-                                     return attr->name == attributeName;
-                                 });
-
-        if (iter == biosAttributes.end())
+        auto biosAttribute = findAttribute(attributeName);
+        auto baseIt = baseBIOSTableMaps.find(attributeName);
+        if (biosAttribute == nullptr || baseIt == baseBIOSTableMaps.end())
         {
-            error("Wrong attribute name {NAME}", "NAME", attributeName);
-            continue;
+            error(
+                "Wrong attribute name {NAME}, rejecting the pending attributes",
+                "NAME", attributeName);
+            return;
         }
 
-        Table attrValueEntry(sizeof(pldm_bios_attr_val_table_entry), 0);
-        auto entry = new (attrValueEntry.data()) pldm_bios_attr_val_table_entry;
-
-        auto handler = findAttrHandle(attributeName);
         auto type =
             BIOSConfigManager::convertAttributeTypeFromString(attributeType);
-
         if (type != BIOSConfigManager::AttributeType::Enumeration &&
             type != BIOSConfigManager::AttributeType::String &&
             type != BIOSConfigManager::AttributeType::Integer)
         {
-            error("Attribute type '{TYPE}' not supported", "TYPE",
-                  attributeType);
-            continue;
+            error(
+                "Attribute type '{TYPE}' of {NAME} not supported, rejecting the pending attributes",
+                "TYPE", attributeType, "NAME", attributeName);
+            return;
         }
 
-        const auto [attrType, readonlyStatus, displayName, description,
-                    menuPath, currentValue, defaultValue,
-                    option] = baseBIOSTableMaps.at(attributeName);
+        uint16_t handler{};
+        try
+        {
+            handler = findAttrHandle(attributeName);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to find the handle of {NAME}, rejecting the pending attributes, error - {ERROR}",
+                "NAME", attributeName, "ERROR", e);
+            return;
+        }
 
+        Table attrValueEntry(sizeof(pldm_bios_attr_val_table_entry), 0);
+        auto entry = new (attrValueEntry.data()) pldm_bios_attr_val_table_entry;
         entry->attr_handle = htole16(handler);
 
+        biosAttribute->generateAttributeEntry(attributevalue, attrValueEntry);
+
+        const auto& [attrType, readonlyStatus, displayName, description,
+                     menuPath, currentValue, defaultValue,
+                     option] = baseIt->second;
+
         // Need to verify that the current value has really changed
         if (attributeType == attrType && attributevalue != currentValue)
         {
             listOfHandles.emplace_back(htole16(handler));
         }
 
-        (*iter)->generateAttributeEntry(attributevalue, attrValueEntry);
+        attrValueEntries.push_back(std::move(attrValueEntry));
+    }
+
+    if (attrValueEntries.empty())
+    {
+        return;
+    }
 
-        setAttrValue(attrValueEntry.data(), attrValueEntry.size(), true);
+    // The changes point into the entries, validate them once the entries
+    // are no longer moved
+    std::vector<AttrValueChange> changes(attrValueEntries.size());
+    auto nameIt = pendingAttributes.begin();
+    for (size_t i = 0; i < attrValueEntries.size(); ++i, ++nameIt)
+    {
+        auto rc = checkAttrValueEntry(attrValueEntries[i], changes[i]);
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Invalid pending BIOS attribute {NAME}, rejecting the pending attributes, response code '{RC}'",
+                "NAME", nameIt->first, "RC", rc);
+            return;
+        }
+    }
+
+    auto rc = applyAttrValues(attrValueEntries, changes, true, true, true);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to apply {COUNT} pending BIOS attributes, response code '{RC}'",
+            "COUNT", attrValueEntries.size(), "RC", rc);
+        return;
     }
 
     if (listOfHandles.size())
     {
 #ifdef OEM_IBM
-        auto rc = pldm::responder::platform::sendBiosAttributeUpdateEvent(
+        rc = pldm::responder::platform::sendBiosAttributeUpdateEvent(
             eid, instanceIdDb, listOfHandles, handler);
         if (rc != PLDM_SUCCESS)
         {
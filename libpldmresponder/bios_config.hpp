@@ -12,10 +12,14 @@
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -49,7 +53,9 @@ class BIOSConfig
     BIOSConfig(BIOSConfig&&) = delete;
     BIOSConfig& operator=(const BIOSConfig&) = delete;
     BIOSConfig& operator=(BIOSConfig&&) = delete;
-    ~BIOSConfig() = default;
+
+    /** @brief Persist the tables with pending changes */
+    ~BIOSConfig();
 
     /** @brief Construct BIOSConfig
      *  @param[in] jsonDir - The directory where json file exists
@@ -84,19 +90,70 @@ class BIOSConfig
     int setAttrValue(const void* entry, size_t size, bool isBMC,
                      bool updateDBus = true, bool updateBaseBIOSTable = true);
 
-    /** @brief Remove the persistent tables */
+    /** @brief Set a batch of attribute values on dbus and attribute value
+     *         table
+     *
+     *  Every entry is validated before any is applied, and a single invalid
+     *  entry rejects the batch. The attribute value table is then rebuilt
+     *  and replaced once, and the attribute D-Bus properties set last. If a
+     *  D-Bus set fails, the properties already set and the table are rolled
+     *  back to their previous values.
+     *
+     *  @param[in] entries - attribute value entries
+     *  @param[in] isBMC - indicates if the attributes are set by BMC
+     *  @param[in] updateDBus          - update Attr value D-Bus properties
+     *                                   if this is set to true
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *                                   if this is set to true
+     *  @return pldm_completion_codes
+     */
+    int setAttrValues(const std::vector<Table>& entries, bool isBMC,
+                      bool updateDBus = true, bool updateBaseBIOSTable = true);
+
+    /** @brief Listen the PendingAttributes property of the D-Bus interface
+     * and update BaseBIOSTable
+     *
+     *  The pending attributes are applied all or nothing: if any of them is
+     *  unknown or invalid, none is applied.
+     *
+     *  @param[in] msg - Data associated with subscribed signal
+     */
+    void constructPendingAttribute(const PendingAttributes& pendingAttributes);
+
+    /** @brief Remove the tables, in memory and persisted */
     void removeTables();
 
     /** @brief Build bios tables(string,attribute,attribute value table)*/
     void buildTables();
 
-    /** @brief Get BIOS table of specified type
+    /** @brief Get BIOS table of specified type, from memory
      *  @param[in] tableType - The table type
      *  @return The bios table, std::nullopt if the table is unaviliable
      */
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType);
 
-    /** @brief set BIOS table
+    /** @brief Get the version of a BIOS table, it changes whenever the table
+     *         is replaced
+     *  @param[in] tableType - The table type
+     *  @return The table version
+     */
+    uint32_t getBIOSTableVersion(pldm_bios_table_types tableType) const;
+
+    /** @brief Check whether a BIOS table is available
+     *  @param[in] tableType - The table type
+     *  @return true if the table is available
+     */
+    bool hasBIOSTable(pldm_bios_table_types tableType) const;
+
+    /** @brief Find an entry of the attribute value table
+     *  @param[in] attrHandle - The attribute handle
+     *  @return Pointer to the entry, valid until the attribute value table is
+     *          replaced, nullptr if there is no such entry
+     */
+    const pldm_bios_attr_val_table_entry* findAttrValueEntry(
+        uint16_t attrHandle) const;
+
+    /** @brief set BIOS table, the table is persisted in the background
      *  @param[in] tableType - Indicates what table is being transferred
      *             {BIOSStringTable=0x0, BIOSAttributeTable=0x1,
      *              BIOSAttributeValueTable=0x2}
@@ -181,6 +238,93 @@ class BIOSConfig
     /** @brief system type/model */
     std::string sysType;
 
+    /** @brief Key of the cached tables, the CRC32 of the BIOS attribute
+     *         JSON and the system type, std::nullopt if the JSON can't be read
+     */
+    std::optional<uint32_t> cacheKey;
+
+    /** @brief Whether the string table was loaded from the cache */
+    bool stringTableCached = false;
+
+    /** @brief Whether the attribute and attribute value tables were loaded
+     *         from the cache
+     */
+    bool attrTablesCached = false;
+
+    /** @brief The string, attribute and attribute value tables, indexed by
+     *         pldm_bios_table_types. The persisted tables are only written.
+     */
+    std::array<std::optional<Table>, 3> tables;
+
+    /** @brief Versions of the tables, bumped when a table is replaced */
+    std::array<uint32_t, 3> tableVersions{};
+
+    /** @brief Index of the string table */
+    std::optional<BIOSStringTable> stringTableIndex;
+
+    /** @brief Attribute handle to the offset of its attribute table entry */
+    std::unordered_map<uint16_t, size_t> attrEntryOffsets;
+
+    /** @brief Attribute name string handle to attribute handle */
+    std::unordered_map<uint16_t, uint16_t> attrHandles;
+
+    /** @brief Attribute handle to the offset of its attribute value table
+     *         entry
+     */
+    std::unordered_map<uint16_t, size_t> attrValueEntryOffsets;
+
+    /** @brief Attribute name to the index of the attribute in biosAttributes
+     */
+    std::unordered_map<std::string, size_t> attrIndexes;
+
+    /** @brief Tables changed since they were last persisted */
+    std::set<uint8_t> dirtyTables;
+
+    /** @brief Timer coalescing the persistence of bursts of table changes */
+    sdbusplus::Timer persistTimer;
+
+    /** @brief Attribute value entries the BaseBIOSTable entries were decoded
+     *         from, keyed by attribute handle
+     */
+    std::unordered_map<uint16_t, Table> baseBIOSTableSources;
+
+    /** @brief Attributes changed since the BaseBIOSTable property was last
+     *         updated
+     */
+    std::set<std::string> dirtyBaseBIOSAttributes;
+
+    /** @brief Timer coalescing bursts of attribute changes into one
+     *         BaseBIOSTable property update
+     */
+    sdbusplus::Timer baseBIOSTableTimer;
+
+    /** @brief Store a table in memory and schedule its persistence
+     *  @param[in] tableType - The table type
+     *  @param[in] table - The table
+     */
+    void updateTable(uint8_t tableType, const Table& table);
+
+    /** @brief Persist the tables changed since they were last persisted */
+    void persistTables();
+
+    /** @brief Rebuild the index of a table after it was replaced
+     *  @param[in] tableType - The table type
+     */
+    void indexTable(uint8_t tableType);
+
+    /** @brief Find an entry of the attribute table
+     *  @param[in] attrHandle - The attribute handle
+     *  @return Pointer to the entry, valid until the attribute table is
+     *          replaced, nullptr if there is no such entry
+     */
+    const pldm_bios_attr_table_entry* findAttrEntry(uint16_t attrHandle) const;
+
+    /** @brief Find a BIOS attribute by name
+     *  @param[in] attrName - The attribute name
+     *  @return Pointer to the attribute, nullptr if there is no such attribute
+     */
+    BIOSAttribute* findAttribute(const std::string& attrName) const;
+
     /** @brief Method to update a BIOS attribute when the corresponding Dbus
      *  property is changed
      *  @param[in] chProperties - list of properties which have changed
@@ -209,6 +353,8 @@ class BIOSConfig
         {
             biosAttributes.push_back(std::make_unique<T>(entry, dbusHandler));
             auto biosAttrIndex = biosAttributes.size() - 1;
+            attrIndexes.emplace(biosAttributes[biosAttrIndex]->name,
+                                biosAttrIndex);
             auto dBusMap = biosAttributes[biosAttrIndex]->getDBusMap();
 
             if (dBusMap.has_value())
@@ -265,47 +411,44 @@ class BIOSConfig
      */
     std::optional<Table> buildAndStoreStringTable();
 
-    /** @brief Build attribute table and attribute value table and persist them
-     *         Read the BaseBIOSTable from the bios-settings-manager and update
-     *         attribute table and attribute value table.
-     *
-     *  @param[in] stringTable - The string Table
+    /** @brief Get the path of a cached table of the current BIOS attribute
+     *         JSON and system type
+     *  @param[in] tableType - The table type
+     *  @return The path, empty if the JSON can't be read
      */
-    void buildAndStoreAttrTables(const Table& stringTable);
+    fs::path cachedTablePath(uint8_t tableType) const;
 
-    /** @brief Persist the table
-     *  @param[in] path - Path to persist the table
-     *  @param[in] table - The table
+    /** @brief Load a table compiled from the current BIOS attribute JSON and
+     *         system type by a previous run
+     *  @param[in] tableType - The table type
+     *  @return The table, std::nullopt if there is no valid cached table
      */
-    void storeTable(const fs::path& path, const Table& table);
+    std::optional<Table> loadCachedTable(uint8_t tableType);
 
-    /** @brief Load bios table to ram
-     *  @param[in] path - Path of the table
-     *  @return The table, std::nullopt if loading fails
+    /** @brief Cache a table compiled from the current BIOS attribute JSON and
+     *         system type, replacing the table of other JSONs
+     *  @param[in] tableType - The table type
+     *  @param[in] table - The table
      */
-    std::optional<Table> loadTable(const fs::path& path);
+    void storeCachedTable(uint8_t tableType, const Table& table);
 
-    /** @brief Method to decode the attribute name from the string handle
+    /** @brief Build attribute table and attribute value table and persist them
+     *         Read the BaseBIOSTable from the bios-settings-manager and update
+     *         attribute table and attribute value table.
      *
-     *  @param[in] stringEntry - string entry from string table
-     *  @return the decoded string
+     *  @param[in] stringTable - The string Table
      */
-    std::string decodeStringFromStringEntry(
-        const pldm_bios_string_table_entry* stringEntry);
+    void buildAndStoreAttrTables(const Table& stringTable);
 
     /** @brief Method to print the string Handle by passing the attribute Handle
      *         of the bios attribute that got updated
      *
      *  @param[in] handle - the Attribute handle of the bios attribute
      *  @param[in] index - index to the possible value handles
-     *  @param[in] attrTable - the attribute table
-     *  @param[in] stringTable - the string table
      *  @return string handle from the string table and decoded string to the
      * name handle
      */
-    std::string displayStringHandle(uint16_t handle, uint8_t index,
-                                    const std::optional<Table>& attrTable,
-                                    const std::optional<Table>& stringTable);
+    std::string displayStringHandle(uint16_t handle, uint8_t index);
 
     /** @brief Method to trace the bios attribute which got changed
      *
@@ -327,22 +470,59 @@ class BIOSConfig
         const pldm_bios_attr_val_table_entry* attrValueEntry,
         const pldm_bios_attr_table_entry* attrEntry, Table& stringTable);
 
+    /** @struct AttrValueChange
+     *  An attribute value entry validated against the attribute table
+     */
+    struct AttrValueChange
+    {
+        const pldm_bios_attr_val_table_entry* attrValueEntry;
+        const pldm_bios_attr_table_entry* attrEntry;
+        BIOSAttribute* attribute;
+    };
+
+    /** @brief Check an attribute value entry to update
+     *  @param[in] entry - The attribute value entry to update
+     *  @param[out] change - The validated change, pointing into entry
+     *  @return pldm_completion_codes
+     */
+    int checkAttrValueEntry(const Table& entry, AttrValueChange& change);
+
+    /** @brief Apply a batch of attribute value entries that were validated
+     *         with checkAttrValueEntry, see setAttrValues
+     *  @param[in] entries - attribute value entries
+     *  @param[in] changes - the validated changes, one per entry
+     *  @param[in] isBMC - indicates if the attributes are set by BMC
+     *  @param[in] updateDBus - update Attr value D-Bus properties
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *  @return pldm_completion_codes
+     */
+    int applyAttrValues(const std::vector<Table>& entries,
+                        const std::vector<AttrValueChange>& changes,
+                        bool isBMC, bool updateDBus, bool updateBaseBIOSTable);
+
     /** @brief Check the attribute table
      *  @param[in] table - The table
      *  @return pldm_completion_codes
      */
     int checkAttributeTable(const Table& table);
 
-    /** @brief Check the attribute value table
+    /** @brief Check the attribute value table and update the BaseBIOSTable
+     *         entries of the attributes whose value changed
      *  @param[in] table - The table
      *  @return pldm_completion_codes
      */
     int checkAttributeValueTable(const Table& table);
 
-    /** @brief Update the BaseBIOSTable property of the D-Bus interface
+    /** @brief Schedule an update of the BaseBIOSTable property of the D-Bus
+     *         interface, bursts of changes are coalesced into one update
      */
     void updateBaseBIOSTableProperty();
 
+    /** @brief Update the BaseBIOSTable property of the D-Bus interface if
+     *         attributes changed since the last update
+     */
+    void publishBaseBIOSTable();
+
     /** @brief Listen the PendingAttributes property of the D-Bus interface and
      *         update BaseBIOSTable
      */
@@ -353,12 +533,6 @@ class BIOSConfig
      *  @return attribute handle
      */
     uint16_t findAttrHandle(const std::string& attrName);
-
-    /** @brief Listen the PendingAttributes property of the D-Bus interface
-     * and update BaseBIOSTable
-     *  @param[in] msg - Data associated with subscribed signal
-     */
-    void constructPendingAttribute(const PendingAttributes& pendingAttributes);
 };
 
 } // namespace bios
@@ -1,11 +1,17 @@
 #include "bios_table.hpp"
 
+#include "common/bios_utils.hpp"
+
+#include <fcntl.h>
 #include <libpldm/base.h>
 #include <libpldm/bios_table.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 
-#include <fstream>
+#include <cerrno>
+#include <system_error>
 
 PHOSPHOR_LOG2_USING;
 
@@ -33,49 +39,161 @@ bool BIOSTable::isEmpty() const noexcept
 
 void BIOSTable::store(const Table& table)
 {
-    std::ofstream stream(filePath.string(), std::ios::out | std::ios::binary);
-    stream.write(reinterpret_cast<const char*>(table.data()), table.size());
+    auto tmpPath = filePath;
+    tmpPath += ".tmp";
+
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create " + tmpPath.string());
+    }
+
+    size_t written = 0;
+    while (written < table.size())
+    {
+        auto rc = write(fd, table.data() + written, table.size() - written);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0)
+        {
+            auto err = errno;
+            close(fd);
+            fs::remove(tmpPath);
+            throw std::system_error(err, std::generic_category(),
+                                    "Failed to write " + tmpPath.string());
+        }
+        written += rc;
+    }
+
+    if (fsync(fd) < 0)
+    {
+        auto err = errno;
+        close(fd);
+        fs::remove(tmpPath);
+        throw std::system_error(err, std::generic_category(),
+                                "Failed to sync " + tmpPath.string());
+    }
+    close(fd);
+
+    fs::rename(tmpPath, filePath);
+
+    // sync the directory too, so that the rename survives a power loss
+    auto dirPath = filePath.parent_path();
+    if (dirPath.empty())
+    {
+        dirPath = ".";
+    }
+    int dirFd = open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open " + dirPath.string());
+    }
+    if (fsync(dirFd) < 0)
+    {
+        auto err = errno;
+        close(dirFd);
+        throw std::system_error(err, std::generic_category(),
+                                "Failed to sync " + dirPath.string());
+    }
+    close(dirFd);
 }
 
 void BIOSTable::load(Response& response) const
 {
-    auto currSize = response.size();
-    auto fileSize = fs::file_size(filePath);
-    response.resize(currSize + fileSize);
-    std::ifstream stream(filePath.string(), std::ios::in | std::ios::binary);
-    stream.read(reinterpret_cast<char*>(response.data() + currSize), fileSize);
+    int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open " + filePath.string());
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0)
+    {
+        auto err = errno;
+        close(fd);
+        throw std::system_error(err, std::generic_category(),
+                                "Failed to stat " + filePath.string());
+    }
+
+    size_t fileSize = st.st_size;
+    auto begin = response.size();
+    response.resize(begin + fileSize);
+
+    size_t loaded = 0;
+    while (loaded < fileSize)
+    {
+        auto rc = read(fd, response.data() + begin + loaded, fileSize - loaded);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc <= 0)
+        {
+            auto err = rc < 0 ? errno : EIO;
+            close(fd);
+            response.resize(begin);
+            throw std::system_error(err, std::generic_category(),
+                                    "Failed to read " + filePath.string());
+        }
+        loaded += rc;
+    }
+    close(fd);
 }
 
-BIOSStringTable::BIOSStringTable(const Table& stringTable) :
-    stringTable(stringTable)
-{}
+BIOSStringTable::BIOSStringTable(const Table& stringTable)
+{
+    index(stringTable);
+}
 
 BIOSStringTable::BIOSStringTable(const BIOSTable& biosTable)
 {
+    Table stringTable;
     biosTable.load(stringTable);
+    index(stringTable);
+}
+
+void BIOSStringTable::index(const Table& stringTable)
+{
+    if (stringTable.empty())
+    {
+        return;
+    }
+
+    for (auto entry :
+         pldm::bios::utils::BIOSTableIter<PLDM_BIOS_STRING_TABLE>(
+             stringTable.data(), stringTable.size()))
+    {
+        auto handle = table::string::decodeHandle(entry);
+        auto name = table::string::decodeString(entry);
+        handles.emplace(name, handle);
+        strings.emplace(handle, std::move(name));
+    }
 }
 
 std::string BIOSStringTable::findString(uint16_t handle) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable.data(), stringTable.size(), handle);
-    if (stringEntry == nullptr)
+    auto it = strings.find(handle);
+    if (it == strings.end())
     {
         throw std::invalid_argument("Invalid String Handle");
     }
-    return table::string::decodeString(stringEntry);
+    return it->second;
 }
 
 uint16_t BIOSStringTable::findHandle(const std::string& name) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_string(
-        stringTable.data(), stringTable.size(), name.c_str());
-    if (stringEntry == nullptr)
+    auto it = handles.find(name);
+    if (it == handles.end())
     {
         throw std::invalid_argument("Invalid String Name");
     }
-
-    return table::string::decodeHandle(stringEntry);
+    return it->second;
 }
 
 namespace table
@@ -270,6 +388,13 @@ TableHeader decodeHeader(const pldm_bios_attr_val_table_entry* entry)
     return {handle, type};
 }
 
+const pldm_bios_attr_val_table_entry* findByHandle(const Table& table,
+                                                   uint16_t handle)
+{
+    return pldm_bios_table_attr_value_find_by_handle(table.data(),
+                                                     table.size(), handle);
+}
+
 std::string decodeStringEntry(const pldm_bios_attr_val_table_entry* entry)
 {
     variable_field currentString{};
@@ -386,6 +511,55 @@ std::optional<Table> updateTable(const Table& table, const void* entry,
     return destTable;
 }
 
+std::optional<Table> updateTable(const Table& table,
+                                 const std::vector<Table>& entries)
+{
+    std::unordered_map<uint16_t, const Table*> newEntries;
+    size_t newEntriesSize = 0;
+    for (const auto& entry : entries)
+    {
+        if (entry.size() < sizeof(pldm_bios_attr_val_table_entry))
+        {
+            return std::nullopt;
+        }
+        auto header = decodeHeader(
+            reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                entry.data()));
+        newEntries[header.attrHandle] = &entry;
+        newEntriesSize += entry.size();
+    }
+
+    Table destTable;
+    destTable.reserve(table.size() + newEntriesSize);
+    size_t replaced = 0;
+
+    using pldm::bios::utils::BIOSTableIter;
+    for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(table.data(),
+                                                              table.size()))
+    {
+        auto it = newEntries.find(decodeHeader(entry).attrHandle);
+        if (it != newEntries.end())
+        {
+            destTable.insert(destTable.end(), it->second->begin(),
+                             it->second->end());
+            ++replaced;
+            continue;
+        }
+
+        auto data = reinterpret_cast<const uint8_t*>(entry);
+        destTable.insert(destTable.end(), data,
+                         data + pldm_bios_table_attr_value_entry_length(entry));
+    }
+
+    if (replaced != newEntries.size())
+    {
+        return std::nullopt;
+    }
+
+    appendPadAndChecksum(destTable);
+    return destTable;
+}
+
 } // namespace attribute_value
 
 } // namespace table
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -56,15 +57,24 @@ class BIOSTable
     bool isEmpty() const noexcept;
 
     /** @brief Persist a BIOS table(string/attribute/attribute value)
+     *
+     *  The table is written to a temporary file which is synced and renamed
+     *  over the persisted table, and the directory is synced after the
+     *  rename, so that a crash leaves either the previous or the new table.
      *
      *  @param[in] table - BIOS table
+     *
+     *  @throw std::system_error if the table could not be persisted
      */
     void store(const Table& table);
 
-    /** @brief Load BIOS table from persistent store to memory
+    /** @brief Load BIOS table from persistent store to memory, the file is
+     *         read straight into the response rather than through a stream
      *
      *  @param[in,out] response - PLDM response message to GetBIOSTable
      *  (excluding table), table will be pushed back to this.
+     *
+     *  @throw std::system_error if the table could not be loaded
      */
     void load(Response& response) const;
 
@@ -98,6 +108,9 @@ class BIOSStringTableInterface
 
 /** @class BIOSStringTable
  *  @brief Collection of BIOS string table operations.
+ *
+ *  The table is indexed by handle and by name on construction, so lookups
+ *  do not scan the table.
  */
 class BIOSStringTable : public BIOSStringTableInterface
 {
@@ -130,8 +143,27 @@ class BIOSStringTable : public BIOSStringTableInterface
      */
     uint16_t findHandle(const std::string& name) const override;
 
+    /** @brief Check if the BIOS string table has a string handle
+     *  @param[in] handle - string handle
+     *  @return true if the table has a string with the handle
+     */
+    bool hasHandle(uint16_t handle) const
+    {
+        return strings.contains(handle);
+    }
+
   private:
-    Table stringTable;
+    /** @brief Index the entries of a string table
+     *
+     *  @param[in] stringTable - The string table
+     */
+    void index(const Table& stringTable);
+
+    /** @brief string handle to name */
+    std::unordered_map<uint16_t, std::string> strings;
+
+    /** @brief name to string handle */
+    std::unordered_map<std::string, uint16_t> handles;
 };
 
 namespace table
@@ -301,6 +333,14 @@ struct TableHeader
  */
 TableHeader decodeHeader(const pldm_bios_attr_val_table_entry* entry);
 
+/** @brief Find attribute value entry by handle
+ *  @param[in] table - The attribute value table
+ *  @param[in] handle - attribute handle
+ *  @return Pointer to the attribute value table entry
+ */
+const pldm_bios_attr_val_table_entry* findByHandle(const Table& table,
+                                                   uint16_t handle);
+
 /** @brief Decode string entry of attribute value table
  *  @param[in] entry - Pointer to an attribute value table entry
  *  @return The decoded string
@@ -364,6 +404,16 @@ const pldm_bios_attr_val_table_entry* constructEnumEntry(
 std::optional<Table> updateTable(const Table& table, const void* entry,
                                  size_t size);
 
+/** @brief construct a table with a set of new entries, in one pass
+ *  @param[in] table - the table need to be updated
+ *  @param[in] entries - the new attribute value entries, if an attribute has
+ *                       several entries the last one is used
+ *  @return newly constructed table, std::nullopt if an entry does not
+ *          replace an entry of the table
+ */
+std::optional<Table> updateTable(const Table& table,
+                                 const std::vector<Table>& entries);
+
 } // namespace attribute_value
 
 } // namespace table
@@ -70,6 +70,7 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
             dbusInfo.interface = dbus.value("interface", "");
             dbusInfo.propertyName = dbus.value("property_name", "");
             dbusInfo.propertyType = dbus.value("property_type", "");
+            dbusInfo.type = pldm::utils::toPropertyType(dbusInfo.propertyType);
             if (dbusInfo.objectPath.empty() || dbusInfo.interface.empty() ||
                 dbusInfo.propertyName.empty() ||
                 !supportedDbusPropertyTypes.contains(dbusInfo.propertyType))
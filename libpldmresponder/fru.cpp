@@ -1,5 +1,7 @@
 #include "fru.hpp"
 
+#include "common/multipart_transfer.hpp"
+#include "common/pdr_journal.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/platform.hpp"
@@ -11,17 +13,22 @@
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 #include <xyz/openbmc_project/Association/common.hpp>
+#include <xyz/openbmc_project/Inventory/Item/common.hpp>
 #include <xyz/openbmc_project/Software/Version/client.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <set>
 #include <stack>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
 using SoftwareVersion =
     sdbusplus::common::xyz::openbmc_project::software::Version;
 using Association = sdbusplus::common::xyz::openbmc_project::Association;
+using InventoryItem = sdbusplus::common::xyz::openbmc_project::inventory::Item;
 
 namespace pldm
 {
@@ -30,26 +37,89 @@ namespace responder
 
 constexpr auto root = "/xyz/openbmc_project/inventory/";
 
+namespace
+{
+
+/** @brief Check the Present property of an inventory object, as found in the
+ *         GetManagedObjects snapshot of the inventory
+ *
+ *  @param[in] interfaces - D-Bus interfaces and properties of the object
+ *
+ *  @return true if the FRU is present
+ */
+bool isFruPresent(const dbus::InterfaceMap& interfaces)
+{
+    auto itemIntf = interfaces.find(InventoryItem::interface);
+    if (itemIntf == interfaces.end())
+    {
+        return false;
+    }
+
+    auto present =
+        itemIntf->second.find(InventoryItem::property_names::present);
+    if (present == itemIntf->second.end())
+    {
+        return false;
+    }
+
+    auto value = std::get_if<bool>(&present->second);
+    return value && *value;
+}
+
+} // namespace
+
 std::optional<pldm_entity> FruImpl::getEntityByObjectPath(
     const dbus::InterfaceMap& intfMaps)
 {
     for (const auto& intfMap : intfMaps)
     {
-        try
+        auto entityType = parser.findEntityType(intfMap.first);
+        if (entityType)
         {
             pldm_entity entity{};
-            entity.entity_type = parser.getEntityType(intfMap.first);
+            entity.entity_type = *entityType;
             return entity;
         }
-        catch (const std::exception&)
-        {
-            continue;
-        }
     }
 
     return std::nullopt;
 }
 
+void FruImpl::addEntityNode(const dbus::ObjectPath& path,
+                            pldm_entity_node* node)
+{
+    objToEntityNode[path] = node;
+
+    auto entityType = pldm_entity_extract(node).entity_type;
+    auto [it, added] = entityTypeToFirstObjPath.try_emplace(entityType, path);
+    if (!added && path < it->second)
+    {
+        it->second = path;
+    }
+}
+
+void FruImpl::removeEntityNode(const dbus::ObjectPath& path,
+                               uint16_t entityType)
+{
+    objToEntityNode.erase(path);
+
+    auto it = entityTypeToFirstObjPath.find(entityType);
+    if (it == entityTypeToFirstObjPath.end() || it->second != path)
+    {
+        return;
+    }
+
+    entityTypeToFirstObjPath.erase(it);
+    for (const auto& [objPath, node] : objToEntityNode)
+    {
+        if (pldm_entity_extract(node).entity_type == entityType)
+        {
+            entityTypeToFirstObjPath.emplace(entityType, objPath);
+            break;
+        }
+    }
+}
+
 void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
                                     const std::string& path)
 {
@@ -68,12 +138,6 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
         obj = pldm::utils::findParent(obj);
     }
 
-    std::stack<std::string> tmpObj = tmpObjPaths;
-    while (!tmpObj.empty())
-    {
-        std::string s = tmpObj.top();
-        tmpObj.pop();
-    }
     // Update pldm entity to association tree
     std::string prePath = tmpObjPaths.top();
     while (!tmpObjPaths.empty())
@@ -83,10 +147,10 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
 
         do
         {
-            if (objToEntityNode.contains(currPath))
+            auto entityNode = objToEntityNode.find(currPath);
+            if (entityNode != objToEntityNode.end())
             {
-                pldm_entity node =
-                    pldm_entity_extract(objToEntityNode.at(currPath));
+                pldm_entity node = pldm_entity_extract(entityNode->second);
                 if (pldm_entity_association_tree_find_with_locality(
                         entityTree, &node, false))
                 {
@@ -95,12 +159,13 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
             }
             else
             {
-                if (!objects.contains(currPath))
+                auto object = objects.find(currPath);
+                if (object == objects.end())
                 {
                     break;
                 }
 
-                auto entityPtr = getEntityByObjectPath(objects.at(currPath));
+                auto entityPtr = getEntityByObjectPath(object->second);
                 if (!entityPtr)
                 {
                     break;
@@ -108,15 +173,13 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
 
                 pldm_entity entity = *entityPtr;
 
-                for (const auto& it : objToEntityNode)
+                auto firstObjPath =
+                    entityTypeToFirstObjPath.find(entity.entity_type);
+                if (firstObjPath != entityTypeToFirstObjPath.end())
                 {
-                    pldm_entity node = pldm_entity_extract(it.second);
-                    if (node.entity_type == entity.entity_type)
-                    {
-                        entity.entity_instance_num =
-                            node.entity_instance_num + 1;
-                        break;
-                    }
+                    pldm_entity node = pldm_entity_extract(
+                        objToEntityNode.at(firstObjPath->second));
+                    entity.entity_instance_num = node.entity_instance_num + 1;
                 }
 
                 if (currPath == prePath)
@@ -124,18 +187,18 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
                     auto node = pldm_entity_association_tree_add_entity(
                         entityTree, &entity, 0xFFFF, nullptr,
                         PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
-                    objToEntityNode[currPath] = node;
+                    addEntityNode(currPath, node);
                 }
                 else
                 {
-                    if (objToEntityNode.contains(prePath))
+                    auto parentNode = objToEntityNode.find(prePath);
+                    if (parentNode != objToEntityNode.end())
                     {
                         auto node = pldm_entity_association_tree_add_entity(
-                            entityTree, &entity, 0xFFFF,
-                            objToEntityNode[prePath],
+                            entityTree, &entity, 0xFFFF, parentNode->second,
                             PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true,
                             0xFFFF);
-                        objToEntityNode[currPath] = node;
+                        addEntityNode(currPath, node);
                     }
                 }
             }
@@ -152,13 +215,36 @@ void FruImpl::buildFRUTable()
         return;
     }
 
-    fru_parser::DBusLookupInfo dbusInfo;
+    dbus::ObjectValueTree inventory;
+    try
+    {
+        inventory = pldm::utils::DBusHandler::getInventoryObjects<
+            pldm::utils::DBusHandler>();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to build FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+
+    // The BMC version is read once up front, the build makes no D-Bus call
+    buildFRUTable(std::move(inventory), populatefwVersion());
+}
+
+void FruImpl::buildFRUTable(dbus::ObjectValueTree inventory,
+                            const std::string& bmcVersion)
+{
+    if (isBuilt)
+    {
+        return;
+    }
 
+    fru_parser::DBusLookupInfo dbusInfo;
     try
     {
         dbusInfo = parser.inventoryLookup();
-        objects = pldm::utils::DBusHandler::getInventoryObjects<
-            pldm::utils::DBusHandler>();
     }
     catch (const std::exception& e)
     {
@@ -167,9 +253,11 @@ void FruImpl::buildFRUTable()
             "ERROR", e);
         return;
     }
+    objects = std::move(inventory);
 
-    auto itemIntfsLookup = std::get<2>(dbusInfo);
+    const auto& itemIntfsLookup = std::get<2>(dbusInfo);
 
+    auto start = std::chrono::steady_clock::now();
     for (const auto& object : objects)
     {
         const auto& interfaces = object.second;
@@ -177,8 +265,8 @@ void FruImpl::buildFRUTable()
         {
             if (itemIntfsLookup.contains(interface.first))
             {
-                // checking fru present property is available or not.
-                if (!pldm::utils::checkForFruPresence(object.first.str))
+                // The Present property is part of the inventory snapshot
+                if (!isFruPresent(interfaces))
                 {
                     continue;
                 }
@@ -190,16 +278,15 @@ void FruImpl::buildFRUTable()
                 {
                     updateAssociationTree(objects, object.first.str);
                     pldm_entity entity{};
-                    if (objToEntityNode.contains(object.first.str))
+                    auto node = objToEntityNode.find(object.first.str);
+                    if (node != objToEntityNode.end())
                     {
-                        pldm_entity_node* node =
-                            objToEntityNode.at(object.first.str);
-
-                        entity = pldm_entity_extract(node);
+                        entity = pldm_entity_extract(node->second);
                     }
 
                     auto recordInfos = parser.getRecordInfo(interface.first);
-                    populateRecords(interfaces, recordInfos, entity);
+                    populateRecords(interfaces, recordInfos, entity,
+                                    bmcVersion);
 
                     associatedEntityMap.emplace(object.first, entity);
                     break;
@@ -215,8 +302,12 @@ void FruImpl::buildFRUTable()
         }
     }
 
-    int rc = pldm_entity_association_pdr_add(entityTree, pdrRepo, false,
+    // The handles of the added entity association PDRs are not returned
+    int rc = 0;
+    pldm::utils::recordPDRDelta(getPDRJournal(), pdrRepo, [&] {
+        rc = pldm_entity_association_pdr_add(entityTree, pdrRepo, false,
                                              TERMINUS_HANDLE);
+    });
     if (rc < 0)
     {
         // pldm_entity_assocation_pdr_add() assert()ed on failure
@@ -228,6 +319,13 @@ void FruImpl::buildFRUTable()
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
 
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    info(
+        "Built FRU table of {COUNT} records from {OBJECTS} inventory objects in {DURATION} ms",
+        "COUNT", records.numRecords(), "OBJECTS", objects.size(), "DURATION",
+        elapsed.count());
+
     isBuilt = true;
 }
 std::string FruImpl::populatefwVersion()
@@ -262,12 +360,12 @@ std::string FruImpl::populatefwVersion()
 }
 void FruImpl::populateRecords(
     const pldm::responder::dbus::InterfaceMap& interfaces,
-    const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity)
+    const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity,
+    const std::string& bmcVersion)
 {
     // recordSetIdentifier for the FRU will be set when the first record gets
     // added for the FRU
     uint16_t recordSetIdentifier = 0;
-    auto numRecsCount = numRecs;
     static uint32_t bmc_record_handle = 0;
 
     for (const auto& [recType, encType, fieldInfos] : recordInfos)
@@ -284,7 +382,7 @@ void FruImpl::populateRecords(
                 // that should be the top most container as per dbus hierarchy)
                 if (entity.entity_container_id == 0 && prop == "Version")
                 {
-                    propValue = populatefwVersion();
+                    propValue = bmcVersion;
                 }
                 else
                 {
@@ -327,7 +425,7 @@ void FruImpl::populateRecords(
 
         if (tlvs.size())
         {
-            if (numRecs == numRecsCount)
+            if (!recordSetIdentifier)
             {
                 recordSetIdentifier = nextRSI();
                 bmc_record_handle = nextRecordHandle();
@@ -341,79 +439,21 @@ void FruImpl::populateRecords(
                     throw std::runtime_error(
                         "Failed to add PDR FRU record set");
                 }
+                recordPDRChange(PLDM_RECORDS_ADDED, bmc_record_handle);
             }
-            auto curSize = table.size();
-            table.resize(curSize + recHeaderSize + tlvs.size());
-            encode_fru_record(table.data(), table.size(), &curSize,
-                              recordSetIdentifier, recType, numFRUFields,
-                              encType, tlvs.data(), tlvs.size());
-            numRecs++;
+            records.add(recordSetIdentifier, recType, encType, numFRUFields,
+                        tlvs);
+            tableChanged();
         }
     }
 }
 
 void FruImpl::deleteFRURecord(uint16_t rsi)
 {
-    std::vector<uint8_t> updatedFruTbl;
-    size_t pos = 0;
-
-    while (pos < table.size())
+    if (records.remove(rsi))
     {
-        // Ensure enough space for the record header
-        if ((table.size() - pos) < sizeof(struct pldm_fru_record_data_format))
-        {
-            // Log or handle corrupt/truncated record
-            error("Error: Incomplete FRU record header");
-            return;
-        }
-
-        auto recordSetSrc =
-            reinterpret_cast<const struct pldm_fru_record_data_format*>(
-                &table[pos]);
-
-        size_t recordLen = sizeof(struct pldm_fru_record_data_format) -
-                           sizeof(struct pldm_fru_record_tlv);
-
-        const struct pldm_fru_record_tlv* tlv = recordSetSrc->tlvs;
-
-        for (uint8_t i = 0; i < recordSetSrc->num_fru_fields; ++i)
-        {
-            if ((table.size() - pos) < (recordLen + sizeof(*tlv)))
-            {
-                error("Error: Incomplete TLV header");
-                return;
-            }
-
-            size_t len = sizeof(*tlv) - 1 + tlv->length;
-
-            if ((table.size() - pos) < (recordLen + len))
-            {
-                error("Error: Incomplete TLV data");
-                return;
-            }
-
-            recordLen += len;
-
-            // Advance to next tlv
-            tlv = reinterpret_cast<const struct pldm_fru_record_tlv*>(
-                reinterpret_cast<const uint8_t*>(tlv) + len);
-        }
-
-        if ((le16toh(recordSetSrc->record_set_id) != rsi && rsi != 0))
-        {
-            std::copy(table.begin() + pos, table.begin() + pos + recordLen,
-                      std::back_inserter(updatedFruTbl));
-        }
-        else
-        {
-            // Deleted record
-            numRecs--;
-        }
-
-        pos += recordLen;
+        tableChanged();
     }
-    // Replace the old table with the updated one
-    table = std::move(updatedFruTbl);
 }
 
 void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
@@ -434,6 +474,8 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
     uint32_t updateRecordHdlHost = 0;
     uint32_t deleteRecordHdl = 0;
     bool hasError = false;
+    auto journal = getPDRJournal();
+    auto generation = journal ? journal->getGeneration() : 0;
 
     auto fruRecord = pldm_pdr_fru_record_set_find_by_rsi(
         pdrRepo, rsi, &terminusHdl, &entityType, &entityInsNum, &containerId);
@@ -473,6 +515,10 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
     }
     auto bmcEventDataOps =
         record ? PLDM_RECORDS_MODIFIED : PLDM_RECORDS_DELETED;
+    if (removeBmcEntityRc == 0 && updateRecordHdlBmc != 0)
+    {
+        recordPDRChange(bmcEventDataOps, updateRecordHdlBmc);
+    }
 
     int removeHostEntityRc = -1;
     uint8_t hostEventDataOps = 0;
@@ -503,6 +549,10 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
 
         hostEventDataOps = record ? PLDM_RECORDS_MODIFIED
                                   : PLDM_RECORDS_DELETED;
+        if (removeHostEntityRc == 0 && updateRecordHdlHost != 0)
+        {
+            recordPDRChange(hostEventDataOps, updateRecordHdlHost);
+        }
     }
     if (hasError)
     {
@@ -519,6 +569,10 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
         error("Failed to remove FRU record set for RSI {RSI}. RC = {RC}", "RSI",
               rsi, "RC", rc);
     }
+    else if (deleteRecordHdl != 0)
+    {
+        recordPDRChange(PLDM_RECORDS_DELETED, deleteRecordHdl);
+    }
 
     if (!hasError)
     {
@@ -550,7 +604,7 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
     }
 
     objectPathToRSIMap.erase(fruObjPath);
-    objToEntityNode.erase(fruObjPath);
+    removeEntityNode(fruObjPath, removeEntity.entity_type);
     info(
         "Removing Individual FRU [ {FRU_OBJ_PATH} ] with entityid [ {ENTITY_TYPE}, {ENTITY_NUM}, {ENTITY_ID} ]",
         "FRU_OBJ_PATH", fruObjPath, "ENTITY_TYPE",
@@ -561,12 +615,6 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
 
     deleteFRURecord(rsi);
 
-    std::vector<ChangeEntry> handlesTobeDeleted;
-    if (deleteRecordHdl != 0)
-    {
-        handlesTobeDeleted.push_back(deleteRecordHdl);
-    }
-
     std::vector<uint16_t> effecterIDs = pldm::utils::findEffecterIds(
         pdrRepo, removeEntity.entity_type, removeEntity.entity_instance_num,
         removeEntity.entity_container_id);
@@ -586,7 +634,7 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
         effecterDbusObjMaps.erase(ids);
         if (delEffecterHdl != 0)
         {
-            handlesTobeDeleted.push_back(delEffecterHdl);
+            recordPDRChange(PLDM_RECORDS_DELETED, delEffecterHdl);
         }
     }
     std::vector<uint16_t> sensorIDs = pldm::utils::findSensorIds(
@@ -608,78 +656,64 @@ void FruImpl::removeIndividualFRU(const std::string& fruObjPath)
         sensorDbusObjMaps.erase(ids);
         if (delSensorHdl != 0)
         {
-            handlesTobeDeleted.push_back(delSensorHdl);
+            recordPDRChange(PLDM_RECORDS_DELETED, delSensorHdl);
         }
     }
 
-    // need to send both remote and local records. Host keeps track of BMC
-    // only records
-    std::vector<ChangeEntry> handlesTobeModified;
-    if (removeBmcEntityRc == 0 && updateRecordHdlBmc != 0)
-    {
-        (bmcEventDataOps == PLDM_RECORDS_DELETED)
-            ? handlesTobeDeleted.push_back(updateRecordHdlBmc)
-            : handlesTobeModified.push_back(updateRecordHdlBmc);
-    }
-    if (removeHostEntityRc == 0 && updateRecordHdlHost != 0)
-    {
-        (hostEventDataOps == PLDM_RECORDS_DELETED)
-            ? handlesTobeDeleted.push_back(updateRecordHdlHost)
-            : handlesTobeModified.push_back(updateRecordHdlHost);
-    }
-    // Adapter PDRs can have deleted records
-    if (!handlesTobeDeleted.empty())
-    {
-        platformHandler->sendPDRRepositoryChgEventbyPDRHandles(
-            handlesTobeDeleted, std::vector<uint8_t>{PLDM_RECORDS_DELETED});
-    }
-    if (!handlesTobeModified.empty())
-    {
-        platformHandler->sendPDRRepositoryChgEventbyPDRHandles(
-            handlesTobeModified, std::vector<uint8_t>{PLDM_RECORDS_MODIFIED});
-    }
+    // Both the BMC and the host records are announced, the host keeps track
+    // of the BMC only records. The changes were journaled as they were made,
+    // so the host is sent a single event covering only the records of this
+    // FRU.
+    platformHandler->sendPDRRepositoryChgEventSince(generation);
 }
 
-std::vector<uint8_t> FruImpl::tableResize()
+pldm::utils::PDRJournal* FruImpl::getPDRJournal()
 {
-    std::vector<uint8_t> tempTable;
+    return platformHandler ? &platformHandler->getRepo().getJournal()
+                           : nullptr;
+}
 
-    if (table.size())
+void FruImpl::recordPDRChange(uint8_t eventDataOp, uint32_t recordHandle)
+{
+    if (auto journal = getPDRJournal())
     {
-        std::copy(table.begin(), table.end(), std::back_inserter(tempTable));
-        padBytes = pldm::utils::getNumPadBytes(table.size());
-        tempTable.resize(tempTable.size() + padBytes, 0);
+        journal->recordChange(eventDataOp, recordHandle);
     }
-    return tempTable;
 }
 
-void FruImpl::getFRUTable(Response& response)
+const std::vector<uint8_t>& FruImpl::getTableImage()
 {
-    auto hdrSize = response.size();
-    std::vector<uint8_t> tempTable;
+    if (!tableImage.empty())
+    {
+        return tableImage;
+    }
+
+    const auto& table = records.table();
 
+    // At most 3 pad bytes
+    tableImage.reserve(table.size() + 3 + sizeof(checksum));
+    tableImage.assign(table.begin(), table.end());
     if (table.size())
     {
-        tempTable = tableResize();
-        checksum = pldm_edac_crc32(tempTable.data(), tempTable.size());
+        tableImage.resize(
+            table.size() + pldm::utils::getNumPadBytes(table.size()), 0);
+        checksum = pldm_edac_crc32(tableImage.data(), tableImage.size());
     }
-    response.resize(hdrSize + tempTable.size() + sizeof(checksum), 0);
-    std::copy(tempTable.begin(), tempTable.end(), response.begin() + hdrSize);
-
-    // Copy the checksum to response data
-    auto iter = response.begin() + hdrSize + tempTable.size();
     std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+                std::back_inserter(tableImage));
+
+    return tableImage;
+}
+
+void FruImpl::getFRUTable(Response& response)
+{
+    const auto& image = getTableImage();
+    response.insert(response.end(), image.begin(), image.end());
 }
 
 void FruImpl::getFRURecordTableMetadata()
 {
-    std::vector<uint8_t> tempTable;
-    if (table.size())
-    {
-        tempTable = tableResize();
-        checksum = pldm_edac_crc32(tempTable.data(), tempTable.size());
-    }
+    getTableImage();
 }
 
 int FruImpl::getFRURecordByOption(
@@ -691,16 +725,25 @@ int FruImpl::getFRURecordByOption(
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
+    // Only the records of the record set are searched, a zero identifier is
+    // left to libpldm to match against the whole table
+    const auto* table = recordSetIdentifer ? records.find(recordSetIdentifer)
+                                           : &records.table();
+    if (!table)
+    {
+        return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+    }
+
     /* 7 is sizeof(checksum,4) + padBytesMax(3)
      * We can not know size of the record table got by options in advance, but
      * it must be less than the source table. So it's safe to use sizeof the
      * source table + 7 as the buffer length
      */
-    size_t recordTableSize = table.size() - padBytes + 7;
+    size_t recordTableSize = table->size() + 7;
     fruData.resize(recordTableSize, 0);
 
     int rc = get_fru_record_by_option(
-        table.data(), table.size() - padBytes, fruData.data(), &recordTableSize,
+        table->data(), table->size(), fruData.data(), &recordTableSize,
         recordSetIdentifer, recordType, fieldType);
 
     if (rc != PLDM_SUCCESS || recordTableSize == 0)
@@ -709,11 +752,12 @@ int FruImpl::getFRURecordByOption(
     }
 
     auto pads = pldm::utils::getNumPadBytes(recordTableSize);
-    pldm_edac_crc32(fruData.data(), recordTableSize + pads);
+    auto recordsChecksum = pldm_edac_crc32(fruData.data(),
+                                           recordTableSize + pads);
 
     auto iter = fruData.begin() + recordTableSize + pads;
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+    std::copy_n(reinterpret_cast<const uint8_t*>(&recordsChecksum),
+                sizeof(recordsChecksum), iter);
     fruData.resize(recordTableSize + pads + sizeof(sum));
 
     return PLDM_SUCCESS;
@@ -742,6 +786,8 @@ uint32_t FruImpl::addHotPlugRecord(
 {
     uint32_t lastHandle = 0;
     uint32_t recordHandle = 0;
+    auto journal = getPDRJournal();
+    auto generation = journal ? journal->getGeneration() : 0;
 
     if (oemPlatformHandler)
     {
@@ -752,6 +798,11 @@ uint32_t FruImpl::addHotPlugRecord(
     pdrEntry.handle.recordHandle = lastHandle + 1;
     pldm_pdr_add(pdrRepo, pdrEntry.data, pdrEntry.size, false,
                  pdrEntry.handle.recordHandle, &recordHandle);
+    recordPDRChange(PLDM_RECORDS_ADDED, recordHandle);
+    if (platformHandler)
+    {
+        platformHandler->sendPDRRepositoryChgEventSince(generation);
+    }
 
     return recordHandle;
 }
@@ -798,19 +849,58 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
+    uint32_t transferHandle{};
+    uint8_t transferOpFlag{};
+    auto rc = decode_get_fru_record_table_req(request, payloadLength,
+                                              &transferHandle, &transferOpFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    if (transferOpFlag != PLDM_GET_FIRSTPART &&
+        transferOpFlag != PLDM_GET_NEXTPART)
+    {
+        return ccOnlyResponse(request,
+                              PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG);
+    }
+
+    const auto& image = impl.getTableImage();
+    auto partSize =
+        multipart::getPartSize(image.size(), FRU_TABLE_TRANSFER_SIZE);
+    auto numParts = multipart::getNumParts(image.size(), partSize);
+    auto version = impl.getTableVersion();
+
+    auto part = multipart::getRequestedPart(transferOpFlag, transferHandle,
+                                            version, numParts);
+    if (!part)
+    {
+        error(
+            "Stale or invalid transfer handle {HANDLE} for the FRU record table",
+            "HANDLE", transferHandle);
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    }
+
+    auto transferFlag = multipart::getTransferFlag(*part, numParts);
+    auto nextTransferHandle =
+        multipart::getNextTransferHandle(version, *part, numParts);
+
+    auto offset = *part * partSize;
+    auto length = std::min(partSize, image.size() - offset);
     Response response(
         sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
     auto responsePtr = new (response.data()) pldm_msg;
 
-    auto rc =
-        encode_get_fru_record_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                         0, PLDM_START_AND_END, responsePtr);
+    rc = encode_get_fru_record_table_resp(request->hdr.instance_id,
+                                          PLDM_SUCCESS, nextTransferHandle,
+                                          transferFlag, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    impl.getFRUTable(response);
+    response.insert(response.end(), image.begin() + offset,
+                    image.begin() + offset + length);
 
     return response;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fru_parser.hpp"
+#include "fru_record_store.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -84,15 +85,16 @@ class FruImpl
      */
     uint32_t size() const
     {
-        return table.size();
+        return records.size();
     }
 
     /** @brief The checksum of the contents of the FRU table
      *
      *  @return checksum
      */
-    uint32_t checkSum() const
+    uint32_t checkSum()
     {
+        getTableImage();
         return checksum;
     }
 
@@ -111,7 +113,7 @@ class FruImpl
      */
     uint16_t numRecords() const
     {
-        return numRecs;
+        return records.numRecords();
     }
 
     /** @brief Get the FRU table
@@ -120,6 +122,24 @@ class FruImpl
      */
     void getFRUTable(Response& response);
 
+    /** @brief Get the FRU table as transferred by GetFRURecordTable, the
+     *         records followed by the pad bytes and the checksum
+     *
+     *  The image is built once after each change of the table.
+     *
+     *  @return the FRU table image, valid until the table changes
+     */
+    const std::vector<uint8_t>& getTableImage();
+
+    /** @brief Version of the FRU table, it changes whenever the table changes
+     *
+     *  @return version of the FRU table
+     */
+    uint32_t getTableVersion() const
+    {
+        return tableVersion;
+    }
+
     /** @brief Get the Fru Table MetaData
      *
      */
@@ -143,6 +163,17 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Build the FRU table from a snapshot of the inventory, without
+     *         any D-Bus call
+     *
+     *  @param[in] inventory - GetManagedObjects snapshot of the inventory, a
+     *                         FRU is included if its Present property is true
+     *  @param[in] bmcVersion - version of the running BMC firmware, the
+     *                          Version field of the system FRU
+     */
+    void buildFRUTable(dbus::ObjectValueTree inventory,
+                       const std::string& bmcVersion);
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -201,12 +232,6 @@ class FruImpl
      */
     std::string populatefwVersion();
 
-    /* @brief Method to resize the table
-     *
-     * @return resized table
-     */
-    std::vector<uint8_t> tableResize();
-
     /* @brief set FRU Record Table
      *
      * @param[in] fruData - the data of the fru
@@ -235,6 +260,22 @@ class FruImpl
         return ++rsi;
     }
 
+    /** @brief Get the change journal of the PDR repository
+     *
+     *  @return the journal of the repository of the platform handler, nullptr
+     *          if no platform handler is set
+     */
+    pldm::utils::PDRJournal* getPDRJournal();
+
+    /** @brief Record a change of a PDR record in the change journal of the
+     *         PDR repository, if it has one
+     *
+     *  @param[in] eventDataOp - PLDM_RECORDS_ADDED, PLDM_RECORDS_DELETED or
+     *                           PLDM_RECORDS_MODIFIED
+     *  @param[in] recordHandle - handle of the changed PDR record
+     */
+    void recordPDRChange(uint8_t eventDataOp, uint32_t recordHandle);
+
     uint32_t nextRecordHandle()
     {
         return ++rh;
@@ -242,12 +283,25 @@ class FruImpl
 
     uint32_t rh = 0;
     uint16_t rsi = 0;
-    uint16_t numRecs = 0;
-    uint8_t padBytes = 0;
-    std::vector<uint8_t> table;
+    FruRecordStore records;
     uint32_t checksum = 0;
     bool isBuilt = false;
 
+    /** @brief The FRU table with its pad bytes and checksum, empty until it
+     *         is requested after a change of the table
+     */
+    std::vector<uint8_t> tableImage;
+
+    /** @brief Bumped whenever the FRU table changes */
+    uint32_t tableVersion = 0;
+
+    /** @brief Drop the table image after a change of the table */
+    void tableChanged()
+    {
+        tableImage.clear();
+        ++tableVersion;
+    }
+
     fru_parser::FruParser parser;
     pldm_pdr* pdrRepo;
     pldm_entity_association_tree* entityTree;
@@ -261,6 +315,25 @@ class FruImpl
 
     std::map<dbus::ObjectPath, pldm_entity_node*> objToEntityNode{};
 
+    /** @brief First object path, in objToEntityNode order, of each entity
+     *         type. New entities are numbered after the entity of that path.
+     */
+    std::map<uint16_t, dbus::ObjectPath> entityTypeToFirstObjPath{};
+
+    /** @brief Record the entity node of an object path
+     *
+     *  @param[in] path - object path of the entity
+     *  @param[in] node - entity node in the entity association tree
+     */
+    void addEntityNode(const dbus::ObjectPath& path, pldm_entity_node* node);
+
+    /** @brief Forget the entity node of an object path
+     *
+     *  @param[in] path - object path of the entity
+     *  @param[in] entityType - type of the entity
+     */
+    void removeEntityNode(const dbus::ObjectPath& path, uint16_t entityType);
+
     dbus::ObjectPathToRSIMap objectPathToRSIMap{};
 
     pdr_utils::DbusObjMaps effecterDbusObjMaps{};
@@ -273,14 +346,17 @@ class FruImpl
      *                          values for the FRU
      *  @param[in] recordInfos - FRU record info to build the FRU records
      *  @param[in/out] entity - PLDM entity corresponding to FRU instance
+     *  @param[in] bmcVersion - version of the running BMC firmware
      */
     void populateRecords(const dbus::InterfaceMap& interfaces,
                          const fru_parser::FruRecordInfos& recordInfos,
-                         const pldm_entity& entity);
+                         const pldm_entity& entity,
+                         const std::string& bmcVersion);
 
     /** @brief Add hotplug record that was modified or added to the PDR entry
      *  HotPlug is a feature where a FRU can be removed or added when
-     *  the system is running, without needing it to power off.
+     *  the system is running, without needing it to power off. The host is
+     *  sent a pldmPDRRepositoryChgEvent for the added record.
      *
      *  @param[in] pdrEntry - PDR record structure in PDR repository
      *
@@ -352,6 +428,10 @@ class Handler : public CmdHandler
                                        size_t payloadLength);
 
     /** @brief Handler for GetFRURecordTable
+     *
+     *  Tables larger than FRU_TABLE_TRANSFER_SIZE are sent as a multipart
+     *  transfer, the transfer handles identify the table version so that a
+     *  transfer of a table changed meanwhile is rejected.
      *
      *  @param[in] request - Request message payload
      *  @param[in] payloadLength - Request payload length
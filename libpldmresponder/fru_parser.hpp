@@ -108,6 +108,23 @@ class FruParser
         return intfToEntityType.at(intf);
     }
 
+    /** @brief Find the entity type of an inventory item interface
+     *
+     *  @param[in] intf - name of the item interface
+     *
+     *  @return the entity type, std::nullopt if the interface has none
+     */
+    std::optional<pldm::responder::dbus::EntityType> findEntityType(
+        const pldm::responder::dbus::Interface& intf) const
+    {
+        auto it = intfToEntityType.find(intf);
+        if (it == intfToEntityType.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
   private:
     /** @brief Parse the FRU Configuration JSON file in the directory path
      *         except the FRU_Master.json and build the FRU record information
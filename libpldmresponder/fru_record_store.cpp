@@ -0,0 +1,113 @@
+#include "fru_record_store.hpp"
+
+#include <libpldm/fru.h>
+
+#include <stdexcept>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+void FruRecordStore::add(uint16_t rsi, uint8_t recordType,
+                         uint8_t encodingType, uint8_t numFields,
+                         const std::vector<uint8_t>& tlvs)
+{
+    constexpr size_t recHeaderSize =
+        sizeof(struct pldm_fru_record_data_format) -
+        sizeof(struct pldm_fru_record_tlv);
+
+    auto& recordSet = recordSets[rsi];
+    auto curSize = recordSet.data.size();
+    auto recordStart = curSize;
+    recordSet.data.resize(curSize + recHeaderSize + tlvs.size());
+    auto rc = encode_fru_record(
+        recordSet.data.data(), recordSet.data.size(), &curSize, rsi,
+        recordType, numFields, encodingType,
+        const_cast<uint8_t*>(tlvs.data()), tlvs.size());
+    if (rc != PLDM_SUCCESS)
+    {
+        recordSet.data.resize(recordStart);
+        if (recordSet.data.empty())
+        {
+            recordSets.erase(rsi);
+        }
+        throw std::runtime_error("Failed to encode FRU record");
+    }
+    recordSet.numRecords++;
+
+    // Records of the last record set can be appended to the serialized table
+    auto recordLength = recordSet.data.size() - recordStart;
+    if (!dirty && recordSets.rbegin()->first == rsi)
+    {
+        serialized.insert(serialized.end(),
+                          recordSet.data.begin() + recordStart,
+                          recordSet.data.end());
+    }
+    else
+    {
+        dirty = true;
+    }
+
+    tableSize += recordLength;
+    recordCount++;
+}
+
+uint16_t FruRecordStore::remove(uint16_t rsi)
+{
+    uint16_t removed = 0;
+    if (rsi == 0)
+    {
+        removed = recordCount;
+        recordSets.clear();
+        serialized.clear();
+        dirty = false;
+        tableSize = 0;
+        recordCount = 0;
+        return removed;
+    }
+
+    auto it = recordSets.find(rsi);
+    if (it == recordSets.end())
+    {
+        return removed;
+    }
+
+    removed = it->second.numRecords;
+    tableSize -= it->second.data.size();
+    recordCount -= removed;
+    recordSets.erase(it);
+    dirty = true;
+    return removed;
+}
+
+const std::vector<uint8_t>* FruRecordStore::find(uint16_t rsi) const
+{
+    auto it = recordSets.find(rsi);
+    if (it == recordSets.end())
+    {
+        return nullptr;
+    }
+    return &it->second.data;
+}
+
+const std::vector<uint8_t>& FruRecordStore::table()
+{
+    if (dirty)
+    {
+        serialized.clear();
+        serialized.reserve(tableSize);
+        for (const auto& [rsi, recordSet] : recordSets)
+        {
+            serialized.insert(serialized.end(), recordSet.data.begin(),
+                              recordSet.data.end());
+        }
+        dirty = false;
+    }
+    return serialized;
+}
+
+} // namespace responder
+
+} // namespace pldm
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+/** @class FruRecordStore
+ *
+ *  @brief The FRU records of the FRU record table, indexed by record set
+ *         identifier
+ *
+ *  The records of each FRU are kept apart, so adding or removing a FRU costs
+ *  the size of its records. The FRU record table is serialized from the
+ *  record sets on demand, in record set identifier order.
+ */
+class FruRecordStore
+{
+  public:
+    /** @brief Add a FRU record to a record set
+     *
+     *  @param[in] rsi - FRU record set identifier
+     *  @param[in] recordType - FRU record type
+     *  @param[in] encodingType - encoding type of the FRU fields
+     *  @param[in] numFields - number of FRU fields in tlvs
+     *  @param[in] tlvs - the FRU fields, type-length-value encoded
+     */
+    void add(uint16_t rsi, uint8_t recordType, uint8_t encodingType,
+             uint8_t numFields, const std::vector<uint8_t>& tlvs);
+
+    /** @brief Remove the records of a record set
+     *
+     *  @param[in] rsi - FRU record set identifier, 0 removes every record
+     *
+     *  @return number of removed records
+     */
+    uint16_t remove(uint16_t rsi);
+
+    /** @brief Get the records of a record set
+     *
+     *  @param[in] rsi - FRU record set identifier
+     *
+     *  @return the records, in FRU record table format, nullptr if the record
+     *          set has no record
+     */
+    const std::vector<uint8_t>* find(uint16_t rsi) const;
+
+    /** @brief Get the FRU record table, without pad bytes and checksum
+     *
+     *  @return the table, valid until the next change of the records
+     */
+    const std::vector<uint8_t>& table();
+
+    /** @brief Size of the FRU record table in bytes */
+    size_t size() const
+    {
+        return tableSize;
+    }
+
+    /** @brief Number of records in the FRU record table */
+    uint16_t numRecords() const
+    {
+        return recordCount;
+    }
+
+  private:
+    /** @struct RecordSet
+     *  @brief The records of a FRU
+     */
+    struct RecordSet
+    {
+        uint16_t numRecords = 0;
+        std::vector<uint8_t> data;
+    };
+
+    /** @brief Record sets, keyed by record set identifier */
+    std::map<uint16_t, RecordSet> recordSets;
+
+    /** @brief Serialized FRU record table */
+    std::vector<uint8_t> serialized;
+
+    /** @brief true if serialized is out of date */
+    bool dirty = false;
+
+    size_t tableSize = 0;
+    uint16_t recordCount = 0;
+};
+
+} // namespace responder
+
+} // namespace pldm
@@ -211,8 +211,9 @@ void generateNumericEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
             auto service =
                 dBusIntf.getService(objectPath.c_str(), interface.c_str());
 
-            dbusMapping = pldm::utils::DBusMapping{objectPath, interface,
-                                                   propertyName, propertyType};
+            dbusMapping = pldm::utils::DBusMapping{
+                objectPath, interface, propertyName, propertyType,
+                pldm::utils::toPropertyType(propertyType)};
         }
         catch (const std::exception& e)
         {
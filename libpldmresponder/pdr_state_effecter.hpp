@@ -150,7 +150,8 @@ void generateStateEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
                     dBusIntf.getService(objectPath.c_str(), interface.c_str());
 
                 dbusMapping = pldm::utils::DBusMapping{
-                    objectPath, interface, propertyName, propertyType};
+                    objectPath, interface, propertyName, propertyType,
+                    pldm::utils::toPropertyType(propertyType)};
                 dbusIdToValMap = pldm::responder::pdr_utils::populateMapping(
                     propertyType, dbusEntry["property_values"], stateValues);
             }
@@ -43,6 +43,7 @@ RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
         // pldm_pdr_add() assert()ed on failure to add PDR
         throw std::runtime_error("Failed to add PDR");
     }
+    recordChange(PLDM_RECORDS_ADDED, handle);
     return handle;
 }
 
@@ -91,6 +92,21 @@ bool Repo::empty()
     return !getRecordCount();
 }
 
+uint32_t Repo::getGeneration() const
+{
+    return journal.getGeneration();
+}
+
+void Repo::recordChange(uint8_t eventDataOp, RecordHandle recordHandle)
+{
+    journal.recordChange(eventDataOp, recordHandle);
+}
+
+std::optional<ChangeSet> Repo::getChangesSince(uint32_t since) const
+{
+    return journal.getChangesSince(since);
+}
+
 StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
                                 const PossibleValues& pv)
 {
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "common/pdr_journal.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 
 #include <libpldm/pdr.h>
+#include <libpldm/platform.h>
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
@@ -12,6 +14,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 
 PHOSPHOR_LOG2_USING;
@@ -81,6 +84,30 @@ using DbusValMaps = std::vector<StatestoDbusVal>;
 using DbusObjMaps = std::map<EffecterId, std::tuple<DbusMappings, DbusValMaps>>;
 using EventStates = std::array<uint8_t, 8>;
 
+/** @struct NumericEffecter
+ *  Numeric effecter resolved from its numeric effecter PDR and D-Bus mapping,
+ *  so that Get/SetNumericEffecterValue do not walk the PDR repository.
+ */
+struct NumericEffecter
+{
+    uint8_t dataSize;
+    real32_t resolution;
+    real32_t offset;
+    int8_t unitModifier;
+    union_effecter_data_size minSettable;
+    union_effecter_data_size maxSettable;
+    pldm::utils::DBusMapping dbusMapping;
+    /** @brief whether the D-Bus property is watched */
+    bool watched = false;
+    /** @brief present value of the D-Bus property, cached once read or set
+     *         while the property is watched
+     */
+    std::optional<pldm::utils::PropertyValue> value;
+};
+using NumericEffecters = std::map<EffecterId, NumericEffecter>;
+
+using ChangeSet = pldm::utils::PDRChangeSet;
+
 /** @brief Parse PDR JSON file and output Json object
  *
  *  @param[in] path - path of PDR JSON file
@@ -185,6 +212,33 @@ class RepoInterface
      */
     virtual bool empty() = 0;
 
+    /** @brief Get the generation of a PDR repository, incremented on every
+     *         change recorded in its change journal
+     *
+     *  @return uint32_t - repository generation
+     */
+    virtual uint32_t getGeneration() const = 0;
+
+    /** @brief Record a change of a PDR record in the change journal
+     *
+     *  @param[in] eventDataOp - PLDM_RECORDS_ADDED, PLDM_RECORDS_DELETED or
+     *                           PLDM_RECORDS_MODIFIED
+     *  @param[in] recordHandle - handle of the changed PDR record
+     */
+    virtual void recordChange(uint8_t eventDataOp,
+                              RecordHandle recordHandle) = 0;
+
+    /** @brief Get the PDR records changed since a generation
+     *
+     *  @param[in] generation - generation returned by getGeneration()
+     *
+     *  @return the changes with one operation per record handle, or
+     *          std::nullopt if the journal no longer covers the generation
+     *          and the entire repository has to be refreshed
+     */
+    virtual std::optional<ChangeSet> getChangesSince(
+        uint32_t generation) const = 0;
+
   protected:
     pldm_pdr* repo;
 };
@@ -215,6 +269,27 @@ class Repo : public RepoInterface
     uint32_t getRecordCount() override;
 
     bool empty() override;
+
+    uint32_t getGeneration() const override;
+
+    void recordChange(uint8_t eventDataOp, RecordHandle recordHandle) override;
+
+    std::optional<ChangeSet> getChangesSince(
+        uint32_t generation) const override;
+
+    /** @brief Get the change journal of the repository, for the code that
+     *         mutates the repository directly with libpldm
+     *
+     *  @return the change journal
+     */
+    pldm::utils::PDRJournal& getJournal()
+    {
+        return journal;
+    }
+
+  private:
+    /** @brief change journal of the repository */
+    pldm::utils::PDRJournal journal;
 };
 
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
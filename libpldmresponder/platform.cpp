@@ -19,7 +19,10 @@
 #include <libpldm/state_set.h>
 
 #include <phosphor-logging/lg2.hpp>
+#include <xyz/openbmc_project/State/BMC/client.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 
@@ -68,6 +71,145 @@ const std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps>&
     }
 }
 
+NumericEffecter* Handler::getNumericEffecter(uint16_t effecterId)
+{
+    if (numericEffectersGeneration != pdrRepo.getGeneration())
+    {
+        NumericEffecters effecters{};
+        uint8_t* pdrData = nullptr;
+        uint32_t pdrSize{};
+        const pldm_pdr_record* record{};
+        while ((record = pldm_pdr_find_record_by_type(
+                    pdrRepo.getPdr(), PLDM_NUMERIC_EFFECTER_PDR, record,
+                    &pdrData, &pdrSize)))
+        {
+            if (pdrSize < sizeof(pldm_numeric_effecter_value_pdr))
+            {
+                continue;
+            }
+
+            auto pdr =
+                std::start_lifetime_as<pldm_numeric_effecter_value_pdr>(
+                    pdrData);
+            uint16_t id = pdr->effecter_id;
+            if (effecters.contains(id))
+            {
+                continue;
+            }
+
+            NumericEffecter effecter{};
+            effecter.dataSize = pdr->effecter_data_size;
+            effecter.resolution = pdr->resolution;
+            effecter.offset = pdr->offset;
+            effecter.unitModifier = pdr->unit_modifier;
+            std::memcpy(&effecter.minSettable, &pdr->min_settable,
+                        sizeof(effecter.minSettable));
+            std::memcpy(&effecter.maxSettable, &pdr->max_settable,
+                        sizeof(effecter.maxSettable));
+
+            auto dbusObj = effecterDbusObjMaps.find(id);
+            if (dbusObj != effecterDbusObjMaps.end() &&
+                !std::get<DbusMappings>(dbusObj->second).empty())
+            {
+                effecter.dbusMapping =
+                    std::get<DbusMappings>(dbusObj->second)[0];
+                if (effecter.dbusMapping.type ==
+                    pldm::utils::PropertyType::Unknown)
+                {
+                    effecter.dbusMapping.type = pldm::utils::toPropertyType(
+                        effecter.dbusMapping.propertyType);
+                }
+            }
+
+            // keep the present values of the effecters still mapped to the
+            // same property
+            auto previous = numericEffecters.find(id);
+            if (previous != numericEffecters.end() &&
+                toPropertyKey(previous->second.dbusMapping) ==
+                    toPropertyKey(effecter.dbusMapping))
+            {
+                effecter.value = std::move(previous->second.value);
+            }
+            effecters.emplace(id, std::move(effecter));
+        }
+        numericEffecters = std::move(effecters);
+        numericEffectersGeneration = pdrRepo.getGeneration();
+        watchNumericEffecters();
+    }
+
+    auto it = numericEffecters.find(effecterId);
+    return it == numericEffecters.end() ? nullptr : &it->second;
+}
+
+Handler::PropertyKey Handler::toPropertyKey(
+    const pldm::utils::DBusMapping& dbusMapping)
+{
+    return {dbusMapping.objectPath, dbusMapping.interface,
+            dbusMapping.propertyName};
+}
+
+void Handler::watchNumericEffecters()
+{
+    std::map<PropertyKey, pldm::utils::DBusWatch> watches;
+    for (auto& [id, effecter] : numericEffecters)
+    {
+        const auto& dbusMapping = effecter.dbusMapping;
+        if (dbusMapping.objectPath.empty())
+        {
+            continue;
+        }
+
+        auto key = toPropertyKey(dbusMapping);
+        auto watch = watches.find(key);
+        if (watch == watches.end())
+        {
+            // reuse the watch of a property that is still mapped
+            auto node = numericEffecterWatches.extract(key);
+            auto handle = node.empty() ? nullptr : std::move(node.mapped());
+            if (!handle && dBusIntf)
+            {
+                try
+                {
+                    handle = dBusIntf->watchDbusProperty(
+                        dbusMapping,
+                        [this, key](
+                            const std::optional<pldm::utils::PropertyValue>&
+                                value) {
+                            // std::nullopt reads the property again on the
+                            // next request
+                            for (auto& [effecterId, effecter] :
+                                 numericEffecters)
+                            {
+                                if (effecter.watched &&
+                                    toPropertyKey(effecter.dbusMapping) == key)
+                                {
+                                    effecter.value = value;
+                                }
+                            }
+                        });
+                }
+                catch (const std::exception& e)
+                {
+                    error(
+                        "Failed to watch property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}' of numeric effecter ID '{EFFECTERID}', error - {ERROR}",
+                        "PROPERTY", dbusMapping.propertyName, "INTERFACE",
+                        dbusMapping.interface, "PATH", dbusMapping.objectPath,
+                        "EFFECTERID", id, "ERROR", e);
+                }
+            }
+            watch = watches.emplace(std::move(key), std::move(handle)).first;
+        }
+
+        // the present value can only be cached while it is kept up to date
+        effecter.watched = watch->second != nullptr;
+        if (!effecter.watched)
+        {
+            effecter.value.reset();
+        }
+    }
+    numericEffecterWatches = std::move(watches);
+}
+
 void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                        const std::vector<fs::path>& dir, Repo& repo)
 {
@@ -164,49 +306,165 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
     }
 }
 
-Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+void Handler::buildBMCPDRs()
 {
-    if (oemPlatformHandler)
+    // Build FRU table if not built, since entity association PDR's
+    // are built when the FRU table is constructed.
+    if (fruHandler)
     {
-        auto rc = oemPlatformHandler->checkBMCState();
-        if (rc != PLDM_SUCCESS)
+        fruHandler->buildFRUTable();
+    }
+
+    if (pdrCreated)
+    {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    generateTerminusLocatorPDR(pdrRepo);
+    if (platformConfigHandler)
+    {
+        auto systemType = platformConfigHandler->getPlatformName();
+        if (systemType.has_value())
         {
-            return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+            // In case of normal poweron , the system type would have been
+            // already filled by entity manager when ever BMC reaches Ready
+            // state. If this is not filled by the time the PDRs are built
+            // we can assume that the entity manager service is not present
+            // on this system & continue to build the common PDR's.
+            pdrJsonsDir.push_back(pdrJsonDir / systemType.value());
         }
     }
 
-    // Build FRU table if not built, since entity association PDR's
-    // are built when the FRU table is constructed.
-    if (fruHandler)
+    if (oemPlatformHandler != nullptr)
     {
-        fruHandler->buildFRUTable();
+        oemPlatformHandler->buildOEMPDR(pdrRepo);
+    }
+    generate(*dBusIntf, pdrJsonsDir, pdrRepo);
+    // The BMC PDRs are built in one go, the host fetches all of them
+    pdrRepo.getJournal().recordRefresh();
+
+    pdrCreated = true;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    info("Built {COUNT} BMC PDRs in {DURATION} ms", "COUNT",
+         pldm_pdr_get_record_count(pdrRepo.getPdr()), "DURATION",
+         elapsed.count());
+
+    bmcStateMatch.reset();
+    if (pdrBuildStatusCallback)
+    {
+        pdrBuildStatusCallback(false);
+    }
+}
+
+void Handler::prebuildBMCPDRs(PDRBuildStatusCallback statusCallback)
+{
+    if (pdrCreated)
+    {
+        if (statusCallback)
+        {
+            statusCallback(false);
+        }
+        return;
     }
 
-    if (!pdrCreated)
+    pdrBuildStatusCallback = std::move(statusCallback);
+    if (pdrBuildStatusCallback)
     {
-        generateTerminusLocatorPDR(pdrRepo);
-        if (platformConfigHandler)
+        pdrBuildStatusCallback(true);
+    }
+
+    using BMC = sdbusplus::client::xyz::openbmc_project::state::BMC<>;
+    auto bmcPath = sdbusplus::object_path(BMC::namespace_path::value) /
+                   BMC::namespace_path::bmc;
+    static constexpr auto bmcStateReady =
+        "xyz.openbmc_project.State.BMC.BMCState.Ready";
+
+    auto scheduleBuild = [this]() {
+        if (deferredBuildPDREvent || pdrCreated)
         {
-            auto systemType = platformConfigHandler->getPlatformName();
-            if (systemType.has_value())
+            return;
+        }
+        deferredBuildPDREvent = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](sdeventplus::source::EventBase& /*source*/) {
+                deferredBuildPDREvent.reset();
+                // The OEM may hold the PDR exchange past the BMC Ready state,
+                // wait for the next BMC state change or the first GetPDR
+                if (oemPlatformHandler &&
+                    oemPlatformHandler->checkBMCState() != PLDM_SUCCESS)
+                {
+                    return;
+                }
+                buildBMCPDRs();
+            });
+    };
+
+    using namespace sdbusplus::match_rules;
+    bmcStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+        pldm::utils::DBusHandler::getBus(),
+        propertiesChanged(bmcPath.str, BMC::interface),
+        [scheduleBuild](sdbusplus::message_t& msg) {
+            std::string interface;
+            pldm::utils::DbusChangedProps properties;
+            msg.read(interface, properties);
+            auto state = properties.find("CurrentBMCState");
+            if (state == properties.end())
             {
-                // In case of normal poweron , the system type would have been
-                // already filled by entity manager when ever BMC reaches Ready
-                // state. If this is not filled by time we get a getpdr request
-                // we can assume that the entity manager service is not present
-                // on this system & continue to build the common PDR's.
-                pdrJsonsDir.push_back(pdrJsonDir / systemType.value());
+                return;
             }
-        }
+            auto value = std::get_if<std::string>(&state->second);
+            if (value && *value == bmcStateReady)
+            {
+                scheduleBuild();
+            }
+        });
 
-        if (oemPlatformHandler != nullptr)
+    try
+    {
+        auto state = dBusIntf->getDbusPropertyVariant(
+            bmcPath.str.c_str(), "CurrentBMCState", BMC::interface);
+        if (std::get<std::string>(state) == bmcStateReady)
         {
-            oemPlatformHandler->buildOEMPDR(pdrRepo);
+            scheduleBuild();
         }
-        generate(*dBusIntf, pdrJsonsDir, pdrRepo);
+    }
+    catch (const std::exception& e)
+    {
+        // Wait for the PropertiesChanged signal of the BMC state
+        error(
+            "Failed to get the BMC state, PDRs built once it is Ready, error - {ERROR}",
+            "ERROR", e);
+    }
+}
 
-        pdrCreated = true;
+Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+{
+    if (oemPlatformHandler)
+    {
+        auto rc = oemPlatformHandler->checkBMCState();
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+        }
+    }
 
+    if (firstGetPDR)
+    {
+        // Measure how long the host firmware waits for the BMC PDRs
+        firstGetPDR = false;
+        auto prebuilt = pdrCreated;
+        auto start = std::chrono::steady_clock::now();
+        buildBMCPDRs();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        info(
+            "First GetPDR request waited {DURATION} ms for the BMC PDRs, prebuilt '{PREBUILT}'",
+            "DURATION", elapsed.count(), "PREBUILT", prebuilt);
+
+        // Forward the sensor events once the host starts fetching the PDRs,
+        // not when they are prebuilt
         if (dbusToPLDMEventHandler)
         {
             deferredGetPDREvent = std::make_unique<sdeventplus::source::Defer>(
@@ -216,6 +474,10 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
                           this, std::placeholders::_1));
         }
     }
+    else
+    {
+        buildBMCPDRs();
+    }
 
     Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
 
@@ -544,7 +806,12 @@ int Handler::pldmPDRRepositoryChgEvent(
         return rc;
     }
 
-    PDRRecordHandles pdrRecordHandles;
+    // Record handles of each change record, by event data operation, so that
+    // deleted records are dropped, and only the added and modified records
+    // are fetched from the remote terminus
+    PDRRecordHandles addedRecordHandles;
+    PDRRecordHandles deletedRecordHandles;
+    PDRRecordHandles modifiedRecordHandles;
 
     if (eventDataFormat == FORMAT_IS_PDR_TYPES)
     {
@@ -569,10 +836,12 @@ int Handler::pldmPDRRepositoryChgEvent(
                 return rc;
             }
 
-            if (hostPDRHandler && eventDataOperation == PLDM_RECORDS_MODIFIED)
-            {
-                hostPDRHandler->isHostPdrModified = true;
-            }
+            auto& pdrRecordHandles =
+                (eventDataOperation == PLDM_RECORDS_DELETED)
+                    ? deletedRecordHandles
+                    : ((eventDataOperation == PLDM_RECORDS_MODIFIED)
+                           ? modifiedRecordHandles
+                           : addedRecordHandles);
 
             rc = getPDRRecordHandles(
                 reinterpret_cast<const ChangeEntry*>(
@@ -607,8 +876,11 @@ int Handler::pldmPDRRepositoryChgEvent(
             {
                 if (std::get<0>(it->second) == tid)
                 {
-                    pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
-                                                            it->first);
+                    pldm::utils::recordPDRDelta(
+                        &pdrRepo.getJournal(), pdrRepo.getPdr(), [&] {
+                            pldm_pdr_remove_pdrs_by_terminus_handle(
+                                pdrRepo.getPdr(), it->first);
+                        });
                     hostPDRHandler->tlPDRInfo.erase(it++);
                 }
                 else
@@ -616,15 +888,22 @@ int Handler::pldmPDRRepositoryChgEvent(
                     ++it;
                 }
             }
+            hostPDRHandler->fetchPDR({});
+            return PLDM_SUCCESS;
         }
-        if (eventDataOperation == PLDM_RECORDS_DELETED)
-        {
-            hostPDRHandler->deletePDRFromRepo(std::move(pdrRecordHandles));
-        }
-        else
+
+        // HostPDRHandler journals the records as it deletes and fetches them
+        if (!deletedRecordHandles.empty())
         {
-            hostPDRHandler->fetchPDR(std::move(pdrRecordHandles));
+            hostPDRHandler->deletePDRFromRepo(std::move(deletedRecordHandles));
+            if (addedRecordHandles.empty() && modifiedRecordHandles.empty())
+            {
+                return PLDM_SUCCESS;
+            }
         }
+        // Without any record handle, the whole remote repository is fetched
+        hostPDRHandler->fetchPDR(std::move(addedRecordHandles),
+                                 std::move(modifiedRecordHandles));
     }
 
     return PLDM_SUCCESS;
@@ -1065,32 +1344,83 @@ void Handler::sendPDRRepositoryChgEventbyPDRHandles(
     const std::vector<ChangeEntry>& pdrRecordHandles,
     const std::vector<uint8_t>& eventDataOps)
 {
-    uint8_t eventDataFormat = FORMAT_IS_PDR_HANDLES;
-    std::vector<uint8_t> numsOfChangeEntries(1);
-    std::vector<std::vector<ChangeEntry>> changeEntries(
-        numsOfChangeEntries.size());
-    for (auto pdrRecordHandle : pdrRecordHandles)
+    if (pdrRecordHandles.empty() || eventDataOps.empty())
     {
-        changeEntries[0].push_back(pdrRecordHandle);
+        return;
+    }
+    sendPDRRepositoryChgEvent(FORMAT_IS_PDR_HANDLES, {eventDataOps[0]},
+                              {pdrRecordHandles});
+}
+
+void Handler::sendPDRRepositoryChgEventSince(uint32_t generation)
+{
+    auto changes = pdrRepo.getChangesSince(generation);
+    if (!changes)
+    {
+        // The change journal no longer covers the generation the host knows
+        // about, ask for a refresh of the entire repository.
+        sendPDRRepositoryChgEvent(REFRESH_ENTIRE_REPOSITORY, {}, {});
+        return;
+    }
+
+    std::vector<uint8_t> eventDataOps;
+    std::vector<std::vector<ChangeEntry>> changeEntries;
+    if (!changes->deleted.empty())
+    {
+        eventDataOps.push_back(PLDM_RECORDS_DELETED);
+        changeEntries.emplace_back(std::move(changes->deleted));
+    }
+    if (!changes->added.empty())
+    {
+        eventDataOps.push_back(PLDM_RECORDS_ADDED);
+        changeEntries.emplace_back(std::move(changes->added));
+    }
+    if (!changes->modified.empty())
+    {
+        eventDataOps.push_back(PLDM_RECORDS_MODIFIED);
+        changeEntries.emplace_back(std::move(changes->modified));
     }
     if (changeEntries.empty())
     {
         return;
     }
-    numsOfChangeEntries[0] = changeEntries[0].size();
-    size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
-                     PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
-                     changeEntries[0].size() * sizeof(uint32_t);
+
+    sendPDRRepositoryChgEvent(FORMAT_IS_PDR_HANDLES, eventDataOps,
+                              changeEntries);
+}
+
+void Handler::sendPDRRepositoryChgEvent(
+    uint8_t eventDataFormat, const std::vector<uint8_t>& eventDataOps,
+    const std::vector<std::vector<ChangeEntry>>& changeEntries)
+{
+    // libpldm rejects null arrays even when there are no change records, as
+    // for REFRESH_ENTIRE_REPOSITORY
+    std::vector<uint8_t> ops(eventDataOps);
+    std::vector<uint8_t> numsOfChangeEntries;
+    std::vector<const ChangeEntry*> entries;
+    size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH;
+    for (const auto& changeEntry : changeEntries)
+    {
+        numsOfChangeEntries.push_back(changeEntry.size());
+        entries.push_back(changeEntry.data());
+        maxSize += PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
+                   changeEntry.size() * sizeof(ChangeEntry);
+    }
+    uint8_t numberOfChangeRecords = entries.size();
+    ops.resize(std::max<size_t>(ops.size(), 1));
+    numsOfChangeEntries.resize(std::max<size_t>(numsOfChangeEntries.size(), 1));
+    entries.resize(std::max<size_t>(entries.size(), 1));
+
     std::vector<uint8_t> eventDataVec{};
     eventDataVec.resize(maxSize);
     auto eventData =
         reinterpret_cast<struct pldm_pdr_repository_chg_event_data*>(
             eventDataVec.data());
     size_t actualSize{};
-    auto firstEntry = changeEntries[0].data();
     auto rc = encode_pldm_pdr_repository_chg_event_data(
-        eventDataFormat, 1, eventDataOps.data(), numsOfChangeEntries.data(),
-        &firstEntry, eventData, &actualSize, maxSize);
+        eventDataFormat, numberOfChangeRecords, ops.data(),
+        numsOfChangeEntries.data(), entries.data(), eventData, &actualSize,
+        maxSize);
     if (rc != PLDM_SUCCESS)
     {
         error(
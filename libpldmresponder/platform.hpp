@@ -17,7 +17,13 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -47,6 +53,11 @@ using AssociatedEntityMap = std::map<DbusPath, pldm_entity>;
 
 using ChangeEntry = uint32_t;
 
+/** @brief Callback reporting whether the BMC PDRs are being built (true) or
+ *         are built (false)
+ */
+using PDRBuildStatusCallback = std::function<void(bool building)>;
+
 class Handler : public CmdHandler
 {
   public:
@@ -177,6 +188,20 @@ class Handler : public CmdHandler
             pldm::responder::pdr_utils::TypeId typeId =
                 pldm::responder::pdr_utils::TypeId::PLDM_EFFECTER_ID) const;
 
+    /** @brief Get the numeric effecter of an effecter id
+     *
+     *  The numeric effecters are resolved with a single walk of the PDR
+     *  repository, which is repeated only when the generation of the
+     *  repository changes. The present value of a resolved effecter is kept
+     *  up to date through a watch of its D-Bus property.
+     *
+     *  @param[in] effecterId - effecter id
+     *
+     *  @return the numeric effecter, nullptr if there is no numeric effecter
+     *          PDR for the id
+     */
+    pdr_utils::NumericEffecter* getNumericEffecter(uint16_t effecterId);
+
     uint16_t getNextEffecterId()
     {
         return ++nextEffecterId;
@@ -504,6 +529,23 @@ class Handler : public CmdHandler
         }
     }
 
+    /** @brief Build the FRU table and the BMC PDRs (terminus locator, OEM and
+     *         JSON based PDRs) if they are not built yet
+     */
+    void buildBMCPDRs();
+
+    /** @brief Build the FRU table and the BMC PDRs from the event loop as soon
+     *         as the BMC reaches the Ready state and the OEM platform handler
+     *         reports it ready, instead of in the first GetPDR request from
+     *         the host firmware. A GetPDR request received before then builds
+     *         them itself. Only the repository is built, the actions that
+     *         follow the first GetPDR request still wait for it.
+     *
+     *  @param[in] statusCallback - invoked with true when the build is
+     *                              pending and with false once it is done
+     */
+    void prebuildBMCPDRs(PDRBuildStatusCallback statusCallback);
+
     /** @brief process the actions that needs to be performed after a GetPDR
      *         call is received
      *  @param[in] source - sdeventplus event source
@@ -524,7 +566,47 @@ class Handler : public CmdHandler
         const std::vector<uint32_t>& pdrRecordHandles,
         const std::vector<uint8_t>& eventDataOps);
 
+    /* @brief Send a PLDM event to host firmware with the PDR records added,
+     *        deleted and modified since a generation of the PDR repository,
+     *        one change record per event data operation. If the change
+     *        journal no longer covers the generation, the host firmware is
+     *        asked to refresh the entire repository.
+     *
+     * @param[in] generation - generation returned by getRepo().getGeneration()
+     *                         before the changes
+     */
+    void sendPDRRepositoryChgEventSince(uint32_t generation);
+
   private:
+    /* @brief Encode and send a pldmPDRRepositoryChgEvent to host firmware
+     *
+     * @param[in] eventDataFormat - event data format as in DSP0248 SPEC
+     * @param[in] eventDataOps - event data operation of each change record
+     * @param[in] changeEntries - record handles of each change record
+     */
+    void sendPDRRepositoryChgEvent(
+        uint8_t eventDataFormat, const std::vector<uint8_t>& eventDataOps,
+        const std::vector<std::vector<uint32_t>>& changeEntries);
+
+    /** @brief object path, interface and name of a D-Bus property */
+    using PropertyKey = std::tuple<std::string, std::string, std::string>;
+
+    /** @brief Get the property key of a D-Bus mapping
+     *
+     *  @param[in] dbusMapping - D-Bus mapping
+     *
+     *  @return PropertyKey - object path, interface and property name
+     */
+    static PropertyKey toPropertyKey(
+        const pldm::utils::DBusMapping& dbusMapping);
+
+    /** @brief Watch the D-Bus properties of the resolved numeric effecters
+     *         through the D-Bus handler. The watches of the properties no
+     *         longer mapped are dropped, and the present value of an
+     *         effecter is only cached while its property is watched.
+     */
+    void watchNumericEffecters();
+
     uint8_t eid;
     InstanceIdDb* instanceIdDb;
     pdr_utils::Repo pdrRepo;
@@ -532,6 +614,17 @@ class Handler : public CmdHandler
     uint16_t nextSensorId{};
     DbusObjMaps effecterDbusObjMaps{};
     DbusObjMaps sensorDbusObjMaps{};
+
+    /** @brief numeric effecters resolved from the PDR repository */
+    pdr_utils::NumericEffecters numericEffecters{};
+
+    /** @brief generation of the PDR repository when the numeric effecters
+     *         were resolved
+     */
+    std::optional<uint32_t> numericEffectersGeneration;
+
+    /** @brief watches of the D-Bus properties of the numeric effecters */
+    std::map<PropertyKey, pldm::utils::DBusWatch> numericEffecterWatches{};
     HostPDRHandler* hostPDRHandler;
     pldm::state_sensor::DbusToPLDMEvent* dbusToPLDMEventHandler;
     fru::Handler* fruHandler;
@@ -544,6 +637,18 @@ class Handler : public CmdHandler
     bool pdrCreated;
     std::vector<fs::path> pdrJsonsDir;
     std::unique_ptr<sdeventplus::source::Defer> deferredGetPDREvent;
+
+    /** @brief deferred build of the BMC PDRs, once the BMC is Ready */
+    std::unique_ptr<sdeventplus::source::Defer> deferredBuildPDREvent;
+
+    /** @brief match on the BMC state, while the PDR build waits for Ready */
+    std::unique_ptr<sdbusplus::bus::match_t> bmcStateMatch;
+
+    /** @brief reports the status of the BMC PDR build */
+    PDRBuildStatusCallback pdrBuildStatusCallback;
+
+    /** @brief true until the first GetPDR request is served */
+    bool firstGetPDR = true;
 };
 
 /** @brief Function to check if a sensor falls in OEM range
@@ -24,41 +24,42 @@ namespace responder
 namespace platform_numeric_effecter
 {
 /** @brief Function to get the effecter value by PDR factor coefficient, etc.
- *  @param[in] pdr - The structure of pldm_numeric_effecter_value_pdr.
+ *  @param[in] effecter - The numeric effecter resolved from its PDR.
  *  @param[in] effecterValue - effecter value.
- *  @param[in] propertyType - type of the D-Bus property.
  *
  *  @return - std::pair<int, std::optional<PropertyValue>> - rc:Success or
  *          failure, PropertyValue: The value to be set
  */
 template <typename T>
 std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
-    const pldm_numeric_effecter_value_pdr* pdr, T& effecterValue,
-    std::string propertyType)
+    const pldm::responder::pdr_utils::NumericEffecter& effecter,
+    T& effecterValue)
 {
     // X = Round [ (Y - B) / m ]
     // refer to DSP0248_1.2.0 27.8
     int rc = 0;
+    auto propertyType = effecter.dbusMapping.type;
     pldm::utils::PropertyValue value;
-    switch (pdr->effecter_data_size)
+    switch (effecter.dataSize)
     {
         case PLDM_EFFECTER_DATA_SIZE_UINT8:
         {
             auto rawValue = static_cast<uint8_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_u8 < pdr->max_settable.value_u8 &&
-                (rawValue < pdr->min_settable.value_u8 ||
-                 rawValue > pdr->max_settable.value_u8))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_u8 <
+                    effecter.maxSettable.value_u8 &&
+                (rawValue < effecter.minSettable.value_u8 ||
+                 rawValue > effecter.maxSettable.value_u8))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
             value = rawValue;
-            if (propertyType == "uint64_t")
+            if (propertyType == pldm::utils::PropertyType::Uint64)
             {
                 auto tempValue = std::get<uint8_t>(value);
                 value = static_cast<uint64_t>(tempValue);
             }
-            else if (propertyType == "uint32_t")
+            else if (propertyType == pldm::utils::PropertyType::Uint32)
             {
                 auto tempValue = std::get<uint8_t>(value);
                 value = static_cast<uint32_t>(tempValue);
@@ -68,10 +69,11 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
         case PLDM_EFFECTER_DATA_SIZE_SINT8:
         {
             auto rawValue = static_cast<int8_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_s8 < pdr->max_settable.value_s8 &&
-                (rawValue < pdr->min_settable.value_s8 ||
-                 rawValue > pdr->max_settable.value_s8))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_s8 <
+                    effecter.maxSettable.value_s8 &&
+                (rawValue < effecter.minSettable.value_s8 ||
+                 rawValue > effecter.maxSettable.value_s8))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
@@ -81,20 +83,21 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
         case PLDM_EFFECTER_DATA_SIZE_UINT16:
         {
             auto rawValue = static_cast<uint16_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_u16 < pdr->max_settable.value_u16 &&
-                (rawValue < pdr->min_settable.value_u16 ||
-                 rawValue > pdr->max_settable.value_u16))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_u16 <
+                    effecter.maxSettable.value_u16 &&
+                (rawValue < effecter.minSettable.value_u16 ||
+                 rawValue > effecter.maxSettable.value_u16))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
             value = rawValue;
-            if (propertyType == "uint64_t")
+            if (propertyType == pldm::utils::PropertyType::Uint64)
             {
                 auto tempValue = std::get<uint16_t>(value);
                 value = static_cast<uint64_t>(tempValue);
             }
-            else if (propertyType == "uint32_t")
+            else if (propertyType == pldm::utils::PropertyType::Uint32)
             {
                 auto tempValue = std::get<uint16_t>(value);
                 value = static_cast<uint32_t>(tempValue);
@@ -104,20 +107,21 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
         case PLDM_EFFECTER_DATA_SIZE_SINT16:
         {
             auto rawValue = static_cast<int16_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_s16 < pdr->max_settable.value_s16 &&
-                (rawValue < pdr->min_settable.value_s16 ||
-                 rawValue > pdr->max_settable.value_s16))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_s16 <
+                    effecter.maxSettable.value_s16 &&
+                (rawValue < effecter.minSettable.value_s16 ||
+                 rawValue > effecter.maxSettable.value_s16))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
             value = rawValue;
-            if (propertyType == "uint64_t")
+            if (propertyType == pldm::utils::PropertyType::Uint64)
             {
                 auto tempValue = std::get<int16_t>(value);
                 value = static_cast<uint64_t>(tempValue);
             }
-            else if (propertyType == "uint32_t")
+            else if (propertyType == pldm::utils::PropertyType::Uint32)
             {
                 auto tempValue = std::get<int16_t>(value);
                 value = static_cast<uint32_t>(tempValue);
@@ -127,20 +131,21 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
         case PLDM_EFFECTER_DATA_SIZE_UINT32:
         {
             auto rawValue = static_cast<uint32_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_u32 < pdr->max_settable.value_u32 &&
-                (rawValue < pdr->min_settable.value_u32 ||
-                 rawValue > pdr->max_settable.value_u32))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_u32 <
+                    effecter.maxSettable.value_u32 &&
+                (rawValue < effecter.minSettable.value_u32 ||
+                 rawValue > effecter.maxSettable.value_u32))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
             value = rawValue;
-            if (propertyType == "uint64_t")
+            if (propertyType == pldm::utils::PropertyType::Uint64)
             {
                 auto tempValue = std::get<uint32_t>(value);
                 value = static_cast<uint64_t>(tempValue);
             }
-            else if (propertyType == "uint32_t")
+            else if (propertyType == pldm::utils::PropertyType::Uint32)
             {
                 auto tempValue = std::get<uint32_t>(value);
                 value = static_cast<uint32_t>(tempValue);
@@ -150,20 +155,21 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
         case PLDM_EFFECTER_DATA_SIZE_SINT32:
         {
             auto rawValue = static_cast<int32_t>(
-                round(effecterValue - pdr->offset) / pdr->resolution);
-            if (pdr->min_settable.value_s32 < pdr->max_settable.value_s32 &&
-                (rawValue < pdr->min_settable.value_s32 ||
-                 rawValue > pdr->max_settable.value_s32))
+                round(effecterValue - effecter.offset) / effecter.resolution);
+            if (effecter.minSettable.value_s32 <
+                    effecter.maxSettable.value_s32 &&
+                (rawValue < effecter.minSettable.value_s32 ||
+                 rawValue > effecter.maxSettable.value_s32))
             {
                 rc = PLDM_ERROR_INVALID_DATA;
             }
             value = rawValue;
-            if (propertyType == "uint64_t")
+            if (propertyType == pldm::utils::PropertyType::Uint64)
             {
                 auto tempValue = std::get<int32_t>(value);
                 value = static_cast<uint64_t>(tempValue);
             }
-            else if (propertyType == "uint32_t")
+            else if (propertyType == pldm::utils::PropertyType::Uint32)
             {
                 auto tempValue = std::get<int32_t>(value);
                 value = static_cast<uint32_t>(tempValue);
@@ -176,49 +182,49 @@ std::pair<int, std::optional<pldm::utils::PropertyValue>> getEffecterRawValue(
 }
 
 /** @brief Function to convert the D-Bus value by PDR factor and effecter value.
- *  @param[in] pdr - The structure of pldm_numeric_effecter_value_pdr.
+ *  @param[in] effecter - The numeric effecter resolved from its PDR.
  *  @param[in] effecterDataSize - effecter value size.
  *  @param[in,out] effecterValue - effecter value.
- *  @param[in] propertyType - type of the D-Bus property.
  *
  *  @return std::pair<int, std::optional<PropertyValue>> - rc:Success or
  *          failure, PropertyValue: The value to be set
  */
-std::pair<int, std::optional<pldm::utils::PropertyValue>> convertToDbusValue(
-    const pldm_numeric_effecter_value_pdr* pdr, uint8_t effecterDataSize,
-    uint8_t* effecterValue, std::string propertyType)
+inline std::pair<int, std::optional<pldm::utils::PropertyValue>>
+    convertToDbusValue(
+        const pldm::responder::pdr_utils::NumericEffecter& effecter,
+        uint8_t effecterDataSize, uint8_t* effecterValue)
 {
     if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_UINT8)
     {
         uint8_t currentValue = *(reinterpret_cast<uint8_t*>(&effecterValue[0]));
-        return getEffecterRawValue<uint8_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<uint8_t>(effecter, currentValue);
     }
     else if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_SINT8)
     {
         int8_t currentValue = *(reinterpret_cast<int8_t*>(&effecterValue[0]));
-        return getEffecterRawValue<int8_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<int8_t>(effecter, currentValue);
     }
     else if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_UINT16)
     {
         uint16_t currentValue =
             *(reinterpret_cast<uint16_t*>(&effecterValue[0]));
-        return getEffecterRawValue<uint16_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<uint16_t>(effecter, currentValue);
     }
     else if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_SINT16)
     {
         int16_t currentValue = *(reinterpret_cast<int16_t*>(&effecterValue[0]));
-        return getEffecterRawValue<int16_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<int16_t>(effecter, currentValue);
     }
     else if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_UINT32)
     {
         uint32_t currentValue =
             *(reinterpret_cast<uint32_t*>(&effecterValue[0]));
-        return getEffecterRawValue<uint32_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<uint32_t>(effecter, currentValue);
     }
     else if (effecterDataSize == PLDM_EFFECTER_DATA_SIZE_SINT32)
     {
         int32_t currentValue = *(reinterpret_cast<int32_t*>(&effecterValue[0]));
-        return getEffecterRawValue<int32_t>(pdr, currentValue, propertyType);
+        return getEffecterRawValue<int32_t>(effecter, currentValue);
     }
     else
     {
@@ -250,44 +256,9 @@ int setNumericEffecterValueHandler(
     size_t effecterValueLength)
 {
     constexpr auto effecterValueArrayLength = 4;
-    pldm_numeric_effecter_value_pdr* pdr = nullptr;
 
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)>
-        numericEffecterPdrRepo(pldm_pdr_init(), pldm_pdr_destroy);
-    if (!numericEffecterPdrRepo)
-    {
-        error("Failed to instantiate numeric effecter PDR repository");
-        return PLDM_ERROR;
-    }
-    pldm::responder::pdr_utils::Repo numericEffecterPDRs(
-        numericEffecterPdrRepo.get());
-    pldm::responder::pdr::getRepoByType(handler.getRepo(), numericEffecterPDRs,
-                                        PLDM_NUMERIC_EFFECTER_PDR);
-    if (numericEffecterPDRs.empty())
-    {
-        error("The Numeric Effecter PDR repo is empty.");
-        return PLDM_ERROR;
-    }
-
-    // Get the pdr structure of pldm_numeric_effecter_value_pdr according
-    // to the effecterId
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    auto pdrRecord = numericEffecterPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
-    {
-        pdr = std::start_lifetime_as<pldm_numeric_effecter_value_pdr>(
-            pdrEntry.data);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = numericEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
-
-        break;
-    }
-
-    if (!pdr)
+    auto effecter = handler.getNumericEffecter(effecterId);
+    if (!effecter)
     {
         return PLDM_PLATFORM_INVALID_EFFECTER_ID;
     }
@@ -299,41 +270,37 @@ int setNumericEffecterValueHandler(
         return PLDM_ERROR_INVALID_DATA;
     }
 
-    try
+    const auto& dbusMapping = effecter->dbusMapping;
+    if (dbusMapping.objectPath.empty())
     {
-        const auto& [dbusMappings, dbusValMaps] =
-            handler.getDbusObjMaps(effecterId);
-        pldm::utils::DBusMapping dbusMapping{
-            dbusMappings[0].objectPath, dbusMappings[0].interface,
-            dbusMappings[0].propertyName, dbusMappings[0].propertyType};
+        error("Unknown effecter ID '{EFFECTERID}', no D-Bus mapping",
+              "EFFECTERID", effecterId);
+        return PLDM_ERROR;
+    }
 
-        // convert to dbus effectervalue according to the factor
-        auto [rc, dbusValue] = convertToDbusValue(
-            pdr, effecterDataSize, effecterValue, dbusMappings[0].propertyType);
-        if (rc != PLDM_SUCCESS)
-        {
-            return rc;
-        }
-        try
-        {
-            dBusIntf.setDbusProperty(dbusMapping, dbusValue.value());
-        }
-        catch (const std::exception& e)
-        {
-            error(
-                "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - {ERROR}",
-                "PROPERTY", dbusMapping.propertyName, "INTERFACE",
-                dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR",
-                e);
-            return PLDM_ERROR;
-        }
+    // convert to dbus effectervalue according to the factor
+    auto [rc, dbusValue] =
+        convertToDbusValue(*effecter, effecterDataSize, effecterValue);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+    try
+    {
+        dBusIntf.setDbusProperty(dbusMapping, dbusValue.value());
     }
-    catch (const std::out_of_range& e)
+    catch (const std::exception& e)
     {
-        error("Unknown effecter ID '{EFFECTERID}', error - {ERROR}",
-              "EFFECTERID", effecterId, "ERROR", e);
+        error(
+            "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - {ERROR}",
+            "PROPERTY", dbusMapping.propertyName, "INTERFACE",
+            dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR", e);
         return PLDM_ERROR;
     }
+    if (effecter->watched)
+    {
+        effecter->value = std::move(dbusValue);
+    }
 
     return PLDM_SUCCESS;
 }
@@ -492,62 +459,36 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
                            std::string& propertyType,
                            pldm::utils::PropertyValue& propertyValue)
 {
-    pldm_numeric_effecter_value_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)>
-        numericEffecterPdrRepo(pldm_pdr_init(), pldm_pdr_destroy);
-    pldm::responder::pdr_utils::Repo numericEffecterPDRs(
-        numericEffecterPdrRepo.get());
-    pldm::responder::pdr::getRepoByType(handler.getRepo(), numericEffecterPDRs,
-                                        PLDM_NUMERIC_EFFECTER_PDR);
-    if (numericEffecterPDRs.empty())
+    auto effecter = handler.getNumericEffecter(effecterId);
+    if (!effecter)
     {
-        error("The Numeric Effecter PDR repo is empty.");
-        return PLDM_ERROR;
+        error("Failed to find numeric effecter ID {EFFECTERID}", "EFFECTERID",
+              effecterId);
+        return PLDM_PLATFORM_INVALID_EFFECTER_ID;
     }
+    effecterDataSize = effecter->dataSize;
 
-    // Get the pdr structure of pldm_numeric_effecter_value_pdr according
-    // to the effecterId
-    pldm::responder::pdr_utils::PdrEntry pdrEntry{};
-    auto pdrRecord = numericEffecterPDRs.getFirstRecord(pdrEntry);
-
-    while (pdrRecord)
+    const auto& dbusMapping = effecter->dbusMapping;
+    if (dbusMapping.objectPath.empty())
     {
-        pdr = std::start_lifetime_as<pldm_numeric_effecter_value_pdr>(
-            pdrEntry.data);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = numericEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
-        effecterDataSize = pdr->effecter_data_size;
-        break;
+        return PLDM_SUCCESS;
     }
 
-    if (!pdr)
+    propertyType = dbusMapping.propertyType;
+    if (effecter->value)
     {
-        error("Failed to find numeric effecter ID {EFFECTERID}", "EFFECTERID",
-              effecterId);
-        return PLDM_PLATFORM_INVALID_EFFECTER_ID;
+        propertyValue = *effecter->value;
+        return PLDM_SUCCESS;
     }
 
-    pldm::utils::DBusMapping dbusMapping{};
     try
     {
-        const auto& [dbusMappings, dbusValMaps] =
-            handler.getDbusObjMaps(effecterId);
-        if (dbusMappings.size() > 0)
+        propertyValue = dBusIntf.getDbusPropertyVariant(
+            dbusMapping.objectPath.c_str(), dbusMapping.propertyName.c_str(),
+            dbusMapping.interface.c_str());
+        if (effecter->watched)
         {
-            dbusMapping = {
-                dbusMappings[0].objectPath, dbusMappings[0].interface,
-                dbusMappings[0].propertyName, dbusMappings[0].propertyType};
-
-            propertyValue = dBusIntf.getDbusPropertyVariant(
-                dbusMapping.objectPath.c_str(),
-                dbusMapping.propertyName.c_str(),
-                dbusMapping.interface.c_str());
-            propertyType = dbusMappings[0].propertyType;
+            effecter->value = propertyValue;
         }
     }
     catch (const std::exception& e)
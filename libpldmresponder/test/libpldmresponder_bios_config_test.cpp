@@ -42,6 +42,13 @@ class TestBIOSConfig : public ::testing::Test
         }
     }
 
+    void SetUp() override
+    {
+        // Start every test from the BIOS JSONs, not from the tables cached by
+        // the previous tests
+        fs::remove_all(tableDir / "cache");
+    }
+
     std::optional<Json> findJsonEntry(const std::string& name)
     {
         for (auto& json : jsons)
@@ -250,6 +257,47 @@ TEST_F(TestBIOSConfig, buildTablesTest)
     }
 }
 
+TEST_F(TestBIOSConfig, buildTablesFromCachedTables)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+    std::string biosFilePath("./bios_jsons");
+    auto cacheDir = tableDir / "cache";
+
+    std::optional<Table> builtStringTable;
+    std::optional<Table> builtAttrTable;
+    std::optional<Table> builtAttrValueTable;
+    {
+        BIOSConfig biosConfig(biosFilePath.c_str(), tableDir.c_str(),
+                              &dbusHandler, 0, 0, nullptr, nullptr,
+                              &mockSystemConfig, []() {});
+        builtStringTable = biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE);
+        builtAttrTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+        builtAttrValueTable =
+            biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    }
+    ASSERT_TRUE(builtStringTable);
+    ASSERT_TRUE(builtAttrTable);
+    ASSERT_TRUE(builtAttrValueTable);
+    ASSERT_EQ(std::distance(fs::directory_iterator(cacheDir),
+                            fs::directory_iterator()),
+              3);
+
+    // The BaseBIOSTable is not read back when the tables are cached
+    EXPECT_CALL(dbusHandler, getService(_, _)).Times(0);
+    BIOSConfig biosConfig(biosFilePath.c_str(), tableDir.c_str(), &dbusHandler,
+                          0, 0, nullptr, nullptr, &mockSystemConfig, []() {});
+    auto stringTable = biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    ASSERT_TRUE(stringTable);
+    EXPECT_EQ(*stringTable, *builtStringTable);
+    auto attrTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    ASSERT_TRUE(attrTable);
+    EXPECT_EQ(*attrTable, *builtAttrTable);
+    auto attrValueTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(attrValueTable);
+    EXPECT_EQ(*attrValueTable, *builtAttrValueTable);
+}
+
 TEST_F(TestBIOSConfig, setBIOSTable)
 {
     MockdBusHandler dbusHandler;
@@ -275,6 +323,38 @@ TEST_F(TestBIOSConfig, setBIOSTable)
     EXPECT_TRUE(stringTable);
 }
 
+TEST_F(TestBIOSConfig, setBIOSTablePersistsInBackground)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    Table table;
+    table::string::constructEntry(table, "pvm_system_name");
+    table::appendPadAndChecksum(table);
+
+    auto tablePath = tableDir / "stringTable";
+    {
+        BIOSConfig biosConfig("./", tableDir.c_str(), &dbusHandler, 0, 0,
+                              nullptr, nullptr, &mockSystemConfig, []() {});
+        auto rc = biosConfig.setBIOSTable(PLDM_BIOS_STRING_TABLE, table);
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+
+        // Served from memory, the write is pending until the event loop runs
+        EXPECT_FALSE(fs::exists(tablePath));
+        auto stringTable = biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE);
+        ASSERT_TRUE(stringTable);
+        EXPECT_EQ(*stringTable, table);
+    }
+
+    // Pending writes are flushed when the config goes away
+    Table persisted;
+    BIOSTable biosTable(tablePath.c_str());
+    ASSERT_FALSE(biosTable.isEmpty());
+    biosTable.load(persisted);
+    EXPECT_EQ(persisted, table);
+    EXPECT_FALSE(fs::exists(tableDir / "stringTable.tmp"));
+}
+
 TEST_F(TestBIOSConfig, getBIOSTableFailure)
 {
     MockdBusHandler dbusHandler;
@@ -385,4 +465,151 @@ TEST_F(TestBIOSConfig, setAttrValue)
     auto p = reinterpret_cast<const uint8_t*>(entry);
     EXPECT_THAT(std::vector<uint8_t>(p, p + attrValueEntry.size()),
                 ElementsAreArray(attrValueEntry));
+
+    auto indexedEntry = biosConfig.findAttrValueEntry(attrHandle);
+    ASSERT_NE(indexedEntry, nullptr);
+    auto q = reinterpret_cast<const uint8_t*>(indexedEntry);
+    EXPECT_THAT(std::vector<uint8_t>(q, q + attrValueEntry.size()),
+                ElementsAreArray(attrValueEntry));
+    EXPECT_EQ(biosConfig.findAttrValueEntry(0xffff), nullptr);
+}
+
+TEST_F(TestBIOSConfig, setAttrValues)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr, &mockSystemConfig, []() {});
+
+    auto stringTable = biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    auto attrTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    BIOSStringTable biosStringTable(*stringTable);
+
+    auto findAttrHandle = [&](const std::string& name) {
+        auto stringHandle = biosStringTable.findHandle(name);
+        for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+                 attrTable->data(), attrTable->size()))
+        {
+            auto header = table::attribute::decodeHeader(entry);
+            if (header.stringHandle == stringHandle)
+            {
+                return header.attrHandle;
+            }
+        }
+        return uint16_t{};
+    };
+
+    auto strHandle = findAttrHandle("str_example1");
+    auto railHandle = findAttrHandle("VDD_AVSBUS_RAIL");
+
+    Table strEntry{
+        0,   0,             /* attr handle */
+        1,                  /* attr type string read-write */
+        4,   0,             /* current string length */
+        'a', 'b', 'c', 'd', /* current string */
+    };
+    strEntry[0] = strHandle & 0xff;
+    strEntry[1] = (strHandle >> 8) & 0xff;
+
+    Table railEntry{
+        0, 0,                  /* attr handle */
+        3,                     /* attr type integer read-write */
+        5, 0, 0, 0, 0, 0, 0, 0 /* current value */
+    };
+    railEntry[0] = railHandle & 0xff;
+    railEntry[1] = (railHandle >> 8) & 0xff;
+
+    auto badRailEntry = railEntry;
+    badRailEntry[3] = 16; /* above the upper bound */
+
+    // One invalid entry rejects the whole batch
+    auto before = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    EXPECT_CALL(dbusHandler, setDbusProperty(_, _)).Times(0);
+    auto rc = biosConfig.setAttrValues({strEntry, badRailEntry}, false);
+    EXPECT_EQ(rc, PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE), before);
+    ::testing::Mock::VerifyAndClearExpectations(&dbusHandler);
+
+    DBusMapping strMapping{"/xyz/abc/def",
+                           "xyz.openbmc_project.str_example1.value",
+                           "Str_example1", "string"};
+    DBusMapping railMapping{"/xyz/openbmc_project/avsbus",
+                            "xyz.openbmc.AvsBus.Manager", "Rail", "uint8_t"};
+    EXPECT_CALL(dbusHandler,
+                setDbusProperty(strMapping, PropertyValue(std::string("abcd"))))
+        .Times(1);
+    EXPECT_CALL(dbusHandler,
+                setDbusProperty(railMapping, PropertyValue(uint8_t(5))))
+        .Times(1);
+
+    rc = biosConfig.setAttrValues({strEntry, railEntry}, false);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    ::testing::Mock::VerifyAndClearExpectations(&dbusHandler);
+
+    // A failed D-Bus set rolls back the properties already set and the table
+    auto applied = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    Table strEntry2 = strEntry;
+    strEntry2[5] = 'x';
+    auto railEntry2 = railEntry;
+    railEntry2[3] = 6;
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(dbusHandler, setDbusProperty(
+                                     strMapping,
+                                     PropertyValue(std::string("xbcd"))))
+            .Times(1);
+        EXPECT_CALL(dbusHandler,
+                    setDbusProperty(railMapping, PropertyValue(uint8_t(6))))
+            .WillOnce(Throw(std::runtime_error("set failed")));
+        EXPECT_CALL(dbusHandler, setDbusProperty(
+                                     strMapping,
+                                     PropertyValue(std::string("abcd"))))
+            .Times(1);
+    }
+    rc = biosConfig.setAttrValues({strEntry2, railEntry2}, false);
+    EXPECT_EQ(rc, PLDM_ERROR);
+    EXPECT_EQ(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE), applied);
+
+    for (const auto& [handle, entry] :
+         {std::pair{strHandle, strEntry}, std::pair{railHandle, railEntry}})
+    {
+        auto valueEntry = biosConfig.findAttrValueEntry(handle);
+        ASSERT_NE(valueEntry, nullptr);
+        auto p = reinterpret_cast<const uint8_t*>(valueEntry);
+        EXPECT_THAT(std::vector<uint8_t>(p, p + entry.size()),
+                    ElementsAreArray(entry));
+    }
+}
+
+TEST_F(TestBIOSConfig, constructPendingAttributeRejectsBatch)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr, &mockSystemConfig, []() {});
+
+    const std::string strType =
+        "xyz.openbmc_project.BIOSConfig.Manager.AttributeType.String";
+    const std::string intType =
+        "xyz.openbmc_project.BIOSConfig.Manager.AttributeType.Integer";
+
+    auto before = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(before.has_value());
+    EXPECT_CALL(dbusHandler, setDbusProperty(_, _)).Times(0);
+
+    // A value out of the attribute bounds rejects the valid attribute too
+    PendingAttributes outOfRange{
+        {"str_example1", {strType, std::string("abcd")}},
+        {"VDD_AVSBUS_RAIL", {intType, int64_t(16)}}};
+    biosConfig.constructPendingAttribute(outOfRange);
+    EXPECT_EQ(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE), before);
+
+    // So does an unknown attribute
+    PendingAttributes unknown{
+        {"str_example1", {strType, std::string("abcd")}},
+        {"no_such_attribute", {strType, std::string("abcd")}}};
+    biosConfig.constructPendingAttribute(unknown);
+    EXPECT_EQ(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE), before);
 }
@@ -57,3 +57,21 @@ TEST_F(TestBIOSTable, testLoadOntoExisting)
     ASSERT_EQ(out[0], 99);
     ASSERT_EQ(out[1], 99);
 }
+
+TEST(BIOSStringTable, testFindStringAndHandle)
+{
+    Table table;
+    table::string::constructEntry(table, "Allowed");
+    table::string::constructEntry(table, "Disabled");
+    table::appendPadAndChecksum(table);
+
+    BIOSStringTable stringTable(table);
+    auto allowed = stringTable.findHandle("Allowed");
+    auto disabled = stringTable.findHandle("Disabled");
+    EXPECT_NE(allowed, disabled);
+    EXPECT_EQ(stringTable.findString(allowed), "Allowed");
+    EXPECT_EQ(stringTable.findString(disabled), "Disabled");
+
+    EXPECT_THROW(stringTable.findHandle("Enabled"), std::invalid_argument);
+    EXPECT_THROW(stringTable.findString(0xffff), std::invalid_argument);
+}
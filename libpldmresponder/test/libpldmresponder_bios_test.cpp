@@ -1,9 +1,15 @@
+#include "common/multipart_transfer.hpp"
+#include "common/test/mocked_utils.hpp"
 #include "libpldmresponder/bios.hpp"
+#include "libpldmresponder/bios_table.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/bios.h>
+#include <libpldm/bios_table.h>
 
 #include <ctime>
+#include <filesystem>
+#include <memory>
 
 #include <gtest/gtest.h>
 
@@ -57,3 +63,256 @@ TEST(timeToEpoch, testTime0)
 
     EXPECT_EQ(ret, timeSec);
 }
+
+#ifndef SYSTEM_SPECIFIC_BIOS_JSON
+
+class TestBIOSTableTransfer : public ::testing::Test
+{
+  protected:
+    TestBIOSTableTransfer()
+    {
+        char tmpdir[] = "/tmp/BIOSTableTransfer.XXXXXX";
+        tableDir = fs::path(mkdtemp(tmpdir));
+    }
+
+    ~TestBIOSTableTransfer() override
+    {
+        fs::remove_all(tableDir);
+    }
+
+    std::unique_ptr<Handler> makeHandler(size_t transferSize)
+    {
+        return std::make_unique<Handler>(
+            0, 0, nullptr, nullptr, nullptr, []() {}, "./bios_jsons",
+            tableDir.c_str(), &dbusHandler, transferSize);
+    }
+
+    /** @struct Part
+     *  @brief A decoded GetBIOSTable response
+     */
+    struct Part
+    {
+        uint8_t cc;
+        uint32_t nextTransferHandle;
+        uint8_t transferFlag;
+        Table data;
+    };
+
+    static Part getPart(Handler& handler, uint8_t tableType,
+                        uint8_t transferOpFlag, uint32_t transferHandle)
+    {
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES);
+        auto request = new (requestMsg.data()) pldm_msg;
+        EXPECT_EQ(encode_get_bios_table_req(0, transferHandle, transferOpFlag,
+                                            tableType, request),
+                  PLDM_SUCCESS);
+
+        auto response =
+            handler.getBIOSTable(request, PLDM_GET_BIOS_TABLE_REQ_BYTES);
+        auto responsePtr = new (response.data()) pldm_msg;
+        auto payloadLength = response.size() - sizeof(pldm_msg_hdr);
+
+        Part part{responsePtr->payload[0], 0, 0, {}};
+        if (part.cc != PLDM_SUCCESS)
+        {
+            return part;
+        }
+
+        size_t offset = 0;
+        EXPECT_EQ(decode_get_bios_table_resp(
+                      responsePtr, payloadLength, &part.cc,
+                      &part.nextTransferHandle, &part.transferFlag, &offset),
+                  PLDM_SUCCESS);
+        part.data.assign(responsePtr->payload + offset,
+                         responsePtr->payload + payloadLength);
+        return part;
+    }
+
+    static Table getTable(Handler& handler, uint8_t tableType,
+                          std::vector<uint8_t>* transferFlags = nullptr)
+    {
+        Table table;
+        auto part = getPart(handler, tableType, PLDM_GET_FIRSTPART, 0);
+        for (size_t i = 0; part.cc == PLDM_SUCCESS && i < multipart::maxParts;
+             ++i)
+        {
+            table.insert(table.end(), part.data.begin(), part.data.end());
+            if (transferFlags)
+            {
+                transferFlags->push_back(part.transferFlag);
+            }
+            if (!part.nextTransferHandle)
+            {
+                return table;
+            }
+            part = getPart(handler, tableType, PLDM_GET_NEXTPART,
+                           part.nextTransferHandle);
+        }
+        ADD_FAILURE() << "GetBIOSTable failed, completion code "
+                      << static_cast<int>(part.cc);
+        return {};
+    }
+
+    static std::pair<uint8_t, uint32_t> setPart(
+        Handler& handler, uint8_t tableType, uint8_t transferFlag,
+        uint32_t transferHandle, const uint8_t* data, size_t length)
+    {
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_MIN_REQ_BYTES + length);
+        auto request = new (requestMsg.data()) pldm_msg;
+        auto payloadLength = requestMsg.size() - sizeof(pldm_msg_hdr);
+        EXPECT_EQ(encode_set_bios_table_req(0, transferHandle, transferFlag,
+                                            tableType, data, length, request,
+                                            payloadLength),
+                  PLDM_SUCCESS);
+
+        auto response = handler.setBIOSTable(request, payloadLength);
+        auto responsePtr = new (response.data()) pldm_msg;
+        uint8_t cc = responsePtr->payload[0];
+        uint32_t nextTransferHandle = 0;
+        if (cc == PLDM_SUCCESS)
+        {
+            EXPECT_EQ(decode_set_bios_table_resp(
+                          responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                          &cc, &nextTransferHandle),
+                      PLDM_SUCCESS);
+        }
+        return {cc, nextTransferHandle};
+    }
+
+    fs::path tableDir;
+    MockdBusHandler dbusHandler;
+};
+
+TEST_F(TestBIOSTableTransfer, getBIOSTableInParts)
+{
+    constexpr size_t partSize = 16;
+    auto handler = makeHandler(partSize);
+
+    std::vector<uint8_t> transferFlags;
+    auto table = getTable(*handler, PLDM_BIOS_STRING_TABLE, &transferFlags);
+
+    ASSERT_GE(transferFlags.size(), 3u);
+    EXPECT_EQ(transferFlags.size(), (table.size() + partSize - 1) / partSize);
+    EXPECT_EQ(transferFlags.front(), PLDM_START);
+    EXPECT_EQ(transferFlags.back(), PLDM_END);
+    for (size_t i = 1; i + 1 < transferFlags.size(); ++i)
+    {
+        EXPECT_EQ(transferFlags[i], PLDM_MIDDLE);
+    }
+
+    // The parts reassemble to the table, checksum included
+    EXPECT_TRUE(pldm_bios_table_checksum(table.data(), table.size()));
+    BIOSStringTable stringTable(table);
+    EXPECT_NO_THROW(stringTable.findHandle("str_example1"));
+}
+
+TEST_F(TestBIOSTableTransfer, getBIOSTableStaleTransferHandle)
+{
+    auto handler = makeHandler(16);
+    auto table = getTable(*handler, PLDM_BIOS_STRING_TABLE);
+    ASSERT_FALSE(table.empty());
+
+    auto first = getPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_GET_FIRSTPART,
+                         0);
+    ASSERT_EQ(first.cc, PLDM_SUCCESS);
+    ASSERT_NE(first.nextTransferHandle, 0u);
+
+    // Setting the table changes its version, even with the same content
+    auto [cc, next] = setPart(*handler, PLDM_BIOS_STRING_TABLE,
+                              PLDM_START_AND_END, 0, table.data(),
+                              table.size());
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 0u);
+
+    auto stale = getPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_GET_NEXTPART,
+                         first.nextTransferHandle);
+    EXPECT_EQ(stale.cc, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+
+    // A new transfer gets the new version
+    auto restart = getPart(*handler, PLDM_BIOS_STRING_TABLE,
+                           PLDM_GET_FIRSTPART, 0);
+    ASSERT_EQ(restart.cc, PLDM_SUCCESS);
+    EXPECT_NE(restart.nextTransferHandle, first.nextTransferHandle);
+    EXPECT_EQ(restart.data, first.data);
+}
+
+TEST_F(TestBIOSTableTransfer, setBIOSTableInParts)
+{
+    auto handler = makeHandler(0);
+    auto table = getTable(*handler, PLDM_BIOS_STRING_TABLE);
+    ASSERT_GE(table.size(), 3u);
+
+    auto third = table.size() / 3;
+    const uint8_t* data = table.data();
+
+    // A transfer that was never started is rejected
+    auto [cc, next] = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_MIDDLE,
+                              1, data, third);
+    EXPECT_EQ(cc, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_START,
+                                 0, data, third);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    ASSERT_NE(next, 0u);
+
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_MIDDLE,
+                                 next, data + third, third);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    ASSERT_NE(next, 0u);
+
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_END,
+                                 next, data + 2 * third,
+                                 table.size() - 2 * third);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 0u);
+
+    EXPECT_EQ(getTable(*handler, PLDM_BIOS_STRING_TABLE), table);
+
+    // Parts reassembled out of order fail the integrity check
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_START,
+                                 0, data + third, third);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_END,
+                                 next, data, table.size() - third);
+    EXPECT_EQ(cc, PLDM_INVALID_BIOS_TABLE_DATA_INTEGRITY_CHECK);
+
+    // The transfer is done, its handle is no longer accepted
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_END,
+                                 next, data, table.size());
+    EXPECT_EQ(cc, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+}
+
+TEST_F(TestBIOSTableTransfer, setBIOSTableSizeCap)
+{
+    constexpr size_t maxSetTableSize = 1024 * 1024;
+    constexpr size_t chunkSize = 64 * 1024;
+    auto handler = makeHandler(0);
+    Table chunk(chunkSize);
+
+    auto [cc, next] = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_START, 0,
+                              chunk.data(), chunk.size());
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+
+    // Up to maxSetTableSize bytes are accepted
+    for (size_t size = chunkSize; size < maxSetTableSize; size += chunkSize)
+    {
+        std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE,
+                                     PLDM_MIDDLE, next, chunk.data(),
+                                     chunk.size());
+        ASSERT_EQ(cc, PLDM_SUCCESS);
+    }
+
+    // One more byte drops the transfer
+    auto last = next;
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_MIDDLE,
+                                 last, chunk.data(), 1);
+    EXPECT_EQ(cc, PLDM_ERROR_INVALID_LENGTH);
+
+    std::tie(cc, next) = setPart(*handler, PLDM_BIOS_STRING_TABLE, PLDM_END,
+                                 last, chunk.data(), 1);
+    EXPECT_EQ(cc, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+}
+
+#endif
@@ -1,11 +1,17 @@
 #include "libpldmresponder/fru.hpp"
 #include "libpldmresponder/fru_parser.hpp"
+#include "libpldmresponder/fru_record_store.hpp"
 
 #include <config.h>
 #include <libpldm/pdr.h>
 
 #include <sdbusplus/message.hpp>
 
+#include <format>
+#include <optional>
+#include <set>
+#include <string>
+
 #include <gtest/gtest.h>
 
 TEST(FruParser, allScenarios)
@@ -151,6 +157,88 @@ TEST(FruImpl, updateAssociationTreeTest)
     EXPECT_TRUE(node == nullptr);
 }
 
+TEST(FruImpl, buildFRUTableFromInventorySnapshot)
+{
+    using namespace pldm::responder::dbus;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy);
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy);
+
+    constexpr size_t numCpus = 64;
+    const std::string motherboard =
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard";
+    ObjectValueTree objects{
+        {sdbusplus::object_path("/xyz/openbmc_project/inventory/system"),
+         {{"xyz.openbmc_project.Inventory.Item.System", {}}}},
+        {sdbusplus::object_path(
+             "/xyz/openbmc_project/inventory/system/chassis"),
+         {{"xyz.openbmc_project.Inventory.Item.Chassis", {}}}},
+        {sdbusplus::object_path(motherboard),
+         {{"xyz.openbmc_project.Inventory.Item.Board.Motherboard", {}}}}};
+
+    // Every third CPU is absent, every fifth has no Present property
+    std::set<std::string> presentCpus;
+    for (size_t i = 0; i < numCpus; ++i)
+    {
+        auto path = std::format("{}/cpu{:02}", motherboard, i);
+        PropertyMap item{{"PrettyName", std::string("cpu")}};
+        if (i % 5)
+        {
+            item.emplace("Present", i % 3 != 0);
+        }
+        if (i % 5 && i % 3)
+        {
+            presentCpus.insert(path);
+        }
+        objects.emplace(
+            sdbusplus::object_path(path),
+            InterfaceMap{{"xyz.openbmc_project.Inventory.Item", item},
+                         {"xyz.openbmc_project.Inventory.Item.Cpu", {}},
+                         {"xyz.openbmc_project.Inventory.Decorator.Asset",
+                          {{"PartNumber", std::string("PN")},
+                           {"SerialNumber", std::format("SN{}", i)}}}});
+    }
+    ASSERT_FALSE(presentCpus.empty());
+
+    pldm::responder::FruImpl fruImpl("./fru_jsons/good",
+                                     "./fru_jsons/fru_master/fru_master.json",
+                                     pdrRepo.get(), entityTree.get(),
+                                     bmcEntityTree.get());
+    fruImpl.buildFRUTable(objects, "");
+
+    // Only the present CPUs of the snapshot get an entity and a record
+    const auto& entities = fruImpl.getAssociateEntityMap();
+    std::set<std::string> cpus;
+    std::set<uint16_t> instances;
+    std::optional<uint16_t> containerId;
+    for (const auto& [path, entity] : entities)
+    {
+        EXPECT_EQ(entity.entity_type, 135);
+        cpus.insert(path);
+        instances.insert(entity.entity_instance_num);
+        if (!containerId)
+        {
+            containerId = entity.entity_container_id;
+        }
+        EXPECT_EQ(entity.entity_container_id, *containerId);
+    }
+    EXPECT_EQ(cpus, presentCpus);
+    EXPECT_EQ(static_cast<size_t>(fruImpl.numRecords()), presentCpus.size());
+
+    // The CPUs, all of the same type under the motherboard, are numbered
+    // after each other
+    ASSERT_EQ(instances.size(), presentCpus.size());
+    EXPECT_EQ(*instances.begin(), 1);
+    EXPECT_EQ(static_cast<size_t>(*instances.rbegin()), presentCpus.size());
+}
+
 TEST(FruImpl, entityByObjectPath)
 {
     using namespace pldm::responder::dbus;
@@ -180,3 +268,54 @@ TEST(FruImpl, entityByObjectPath)
     entityPtr = mockedFruHandler.getEntityByObjectPath(invalidIface);
     ASSERT_TRUE(!entityPtr);
 }
+
+TEST(FruRecordStore, addAndRemoveRecordSets)
+{
+    pldm::responder::FruRecordStore records;
+    std::vector<uint8_t> modelTlvs{PLDM_FRU_FIELD_TYPE_MODEL, 2, 'a', 'b'};
+    std::vector<uint8_t> snTlvs{PLDM_FRU_FIELD_TYPE_SN, 1, 'c'};
+    constexpr size_t recHeaderSize = pldm::responder::FruImpl::recHeaderSize;
+
+    records.add(1, PLDM_FRU_RECORD_TYPE_GENERAL, PLDM_FRU_ENCODING_ASCII, 1,
+                modelTlvs);
+    records.add(1, PLDM_FRU_RECORD_TYPE_GENERAL, PLDM_FRU_ENCODING_ASCII, 1,
+                snTlvs);
+    records.add(2, PLDM_FRU_RECORD_TYPE_GENERAL, PLDM_FRU_ENCODING_ASCII, 1,
+                snTlvs);
+
+    EXPECT_EQ(records.numRecords(), 3);
+    EXPECT_EQ(records.size(), 3 * recHeaderSize + modelTlvs.size() +
+                                  2 * snTlvs.size());
+    ASSERT_NE(records.find(1), nullptr);
+    EXPECT_EQ(records.find(1)->size(),
+              2 * recHeaderSize + modelTlvs.size() + snTlvs.size());
+    EXPECT_EQ(records.find(3), nullptr);
+
+    const auto& table = records.table();
+    ASSERT_EQ(table.size(), records.size());
+    auto record =
+        reinterpret_cast<const pldm_fru_record_data_format*>(table.data());
+    EXPECT_EQ(le16toh(record->record_set_id), 1);
+    EXPECT_EQ(record->num_fru_fields, 1);
+
+    // Removing a record set leaves the other record sets in order
+    EXPECT_EQ(records.remove(1), 2);
+    EXPECT_EQ(records.remove(1), 0);
+    EXPECT_EQ(records.numRecords(), 1);
+    ASSERT_EQ(records.table().size(), recHeaderSize + snTlvs.size());
+    record = reinterpret_cast<const pldm_fru_record_data_format*>(
+        records.table().data());
+    EXPECT_EQ(le16toh(record->record_set_id), 2);
+
+    records.add(1, PLDM_FRU_RECORD_TYPE_GENERAL, PLDM_FRU_ENCODING_ASCII, 1,
+                modelTlvs);
+    record = reinterpret_cast<const pldm_fru_record_data_format*>(
+        records.table().data());
+    EXPECT_EQ(le16toh(record->record_set_id), 1);
+    EXPECT_EQ(records.table().size(), records.size());
+
+    // A zero record set identifier removes every record
+    EXPECT_EQ(records.remove(0), 2);
+    EXPECT_EQ(records.size(), 0);
+    EXPECT_TRUE(records.table().empty());
+}
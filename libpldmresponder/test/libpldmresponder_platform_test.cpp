@@ -10,11 +10,13 @@
 #include "libpldmresponder/platform_numeric_effecter.hpp"
 #include "libpldmresponder/platform_state_effecter.hpp"
 #include "libpldmresponder/platform_state_sensor.hpp"
+#include "test/test_instance_id.hpp"
 
 #include <sdbusplus/test/sdbus_mock.hpp>
 #include <sdeventplus/event.hpp>
 
 #include <memory>
+#include <sstream>
 
 using namespace pldm::pdr;
 using namespace pldm::utils;
@@ -72,8 +74,124 @@ TEST(ParseFruRecordTable, ParsesBoundedField)
     EXPECT_EQ(records[0].fruTLV[0].fruFieldValue, std::vector<uint8_t>({'x'}));
 }
 
+TEST(RepoChangeJournal, CompactsChangesPerRecord)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    EXPECT_EQ(repo.getGeneration(), 0);
+
+    repo.recordChange(PLDM_RECORDS_ADDED, 1);
+    auto generation = repo.getGeneration();
+    EXPECT_EQ(generation, 1);
+
+    repo.recordChange(PLDM_RECORDS_ADDED, 2);
+    repo.recordChange(PLDM_RECORDS_MODIFIED, 2);
+    repo.recordChange(PLDM_RECORDS_ADDED, 3);
+    repo.recordChange(PLDM_RECORDS_DELETED, 3);
+    repo.recordChange(PLDM_RECORDS_DELETED, 1);
+    repo.recordChange(PLDM_RECORDS_ADDED, 1);
+    repo.recordChange(PLDM_RECORDS_DELETED, 4);
+
+    auto changes = repo.getChangesSince(generation);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->added, std::vector<RecordHandle>({2}));
+    EXPECT_EQ(changes->deleted, std::vector<RecordHandle>({4}));
+    EXPECT_EQ(changes->modified, std::vector<RecordHandle>({1}));
+
+    changes = repo.getChangesSince(repo.getGeneration());
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_TRUE(changes->empty());
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(RepoChangeJournal, RequiresRefreshWhenJournalOverflows)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    for (RecordHandle handle = 1; handle <= 1024; ++handle)
+    {
+        repo.recordChange(PLDM_RECORDS_ADDED, handle);
+    }
+
+    EXPECT_FALSE(repo.getChangesSince(0).has_value());
+    EXPECT_FALSE(repo.getChangesSince(repo.getGeneration() + 1).has_value());
+
+    auto changes = repo.getChangesSince(repo.getGeneration() - 2);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->added, std::vector<RecordHandle>({1023, 1024}));
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(RepoChangeJournal, AddRecordIsJournaled)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), 0);
+    PdrEntry pdrEntry{};
+    pdrEntry.data = pdr.data();
+    pdrEntry.size = pdr.size();
+    auto handle = repo.addRecord(pdrEntry);
+
+    auto changes = repo.getChangesSince(0);
+    ASSERT_TRUE(changes.has_value());
+    EXPECT_EQ(changes->added, std::vector<RecordHandle>({handle}));
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(RepoChangeJournal, SingleRecordChangeIsAnnouncedByHandle)
+{
+    auto pdrRepo = pldm_pdr_init();
+    MockdBusHandler mockedUtils;
+    auto event = sdeventplus::Event::get_default();
+    TestInstanceIdDb instanceIdDb;
+    pldm::requester::Handler<pldm::requester::Request> reqHandler(
+        nullptr, event, instanceIdDb, true);
+    Handler handler(&mockedUtils, 0, &instanceIdDb, "", pdrRepo, nullptr,
+                    nullptr, nullptr, nullptr, &reqHandler, event);
+
+    auto& repo = handler.getRepo();
+    auto generation = repo.getGeneration();
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), 0);
+    uint32_t handle = 0;
+    pldm::utils::recordPDRDelta(&repo.getJournal(), pdrRepo, [&] {
+        pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), false, 1, &handle);
+    });
+
+    testing::internal::CaptureStdout();
+    handler.sendPDRRepositoryChgEventSince(generation);
+    auto trace = testing::internal::GetCapturedStdout();
+
+    // Header, format version, TID and event class precede the event data:
+    // format, number of change records, then operation, number of entries
+    // and the record handle of the single change record
+    std::vector<uint8_t> request;
+    std::istringstream bytes(trace.substr(trace.find("Tx: ") + 4));
+    std::string byte;
+    while (bytes >> byte)
+    {
+        request.push_back(std::stoul(byte, nullptr, 16));
+    }
+    constexpr size_t eventData = sizeof(pldm_msg_hdr) + 3;
+    ASSERT_EQ(request.size(), eventData + 8);
+    EXPECT_EQ(request[eventData - 1], PLDM_PDR_REPOSITORY_CHG_EVENT);
+    EXPECT_EQ(request[eventData], FORMAT_IS_PDR_HANDLES);
+    EXPECT_EQ(request[eventData + 1], 1);
+    EXPECT_EQ(request[eventData + 2], PLDM_RECORDS_ADDED);
+    EXPECT_EQ(request[eventData + 3], 1);
+    EXPECT_EQ(request[eventData + 4], handle & 0xff);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 using ::testing::_;
+using ::testing::DoAll;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::StrEq;
 
 TEST(getPDR, testGoodPath)
@@ -572,6 +690,105 @@ TEST(getNumericEffecterValueHandler, testBadRequest)
     pldm_pdr_destroy(numericEffecterPdrRepo);
 }
 
+TEST(getNumericEffecterValueHandler, testValueCachedAfterSet)
+{
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "./pdr_jsons/state_effecter/good",
+                    inPDRRepo, nullptr, nullptr, nullptr, nullptr, nullptr,
+                    event);
+
+    uint16_t effecterId = 3;
+    uint32_t effecterValue = 2100000000;
+    DBusWatchCallback propertyChanged;
+    EXPECT_CALL(mockedUtils, watchDbusProperty(_, _))
+        .WillOnce(DoAll(SaveArg<1>(&propertyChanged),
+                        Return(std::make_shared<int>(0))));
+    EXPECT_CALL(mockedUtils, setDbusProperty(_, _)).Times(1);
+    EXPECT_CALL(mockedUtils, getDbusPropertyVariant(_, _, _))
+        .WillOnce(Return(PropertyValue{uint64_t(7)}));
+
+    auto rc = platform_numeric_effecter::setNumericEffecterValueHandler<
+        MockdBusHandler, Handler>(
+        mockedUtils, handler, effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32,
+        reinterpret_cast<uint8_t*>(&effecterValue), 4);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_TRUE(propertyChanged);
+
+    uint8_t effecterDataSize{};
+    pldm::utils::PropertyValue dbusValue;
+    std::string propertyType;
+    auto getValue = [&]() {
+        return platform_numeric_effecter::getNumericEffecterData<
+            MockdBusHandler, Handler>(mockedUtils, handler, effecterId,
+                                      effecterDataSize, propertyType,
+                                      dbusValue);
+    };
+    ASSERT_EQ(getValue(), PLDM_SUCCESS);
+    EXPECT_EQ(effecterDataSize, PLDM_EFFECTER_DATA_SIZE_UINT32);
+    EXPECT_EQ(propertyType, "uint64_t");
+    EXPECT_EQ(std::get<uint64_t>(dbusValue), effecterValue);
+
+    // A change of the watched property updates the cached value
+    propertyChanged(PropertyValue{uint64_t(42)});
+    ASSERT_EQ(getValue(), PLDM_SUCCESS);
+    EXPECT_EQ(std::get<uint64_t>(dbusValue), 42);
+
+    // A change that could not be read drops it, the property is read again
+    propertyChanged(std::nullopt);
+    ASSERT_EQ(getValue(), PLDM_SUCCESS);
+    EXPECT_EQ(std::get<uint64_t>(dbusValue), 7);
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
+TEST(getNumericEffecterValueHandler, testValueNotCachedUnwatched)
+{
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "./pdr_jsons/state_effecter/good",
+                    inPDRRepo, nullptr, nullptr, nullptr, nullptr, nullptr,
+                    event);
+
+    uint16_t effecterId = 3;
+    uint32_t effecterValue = 2100000000;
+    EXPECT_CALL(mockedUtils, watchDbusProperty(_, _))
+        .WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(mockedUtils, setDbusProperty(_, _)).Times(1);
+    EXPECT_CALL(mockedUtils, getDbusPropertyVariant(_, _, _))
+        .WillOnce(Return(PropertyValue{uint64_t(7)}));
+
+    auto rc = platform_numeric_effecter::setNumericEffecterValueHandler<
+        MockdBusHandler, Handler>(
+        mockedUtils, handler, effecterId, PLDM_EFFECTER_DATA_SIZE_UINT32,
+        reinterpret_cast<uint8_t*>(&effecterValue), 4);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    // The value of a property that is not watched could go stale, it is
+    // read from D-Bus
+    uint8_t effecterDataSize{};
+    pldm::utils::PropertyValue dbusValue;
+    std::string propertyType;
+    rc = platform_numeric_effecter::getNumericEffecterData<MockdBusHandler,
+                                                           Handler>(
+        mockedUtils, handler, effecterId, effecterDataSize, propertyType,
+        dbusValue);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(std::get<uint64_t>(dbusValue), 7);
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
 TEST(parseStateSensor, allScenarios)
 {
     // Sample state sensor with SensorID - 1, EntityType - Processor Module(67)
@@ -833,6 +1050,79 @@ TEST(TerminusLocatorPDR, BMCTerminusLocatorPDR)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(prebuildBMCPDRs, BuildsOnceBMCIsReady)
+{
+    auto pdrRepo = pldm_pdr_init();
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils,
+                getDbusPropertyVariant(_, StrEq("CurrentBMCState"), _))
+        .WillOnce(Return(PropertyValue{
+            std::string("xyz.openbmc_project.State.BMC.BMCState.Ready")}));
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "", pdrRepo, nullptr, nullptr,
+                    nullptr, nullptr, nullptr, event, true);
+
+    std::vector<bool> statuses;
+    handler.prebuildBMCPDRs(
+        [&statuses](bool building) { statuses.push_back(building); });
+    EXPECT_EQ(statuses, std::vector<bool>({true}));
+    EXPECT_TRUE(handler.getRepo().empty());
+
+    // The PDRs are built from the event loop, not in the call
+    sd_event_run(event.get(), 0);
+    EXPECT_EQ(statuses, std::vector<bool>({true, false}));
+    EXPECT_FALSE(handler.getRepo().empty());
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(prebuildBMCPDRs, WaitsWhileBMCIsNotReady)
+{
+    auto pdrRepo = pldm_pdr_init();
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils,
+                getDbusPropertyVariant(_, StrEq("CurrentBMCState"), _))
+        .WillOnce(Return(PropertyValue{
+            std::string("xyz.openbmc_project.State.BMC.BMCState.NotReady")}));
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "", pdrRepo, nullptr, nullptr,
+                    nullptr, nullptr, nullptr, event, true);
+
+    std::vector<bool> statuses;
+    handler.prebuildBMCPDRs(
+        [&statuses](bool building) { statuses.push_back(building); });
+    sd_event_run(event.get(), 0);
+    EXPECT_EQ(statuses, std::vector<bool>({true}));
+    EXPECT_TRUE(handler.getRepo().empty());
+
+    // A GetPDR request received before then builds the PDRs itself
+    handler.buildBMCPDRs();
+    EXPECT_EQ(statuses, std::vector<bool>({true, false}));
+    EXPECT_FALSE(handler.getRepo().empty());
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(prebuildBMCPDRs, SkippedWhenPDRsAreBuilt)
+{
+    auto pdrRepo = pldm_pdr_init();
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getDbusPropertyVariant(_, _, _)).Times(0);
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "", pdrRepo, nullptr, nullptr,
+                    nullptr, nullptr, nullptr, event);
+    auto recordCount = handler.getRepo().getRecordCount();
+
+    std::vector<bool> statuses;
+    handler.prebuildBMCPDRs(
+        [&statuses](bool building) { statuses.push_back(building); });
+    sd_event_run(event.get(), 0);
+    EXPECT_EQ(statuses, std::vector<bool>({false}));
+    EXPECT_EQ(handler.getRepo().getRecordCount(), recordCount);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(getStateSensorReadingsHandler, testGoodRequest)
 {
     MockdBusHandler mockedUtils;
@@ -46,6 +46,13 @@ class TestSystemSpecificBIOSConfig : public ::testing::Test
         }
     }
 
+    void SetUp() override
+    {
+        // Start every test from the BIOS JSONs, not from the tables cached by
+        // the previous tests
+        fs::remove_all(tableDir / "cache");
+    }
+
     std::optional<Json> findJsonEntry(const std::string& name)
     {
         for (auto& json : jsons)
@@ -84,9 +84,8 @@ uint16_t HostLampTest::getEffecterID()
     // INDICATOR is a logical entity, so the bit 15 in entity type is set.
     pdr::EntityType entityType = PLDM_ENTITY_INDICATOR | 0x8000;
 
-    auto stateEffecterPDRs = pldm::utils::findStateEffecterPDR(
-        mctp_eid, entityType,
-        static_cast<uint16_t>(PLDM_STATE_SET_IDENTIFY_STATE), pdrRepo);
+    const auto& stateEffecterPDRs = pdrIndex.findStateEffecterPDR(
+        entityType, static_cast<uint16_t>(PLDM_STATE_SET_IDENTIFY_STATE));
 
     if (stateEffecterPDRs.empty())
     {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/state_pdr_index.hpp"
 #include "requester/handler.hpp"
 
 #include <sdbusplus/server/object.hpp>
@@ -46,13 +47,17 @@ class HostLampTest : public HostLampTestInterfaces, public LEDGroupObj
      * @param[in] instanceIdDb  - InstanceIdDb object to obtain instance id
      * @param[in] repo          - pointer to BMC's primary PDR repo
      * @param[in] handler       - PLDM request handler
+     * @param[in] pdrJournal    - change journal of the PDR repo, nullptr if
+     *                            the repo is not tracked
      */
     HostLampTest(sdbusplus::bus_t& bus, const std::string& objPath,
                  uint8_t mctp_eid, pldm::InstanceIdDb& instanceIdDb,
                  pldm_pdr* repo,
-                 pldm::requester::Handler<pldm::requester::Request>* handler) :
+                 pldm::requester::Handler<pldm::requester::Request>* handler,
+                 const pldm::utils::PDRJournal* pdrJournal = nullptr) :
         LEDGroupObj(bus, objPath.c_str()), path(objPath), mctp_eid(mctp_eid),
-        instanceIdDb(instanceIdDb), pdrRepo(repo), handler(handler)
+        instanceIdDb(instanceIdDb), pdrRepo(repo), pdrIndex(repo, pdrJournal),
+        handler(handler)
     {}
 
     /** @brief Property SET Override function
@@ -96,6 +101,9 @@ class HostLampTest : public HostLampTestInterfaces, public LEDGroupObj
     /** @brief pointer to BMC's primary PDR repo */
     const pldm_pdr* pdrRepo;
 
+    /** @brief state PDR index of BMC's primary PDR repo */
+    pldm::utils::StatePDRIndex pdrIndex;
+
     /** @brief Effecter ID */
     uint16_t effecterID = 0;
 
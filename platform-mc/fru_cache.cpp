@@ -0,0 +1,218 @@
+#include "fru_cache.hpp"
+
+#include <fcntl.h>
+#include <libpldm/edac.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+namespace
+{
+
+/** @brief Header of a cached FRU table file */
+struct CacheHeader
+{
+    uint32_t version;
+    FruCache::Metadata metadata;
+    uint32_t dataSize;
+    uint32_t dataCrc;
+};
+
+/** @brief Version of the cache file format */
+constexpr uint32_t cacheVersion = 1;
+
+/** @brief Maximum size of a cached FRU table, the FRU tables of the termini
+ *         are a few KiB
+ */
+constexpr uint32_t maxTableSize = 1024 * 1024;
+
+/** @brief Write a buffer to a file descriptor
+ *
+ *  @param[in] fd - The file descriptor
+ *  @param[in] data - The buffer
+ *  @param[in] size - Size of the buffer
+ *
+ *  @throw std::system_error if the write fails
+ */
+void writeAll(int fd, const void* data, size_t size)
+{
+    auto p = static_cast<const uint8_t*>(data);
+    size_t written = 0;
+    while (written < size)
+    {
+        auto rc = write(fd, p + written, size - written);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to write");
+        }
+        written += rc;
+    }
+}
+
+/** @brief Sync a directory
+ *
+ *  @param[in] path - The directory
+ *
+ *  @throw std::system_error if the sync fails
+ */
+void syncDirectory(const std::filesystem::path& path)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open " + path.string());
+    }
+    if (fsync(fd) < 0)
+    {
+        auto err = errno;
+        close(fd);
+        throw std::system_error(err, std::generic_category(),
+                                "Failed to sync " + path.string());
+    }
+    close(fd);
+}
+
+} // namespace
+
+std::filesystem::path FruCache::tablePath(const UUID& uuid) const
+{
+    if (dir.empty() || uuid.empty() ||
+        !std::ranges::all_of(uuid, [](char c) {
+            return std::isxdigit(static_cast<unsigned char>(c)) || c == '-';
+        }))
+    {
+        return {};
+    }
+    return dir / uuid;
+}
+
+std::optional<std::vector<uint8_t>> FruCache::load(
+    const UUID& uuid, const Metadata& metadata) const
+{
+    auto path = tablePath(uuid);
+    if (path.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    CacheHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.version != cacheVersion || header.metadata != metadata)
+    {
+        return std::nullopt;
+    }
+
+    // The size is checked before it is allocated
+    if (header.dataSize != metadata.tableLength ||
+        header.dataSize > maxTableSize)
+    {
+        error("Cached FRU table '{PATH}' has an invalid size {SIZE}", "PATH",
+              path, "SIZE", header.dataSize);
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> table(header.dataSize);
+    if (!file.read(reinterpret_cast<char*>(table.data()), table.size()) ||
+        pldm_edac_crc32(table.data(), table.size()) != header.dataCrc)
+    {
+        error("Cached FRU table '{PATH}' is corrupted", "PATH", path);
+        return std::nullopt;
+    }
+
+    return table;
+}
+
+void FruCache::store(const UUID& uuid, const Metadata& metadata,
+                     const std::vector<uint8_t>& table) const
+{
+    auto path = tablePath(uuid);
+    if (path.empty())
+    {
+        return;
+    }
+
+    if (table.size() != metadata.tableLength || table.size() > maxTableSize)
+    {
+        error(
+            "Not caching the FRU table of terminus {UUID}, its size {SIZE} is invalid for length {LENGTH}",
+            "UUID", uuid, "SIZE", table.size(), "LENGTH", metadata.tableLength);
+        return;
+    }
+
+    CacheHeader header{};
+    header.version = cacheVersion;
+    header.metadata = metadata;
+    header.dataSize = table.size();
+    header.dataCrc = pldm_edac_crc32(table.data(), table.size());
+
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    try
+    {
+        std::filesystem::create_directories(dir);
+
+        int fd = open(tmpPath.c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to create " + tmpPath.string());
+        }
+        try
+        {
+            writeAll(fd, &header, sizeof(header));
+            writeAll(fd, table.data(), table.size());
+            if (fsync(fd) < 0)
+            {
+                throw std::system_error(errno, std::generic_category(),
+                                        "Failed to sync " + tmpPath.string());
+            }
+        }
+        catch (...)
+        {
+            close(fd);
+            throw;
+        }
+        close(fd);
+
+        // sync the directory too, so that the rename survives a power loss
+        std::filesystem::rename(tmpPath, path);
+        syncDirectory(dir);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to cache FRU table of terminus {UUID}, error - {ERROR}",
+            "UUID", uuid, "ERROR", e);
+        std::error_code ec;
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+} // namespace platform_mc
+} // namespace pldm
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/**
+ * @brief FruCache
+ *
+ * FruCache persists the FRU record tables fetched from the termini, one file
+ * per terminus UUID. A cached table is only used while the terminus reports
+ * the same FRU record table metadata, so the table is fetched again as soon
+ * as the terminus FRU data changes.
+ */
+class FruCache
+{
+  public:
+    /** @struct Metadata
+     *  @brief The GetFRURecordTableMetadata fields identifying a FRU table
+     */
+    struct Metadata
+    {
+        uint32_t tableLength = 0;
+        uint16_t numRecords = 0;
+        uint32_t checksum = 0;
+
+        bool operator==(const Metadata&) const = default;
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] dir - directory of the cached tables, empty to disable the
+     *                   cache
+     */
+    explicit FruCache(std::filesystem::path dir) : dir(std::move(dir)) {}
+
+    /** @brief Load the cached FRU table of a terminus
+     *
+     *  @param[in] uuid - UUID of the terminus
+     *  @param[in] metadata - FRU table metadata reported by the terminus
+     *
+     *  @return the FRU table, std::nullopt if there is no cached table for
+     *          the metadata
+     */
+    std::optional<std::vector<uint8_t>> load(const UUID& uuid,
+                                             const Metadata& metadata) const;
+
+    /** @brief Cache the FRU table of a terminus
+     *
+     *  @param[in] uuid - UUID of the terminus
+     *  @param[in] metadata - FRU table metadata reported by the terminus
+     *  @param[in] table - the FRU table
+     */
+    void store(const UUID& uuid, const Metadata& metadata,
+               const std::vector<uint8_t>& table) const;
+
+  private:
+    /** @brief Get the path of the cached table of a terminus
+     *
+     *  @param[in] uuid - UUID of the terminus
+     *
+     *  @return the path, empty if the cache is disabled or the UUID can't
+     *          name a file
+     */
+    std::filesystem::path tablePath(const UUID& uuid) const;
+
+    /** @brief directory of the cached tables */
+    std::filesystem::path dir;
+};
+
+} // namespace platform_mc
+} // namespace pldm
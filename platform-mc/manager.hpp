@@ -38,7 +38,7 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
                      pldm::InstanceIdDb& instanceIdDb) :
         terminusManager(event, handler, instanceIdDb, termini, this,
                         pldm::BmcMctpEid),
-        platformManager(terminusManager, termini, this),
+        platformManager(terminusManager, termini, this, REMOTE_FRU_CACHE_DIR),
         sensorManager(event, terminusManager, termini, this),
         eventManager(terminusManager, termini)
     {}
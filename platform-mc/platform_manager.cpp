@@ -47,19 +47,18 @@ exec::task<int> PlatformManager::initTerminus()
         }
 
         /* Get Fru */
-        uint16_t totalTableRecords = 0;
+        FruCache::Metadata fruMetadata{};
         if (terminus->doesSupportCommand(PLDM_FRU,
                                          PLDM_GET_FRU_RECORD_TABLE_METADATA))
         {
-            auto rc =
-                co_await getFRURecordTableMetadata(tid, &totalTableRecords);
+            auto rc = co_await getFRURecordTableMetadata(tid, fruMetadata);
             if (rc)
             {
                 lg2::error(
                     "Failed to get FRU Metadata for terminus {TID}, error {ERROR}",
                     "TID", tid, "ERROR", rc);
             }
-            if (!totalTableRecords)
+            if (!fruMetadata.numRecords)
             {
                 lg2::info("Fru record table meta data has 0 records");
             }
@@ -71,11 +70,11 @@ exec::task<int> PlatformManager::initTerminus()
         }
 
         std::vector<uint8_t> fruData{};
-        if ((totalTableRecords != 0) &&
+        if ((fruMetadata.numRecords != 0) &&
             terminus->doesSupportCommand(PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE))
         {
             auto rc =
-                co_await getFRURecordTables(tid, totalTableRecords, fruData);
+                co_await getCachedFRURecordTables(tid, fruMetadata, fruData);
             if (rc)
             {
                 lg2::error(
@@ -678,8 +677,8 @@ exec::task<int> PlatformManager::eventMessageSupported(
     co_return completionCode;
 }
 
-exec::task<int> PlatformManager::getFRURecordTableMetadata(pldm_tid_t tid,
-                                                           uint16_t* total)
+exec::task<int> PlatformManager::getFRURecordTableMetadata(
+    pldm_tid_t tid, FruCache::Metadata& metadata)
 {
     Request request(
         sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES);
@@ -718,13 +717,13 @@ exec::task<int> PlatformManager::getFRURecordTableMetadata(pldm_tid_t tid,
     }
 
     uint8_t fru_data_major_version = 0, fru_data_minor_version = 0;
-    uint32_t fru_table_maximum_size = 0, fru_table_length = 0;
+    uint32_t fru_table_maximum_size = 0;
     uint16_t total_record_set_identifiers = 0;
-    uint32_t checksum = 0;
     rc = decode_get_fru_record_table_metadata_resp(
         responseMsg, responseLen, &completionCode, &fru_data_major_version,
-        &fru_data_minor_version, &fru_table_maximum_size, &fru_table_length,
-        &total_record_set_identifiers, total, &checksum);
+        &fru_data_minor_version, &fru_table_maximum_size,
+        &metadata.tableLength, &total_record_set_identifiers,
+        &metadata.numRecords, &metadata.checksum);
 
     if (rc)
     {
@@ -810,6 +809,35 @@ exec::task<int> PlatformManager::getFRURecordTable(
     co_return rc;
 }
 
+exec::task<int> PlatformManager::getCachedFRURecordTables(
+    pldm_tid_t tid, const FruCache::Metadata& metadata,
+    std::vector<uint8_t>& fruData)
+{
+    UUID uuid{};
+    auto mctpInfo = terminusManager.toMctpInfo(tid);
+    if (mctpInfo)
+    {
+        uuid = std::get<1>(*mctpInfo);
+    }
+
+    auto cachedTable = fruCache.load(uuid, metadata);
+    if (cachedTable)
+    {
+        lg2::info("Using the cached FRU record table of terminus {TID}", "TID",
+                  tid);
+        fruData = std::move(*cachedTable);
+        co_return PLDM_SUCCESS;
+    }
+
+    auto rc = co_await getFRURecordTables(tid, metadata.numRecords, fruData);
+    if (rc == PLDM_SUCCESS)
+    {
+        fruCache.store(uuid, metadata, fruData);
+    }
+
+    co_return rc;
+}
+
 void PlatformManager::updateInventoryWithFru(
     pldm_tid_t tid, const uint8_t* fruData, const size_t fruLen)
 {
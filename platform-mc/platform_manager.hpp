@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fru_cache.hpp"
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
@@ -7,6 +8,7 @@
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 
+#include <filesystem>
 #include <vector>
 
 namespace pldm
@@ -30,9 +32,20 @@ class PlatformManager
     PlatformManager& operator=(PlatformManager&&) = delete;
     ~PlatformManager() = default;
 
+    /** @brief Constructor
+     *
+     *  @param[in] terminusManager - TerminusManager to send PLDM requests
+     *  @param[in] termini - managed termini
+     *  @param[in] manager - pointer to the platform-mc Manager
+     *  @param[in] fruCacheDir - directory persisting the FRU tables of the
+     *                           termini, empty to fetch them on every
+     *                           initialization
+     */
     explicit PlatformManager(TerminusManager& terminusManager,
-                             TerminiMapper& termini, Manager* manager) :
-        terminusManager(terminusManager), termini(termini), manager(manager)
+                             TerminiMapper& termini, Manager* manager,
+                             std::filesystem::path fruCacheDir = {}) :
+        terminusManager(terminusManager), termini(termini), manager(manager),
+        fruCache(std::move(fruCacheDir))
     {}
 
     /** @brief Initialize terminus which supports PLDM Type 2
@@ -169,9 +182,23 @@ class PlatformManager
     /** @brief Get FRU Record Table Metadata from remote MCTP Endpoint
      *
      *  @param[in] tid - Destination TID
-     *  @param[out] total - Total number of record in table
+     *  @param[out] metadata - Length, number of records and checksum of the
+     *                         table
      */
-    exec::task<int> getFRURecordTableMetadata(pldm_tid_t tid, uint16_t* total);
+    exec::task<int> getFRURecordTableMetadata(pldm_tid_t tid,
+                                              FruCache::Metadata& metadata);
+
+    /** @brief Get the FRU Record Table of a terminus, from the FRU cache when
+     *         the terminus reports the metadata of the cached table
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] metadata - FRU Record Table Metadata of the terminus
+     *  @param[out] fruData - Returned fru record table data
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> getCachedFRURecordTables(
+        pldm_tid_t tid, const FruCache::Metadata& metadata,
+        std::vector<uint8_t>& fruData);
 
     /** @brief Parse record data from FRU table
      *
@@ -193,6 +220,9 @@ class PlatformManager
      *        and other platform-level PLDM operations.
      */
     Manager* manager;
+
+    /** @brief FRU tables of the termini, persisted across restarts */
+    FruCache fruCache;
 };
 } // namespace platform_mc
 } // namespace pldm
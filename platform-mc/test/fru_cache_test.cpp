@@ -0,0 +1,115 @@
+#include "platform-mc/fru_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+class FruCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/fru_cache_test.XXXXXX";
+        dir = mkdtemp(tmpdir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path dir;
+    const std::string uuid = "12345678-9abc-def0-1234-56789abcdef0";
+    const std::vector<uint8_t> table{0x01, 0x00, 0x01, 0x01, 0x01,
+                                     0x02, 0x03, 0x41, 0x42, 0x43};
+    const FruCache::Metadata metadata{static_cast<uint32_t>(table.size()), 1,
+                                      0x12345678};
+};
+
+TEST_F(FruCacheTest, storeAndLoad)
+{
+    FruCache cache(dir);
+    EXPECT_FALSE(cache.load(uuid, metadata));
+
+    cache.store(uuid, metadata, table);
+    auto cached = cache.load(uuid, metadata);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(*cached, table);
+
+    // A new instance reads the table persisted by the previous one
+    FruCache restarted(dir);
+    cached = restarted.load(uuid, metadata);
+    ASSERT_TRUE(cached);
+    EXPECT_EQ(*cached, table);
+}
+
+TEST_F(FruCacheTest, metadataMismatch)
+{
+    FruCache cache(dir);
+    cache.store(uuid, metadata, table);
+
+    auto changed = metadata;
+    changed.checksum++;
+    EXPECT_FALSE(cache.load(uuid, changed));
+
+    changed = metadata;
+    changed.numRecords++;
+    EXPECT_FALSE(cache.load(uuid, changed));
+
+    EXPECT_FALSE(cache.load("0fedcba9-8765-4321-0fed-cba987654321", metadata));
+}
+
+TEST_F(FruCacheTest, invalidUUID)
+{
+    FruCache cache(dir);
+    cache.store("", metadata, table);
+    cache.store("../escape", metadata, table);
+
+    EXPECT_FALSE(cache.load("", metadata));
+    EXPECT_FALSE(cache.load("../escape", metadata));
+    EXPECT_TRUE(std::filesystem::is_empty(dir));
+}
+
+TEST_F(FruCacheTest, disabledCache)
+{
+    FruCache cache({});
+    cache.store(uuid, metadata, table);
+    EXPECT_FALSE(cache.load(uuid, metadata));
+}
+
+TEST_F(FruCacheTest, tableLengthMismatch)
+{
+    FruCache cache(dir);
+
+    // A table not matching the reported length is not cached
+    auto longer = metadata;
+    longer.tableLength++;
+    cache.store(uuid, longer, table);
+    EXPECT_FALSE(cache.load(uuid, longer));
+    EXPECT_TRUE(std::filesystem::is_empty(dir));
+}
+
+TEST_F(FruCacheTest, corruptedDataSize)
+{
+    FruCache cache(dir);
+    cache.store(uuid, metadata, table);
+    ASSERT_TRUE(cache.load(uuid, metadata));
+
+    // The data size follows the version and the metadata in the header
+    constexpr auto dataSizeOffset =
+        sizeof(uint32_t) + sizeof(FruCache::Metadata);
+    for (uint32_t dataSize : {static_cast<uint32_t>(table.size() - 1),
+                              static_cast<uint32_t>(0xffffffff)})
+    {
+        std::fstream file(dir / uuid,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(dataSizeOffset);
+        file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+        file.close();
+
+        EXPECT_FALSE(cache.load(uuid, metadata));
+    }
+}
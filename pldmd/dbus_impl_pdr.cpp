@@ -14,10 +14,9 @@ namespace dbus_api
 {
 
 std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(
-    uint8_t tid, uint16_t entityID, uint16_t stateSetId)
+    uint8_t /*tid*/, uint16_t entityID, uint16_t stateSetId)
 {
-    auto pdrs =
-        pldm::utils::findStateEffecterPDR(tid, entityID, stateSetId, pdrRepo);
+    const auto& pdrs = pdrIndex.findStateEffecterPDR(entityID, stateSetId);
 
     if (pdrs.empty())
     {
@@ -28,10 +27,9 @@ std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(
 }
 
 std::vector<std::vector<uint8_t>> Pdr::findStateSensorPDR(
-    uint8_t tid, uint16_t entityID, uint16_t stateSetId)
+    uint8_t /*tid*/, uint16_t entityID, uint16_t stateSetId)
 {
-    auto pdrs =
-        pldm::utils::findStateSensorPDR(tid, entityID, stateSetId, pdrRepo);
+    const auto& pdrs = pdrIndex.findStateSensorPDR(entityID, stateSetId);
     if (pdrs.empty())
     {
         throw ResourceNotFound();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/state_pdr_index.hpp"
 #include "xyz/openbmc_project/PLDM/PDR/server.hpp"
 
 #include <libpldm/pdr.h>
@@ -37,9 +38,11 @@ class Pdr : public PdrIntf
      *  @param[in] bus - Bus to attach to.
      *  @param[in] path - Path to attach at.
      *  @param[in] repo - pointer to BMC's primary PDR repo
+     *  @param[in] pdrJournal - change journal of the PDR repo
      */
-    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo) :
-        PdrIntf(bus, path.c_str()), pdrRepo(repo) {};
+    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo,
+        const pldm::utils::PDRJournal* pdrJournal) :
+        PdrIntf(bus, path.c_str()), pdrIndex(repo, pdrJournal) {};
 
     /** @brief Implementation for PdrIntf.FindStateEffecterPDR
      *  @param[in] tid - PLDM terminus ID.
@@ -58,8 +61,8 @@ class Pdr : public PdrIntf
         uint8_t tid, uint16_t entityID, uint16_t stateSetId) override;
 
   private:
-    /** @brief pointer to BMC's primary PDR repo */
-    const pldm_pdr* pdrRepo;
+    /** @brief state PDR index of BMC's primary PDR repo */
+    pldm::utils::StatePDRIndex pdrIndex;
 };
 
 } // namespace dbus_api
@@ -92,7 +92,7 @@ class OemIBM
         createOemIbmPlatformHandler();
         oemIbmPlatformHandler->setPlatformHandler(platformHandler);
 
-        createHostLampTestHandler();
+        createHostLampTestHandler(&platformHandler->getRepo().getJournal());
 
         registerHandler();
     }
@@ -160,12 +160,12 @@ class OemIBM
             oemFruHandler.get());
     }
 
-    void createHostLampTestHandler()
+    void createHostLampTestHandler(const pldm::utils::PDRJournal* pdrJournal)
     {
         auto& bus = pldm::utils::DBusHandler::getBus();
         hostLampTest = std::make_unique<pldm::led::HostLampTest>(
             bus, "/xyz/openbmc_project/led/groups/host_lamp_test", mctp_eid,
-            instanceIdDb, repo, reqHandler);
+            instanceIdDb, repo, reqHandler, pdrJournal);
     }
 
     /** @brief Method for registering PLDM OEM handler */
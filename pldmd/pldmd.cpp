@@ -30,6 +30,7 @@
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -50,6 +51,7 @@ PHOSPHOR_LOG2_USING;
 #include "libpldmresponder/fru.hpp"
 #include "libpldmresponder/platform.hpp"
 #include "libpldmresponder/platform_config.hpp"
+#include "xyz/openbmc_project/Common/Progress/server.hpp"
 #include "xyz/openbmc_project/PLDM/Event/server.hpp"
 #endif
 
@@ -207,6 +209,7 @@ int main(int argc, char** argv)
     {
         throw std::runtime_error("Failed to instantiate PDR repository");
     }
+    pldm::utils::DBusServiceCache serviceCache(&bus);
     DBusHandler dbusHandler;
 
     std::unique_ptr<platform_mc::Manager> platformManager =
@@ -262,9 +265,9 @@ int main(int argc, char** argv)
         FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
         bmcEntityTree.get());
 
-    // FRU table is built lazily when a FRU command or Get PDR command is
-    // handled. To enable building FRU table, the FRU handler is passed to the
-    // Platform handler.
+    // FRU table is built along with the BMC PDRs once the BMC is Ready, or
+    // when a FRU command or Get PDR command is handled before then. To enable
+    // building FRU table, the FRU handler is passed to the Platform handler.
 
     pldm::responder::platform::EventMap addOnEventHandlers{
         {PLDM_CPER_EVENT,
@@ -297,6 +300,13 @@ int main(int argc, char** argv)
 
     fruHandler->setPlatformHandler(platformHandler.get());
 
+    // The changes of the PDR repository are journaled by the platform handler
+    // repo, the host PDR handler records the host PDRs it adds and removes.
+    if (hostPDRHandler)
+    {
+        hostPDRHandler->setPDRJournal(&platformHandler->getRepo().getJournal());
+    }
+
     auto biosHandler = std::make_unique<pldm::responder::bios::Handler>(
         pldmTransport.getEventSource(), hostEID, &instanceIdDb, &reqHandler,
         platformConfigHandler.get(), requestPLDMServiceName);
@@ -327,15 +337,38 @@ int main(int argc, char** argv)
         biosHandler.get(), &reqHandler);
 #endif
 
+    auto bmcPlatformHandler = platformHandler.get();
     invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
     invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
     invoker.registerHandler(PLDM_FRU, std::move(fruHandler));
     invoker.registerHandler(PLDM_BASE, std::move(baseHandler));
 
-    dbus_api::Pdr dbusImplPdr(bus, "/xyz/openbmc_project/pldm", pdrRepo.get());
+    dbus_api::Pdr dbusImplPdr(bus, "/xyz/openbmc_project/pldm", pdrRepo.get(),
+                              &bmcPlatformHandler->getRepo().getJournal());
     sdbusplus::xyz::openbmc_project::PLDM::server::Event dbusImplEvent(
         bus, "/xyz/openbmc_project/pldm");
 
+    // Build the BMC PDRs and the FRU table once the BMC is Ready, so that the
+    // first GetPDR request from the host firmware does not wait for them. The
+    // status of the build is published as Common.Progress.
+    using Progress = sdbusplus::xyz::openbmc_project::Common::server::Progress;
+    Progress pdrBuildProgress(bus, "/xyz/openbmc_project/pldm");
+    bmcPlatformHandler->prebuildBMCPDRs([&pdrBuildProgress](bool building) {
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+        if (building)
+        {
+            pdrBuildProgress.startTime(now);
+            pdrBuildProgress.status(Progress::OperationStatus::InProgress);
+        }
+        else
+        {
+            pdrBuildProgress.completedTime(now);
+            pdrBuildProgress.status(Progress::OperationStatus::Completed);
+        }
+    });
+
 #endif
 
     std::unique_ptr<fw_update::Manager> fwManager =